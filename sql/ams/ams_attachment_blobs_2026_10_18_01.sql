@@ -0,0 +1,50 @@
+--
+-- Content-addressed storage for ticket attachments
+--
+-- One row per encrypted file on the share. Attachments with the same
+-- sha256_original and size point at the same file; ref_count is recounted
+-- from the ticket_attachments rows by the client's garbage collection.
+-- Soft-deleted attachments keep their reference: they can be restored, so
+-- a blob is only collected once no row at all points at it.
+
+CREATE TABLE IF NOT EXISTS `ticket_attachment_blobs` (
+  `id` BIGINT UNSIGNED NOT NULL AUTO_INCREMENT,
+  `sha256_original` CHAR(64) NOT NULL,
+  `file_size` BIGINT UNSIGNED NOT NULL,
+  `stored_filename` VARCHAR(255) NOT NULL,
+  `file_path` VARCHAR(255) NOT NULL,
+  `encrypted_size` BIGINT UNSIGNED NOT NULL,
+  `sha256_encrypted` CHAR(64) NOT NULL,
+  `ref_count` INT UNSIGNED NOT NULL DEFAULT 0,
+  `created_at` DATETIME NOT NULL,
+  `released_at` DATETIME NULL DEFAULT NULL,
+  PRIMARY KEY (`id`),
+  UNIQUE KEY `uq_content` (`sha256_original`, `file_size`),
+  KEY `idx_file` (`file_path`, `stored_filename`),
+  KEY `idx_released` (`ref_count`, `released_at`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+-- recount joins on the stored file
+ALTER TABLE `ticket_attachments` ADD INDEX IF NOT EXISTS `idx_stored_file` (`file_path`, `stored_filename`);
+
+-- existing encrypted uploads: the oldest file per content becomes the blob
+INSERT IGNORE INTO `ticket_attachment_blobs`
+  (`sha256_original`, `file_size`, `stored_filename`, `file_path`, `encrypted_size`, `sha256_encrypted`, `ref_count`, `created_at`)
+SELECT a.`sha256_original`, a.`file_size`, a.`stored_filename`, a.`file_path`, a.`encrypted_size`, a.`sha256_encrypted`,
+       (SELECT COUNT(*) FROM `ticket_attachments` r
+         WHERE r.`file_path` = a.`file_path` AND r.`stored_filename` = a.`stored_filename`),
+       a.`uploaded_at`
+FROM `ticket_attachments` a
+JOIN (SELECT MIN(`id`) AS `id` FROM `ticket_attachments`
+       WHERE `sha256_original` <> '' AND `sha256_encrypted` <> '' AND `stored_filename` <> ''
+       GROUP BY `sha256_original`, `file_size`) f ON f.`id` = a.`id`;
+
+-- Garbage collection runs at most once a day across all clients: the client
+-- whose UPDATE moves last_run forward does the run, the others skip it.
+CREATE TABLE IF NOT EXISTS `ams_maintenance_jobs` (
+  `job` VARCHAR(64) NOT NULL,
+  `last_run` DATETIME NOT NULL,
+  PRIMARY KEY (`job`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+INSERT IGNORE INTO `ams_maintenance_jobs` (`job`, `last_run`) VALUES ('attachment_gc', '1970-01-01 00:00:00');
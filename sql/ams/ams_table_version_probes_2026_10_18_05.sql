@@ -0,0 +1,144 @@
+--
+-- Table version counters for change probes
+--
+-- Screens that keep a table in memory (callers, employees, machine list,
+-- contractor visits, machine reference data) used to read it again in full on
+-- every refresh. The client now probes the table's row here first and only
+-- reloads when the version moved (database::ChangeProbe).
+--
+-- The counters are bumped by triggers, so every writer is covered, including
+-- older clients and manual maintenance. A version is only compared for
+-- equality; wrapping or a reset merely causes one extra reload.
+
+CREATE TABLE IF NOT EXISTS `ams_table_version` (
+  `table_name` VARCHAR(64) NOT NULL,
+  `version` BIGINT UNSIGNED NOT NULL DEFAULT 0,
+  PRIMARY KEY (`table_name`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+INSERT IGNORE INTO `ams_table_version` (`table_name`, `version`) VALUES
+  ('caller_information', 0),
+  ('employees', 0),
+  ('machine_list', 0),
+  ('machine_line', 0),
+  ('machine_type', 0),
+  ('machine_manufacturer', 0),
+  ('facility_room', 0),
+  ('contractor_visit', 0);
+
+DROP TRIGGER IF EXISTS `trg_caller_information_version_ai`;
+DROP TRIGGER IF EXISTS `trg_caller_information_version_au`;
+DROP TRIGGER IF EXISTS `trg_caller_information_version_ad`;
+DROP TRIGGER IF EXISTS `trg_employees_version_ai`;
+DROP TRIGGER IF EXISTS `trg_employees_version_au`;
+DROP TRIGGER IF EXISTS `trg_employees_version_ad`;
+DROP TRIGGER IF EXISTS `trg_machine_list_version_ai`;
+DROP TRIGGER IF EXISTS `trg_machine_list_version_au`;
+DROP TRIGGER IF EXISTS `trg_machine_list_version_ad`;
+DROP TRIGGER IF EXISTS `trg_machine_line_version_ai`;
+DROP TRIGGER IF EXISTS `trg_machine_line_version_au`;
+DROP TRIGGER IF EXISTS `trg_machine_line_version_ad`;
+DROP TRIGGER IF EXISTS `trg_machine_type_version_ai`;
+DROP TRIGGER IF EXISTS `trg_machine_type_version_au`;
+DROP TRIGGER IF EXISTS `trg_machine_type_version_ad`;
+DROP TRIGGER IF EXISTS `trg_machine_manufacturer_version_ai`;
+DROP TRIGGER IF EXISTS `trg_machine_manufacturer_version_au`;
+DROP TRIGGER IF EXISTS `trg_machine_manufacturer_version_ad`;
+DROP TRIGGER IF EXISTS `trg_facility_room_version_ai`;
+DROP TRIGGER IF EXISTS `trg_facility_room_version_au`;
+DROP TRIGGER IF EXISTS `trg_facility_room_version_ad`;
+DROP TRIGGER IF EXISTS `trg_contractor_visit_version_ai`;
+DROP TRIGGER IF EXISTS `trg_contractor_visit_version_au`;
+DROP TRIGGER IF EXISTS `trg_contractor_visit_version_ad`;
+
+DELIMITER //
+
+-- caller_information
+CREATE TRIGGER `trg_caller_information_version_ai` AFTER INSERT ON `caller_information`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'caller_information' //
+CREATE TRIGGER `trg_caller_information_version_au` AFTER UPDATE ON `caller_information`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'caller_information' //
+CREATE TRIGGER `trg_caller_information_version_ad` AFTER DELETE ON `caller_information`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'caller_information' //
+
+-- employees
+CREATE TRIGGER `trg_employees_version_ai` AFTER INSERT ON `employees`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'employees' //
+CREATE TRIGGER `trg_employees_version_au` AFTER UPDATE ON `employees`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'employees' //
+CREATE TRIGGER `trg_employees_version_ad` AFTER DELETE ON `employees`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'employees' //
+
+-- machine_list
+CREATE TRIGGER `trg_machine_list_version_ai` AFTER INSERT ON `machine_list`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_list' //
+CREATE TRIGGER `trg_machine_list_version_au` AFTER UPDATE ON `machine_list`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_list' //
+CREATE TRIGGER `trg_machine_list_version_ad` AFTER DELETE ON `machine_list`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_list' //
+
+-- machine_line
+CREATE TRIGGER `trg_machine_line_version_ai` AFTER INSERT ON `machine_line`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_line' //
+CREATE TRIGGER `trg_machine_line_version_au` AFTER UPDATE ON `machine_line`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_line' //
+CREATE TRIGGER `trg_machine_line_version_ad` AFTER DELETE ON `machine_line`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_line' //
+
+-- machine_type
+CREATE TRIGGER `trg_machine_type_version_ai` AFTER INSERT ON `machine_type`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_type' //
+CREATE TRIGGER `trg_machine_type_version_au` AFTER UPDATE ON `machine_type`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_type' //
+CREATE TRIGGER `trg_machine_type_version_ad` AFTER DELETE ON `machine_type`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_type' //
+
+-- machine_manufacturer
+CREATE TRIGGER `trg_machine_manufacturer_version_ai` AFTER INSERT ON `machine_manufacturer`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_manufacturer' //
+CREATE TRIGGER `trg_machine_manufacturer_version_au` AFTER UPDATE ON `machine_manufacturer`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_manufacturer' //
+CREATE TRIGGER `trg_machine_manufacturer_version_ad` AFTER DELETE ON `machine_manufacturer`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'machine_manufacturer' //
+
+-- facility_room
+CREATE TRIGGER `trg_facility_room_version_ai` AFTER INSERT ON `facility_room`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'facility_room' //
+CREATE TRIGGER `trg_facility_room_version_au` AFTER UPDATE ON `facility_room`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'facility_room' //
+CREATE TRIGGER `trg_facility_room_version_ad` AFTER DELETE ON `facility_room`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'facility_room' //
+
+-- contractor_visit
+CREATE TRIGGER `trg_contractor_visit_version_ai` AFTER INSERT ON `contractor_visit`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'contractor_visit' //
+CREATE TRIGGER `trg_contractor_visit_version_au` AFTER UPDATE ON `contractor_visit`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'contractor_visit' //
+CREATE TRIGGER `trg_contractor_visit_version_ad` AFTER DELETE ON `contractor_visit`
+FOR EACH ROW
+  UPDATE `ams_table_version` SET `version` = `version` + 1 WHERE `table_name` = 'contractor_visit' //
+
+DELIMITER ;
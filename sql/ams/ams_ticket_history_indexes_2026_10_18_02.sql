@@ -0,0 +1,9 @@
+--
+-- Ticket history paging
+--
+-- The history view pages through resolved and closed tickets with keyset
+-- pagination on (updated_at, ID) or (created_at, ID). These indexes let the
+-- server walk the tickets in that order and stop after one page.
+
+ALTER TABLE `tickets` ADD INDEX IF NOT EXISTS `idx_tickets_updated_id` (`updated_at`, `ID`);
+ALTER TABLE `tickets` ADD INDEX IF NOT EXISTS `idx_tickets_created_id` (`created_at`, `ID`);
@@ -0,0 +1,105 @@
+--
+-- Per-ticket overview summary
+--
+-- The ticket overview used to find the latest comment of every ticket with
+-- GROUP BY derived tables over ticket_comments on each refresh. The server
+-- now keeps one summary row per ticket up to date on write, and the overview
+-- joins it by primary key.
+--
+-- last_activity_at is the time the comments of the ticket last changed
+-- (insert, edit, delete); the overview delta uses it to pick up comment-only
+-- changes, which do not touch tickets.updated_at.
+
+CREATE TABLE IF NOT EXISTS `ticket_overview_summary` (
+  `ticket_id` BIGINT UNSIGNED NOT NULL,
+  `comment_count` INT UNSIGNED NOT NULL DEFAULT 0,
+  `latest_comment_id` BIGINT UNSIGNED NULL DEFAULT NULL,
+  `latest_comment_message` TEXT NULL DEFAULT NULL,
+  `latest_comment_at` DATETIME NULL DEFAULT NULL,
+  `last_activity_at` DATETIME NULL DEFAULT NULL,
+  PRIMARY KEY (`ticket_id`),
+  KEY `idx_last_activity` (`last_activity_at`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
+-- the refresh below reads one ticket's live comments
+ALTER TABLE `ticket_comments` ADD INDEX IF NOT EXISTS `idx_ticket_comments_ticket_live` (`ticket_id`, `is_deleted`);
+
+-- open ticket overview: WHERE is_deleted = 0 AND current_status NOT IN (resolved, closed)
+ALTER TABLE `tickets` ADD INDEX IF NOT EXISTS `idx_tickets_open` (`is_deleted`, `current_status`);
+
+DROP PROCEDURE IF EXISTS `ams_refresh_ticket_summary`;
+DROP TRIGGER IF EXISTS `trg_ticket_comments_summary_ai`;
+DROP TRIGGER IF EXISTS `trg_ticket_comments_summary_au`;
+DROP TRIGGER IF EXISTS `trg_ticket_comments_summary_ad`;
+
+DELIMITER //
+
+-- Recomputes one summary row from ticket_comments. Also called by the
+-- client's consistency check to repair rows that drifted.
+CREATE PROCEDURE `ams_refresh_ticket_summary`(IN p_ticket_id BIGINT UNSIGNED)
+BEGIN
+  INSERT INTO `ticket_overview_summary`
+    (`ticket_id`, `comment_count`, `latest_comment_id`, `latest_comment_message`, `latest_comment_at`, `last_activity_at`)
+  SELECT p_ticket_id,
+         (SELECT COUNT(*) FROM `ticket_comments` c WHERE c.`ticket_id` = p_ticket_id AND c.`is_deleted` = 0),
+         l.`id`, l.`message`, l.`last_at`, NOW()
+  FROM (SELECT 1) one
+  LEFT JOIN (SELECT `id`, `message`, COALESCE(`updated_at`, `created_at`) AS `last_at`
+               FROM `ticket_comments`
+              WHERE `ticket_id` = p_ticket_id AND `is_deleted` = 0
+              ORDER BY COALESCE(`updated_at`, `created_at`) DESC, `id` DESC
+              LIMIT 1) l ON TRUE
+  ON DUPLICATE KEY UPDATE
+    `comment_count` = VALUES(`comment_count`),
+    `latest_comment_id` = VALUES(`latest_comment_id`),
+    `latest_comment_message` = VALUES(`latest_comment_message`),
+    `latest_comment_at` = VALUES(`latest_comment_at`),
+    `last_activity_at` = VALUES(`last_activity_at`);
+END //
+
+CREATE TRIGGER `trg_ticket_comments_summary_ai` AFTER INSERT ON `ticket_comments`
+FOR EACH ROW
+BEGIN
+  CALL `ams_refresh_ticket_summary`(NEW.`ticket_id`);
+END //
+
+CREATE TRIGGER `trg_ticket_comments_summary_au` AFTER UPDATE ON `ticket_comments`
+FOR EACH ROW
+BEGIN
+  CALL `ams_refresh_ticket_summary`(NEW.`ticket_id`);
+  IF OLD.`ticket_id` <> NEW.`ticket_id` THEN
+    CALL `ams_refresh_ticket_summary`(OLD.`ticket_id`);
+  END IF;
+END //
+
+CREATE TRIGGER `trg_ticket_comments_summary_ad` AFTER DELETE ON `ticket_comments`
+FOR EACH ROW
+BEGIN
+  CALL `ams_refresh_ticket_summary`(OLD.`ticket_id`);
+END //
+
+DELIMITER ;
+
+-- Backfill. Triggers are in place already, so comments written meanwhile are
+-- covered; a row overwritten by this with older data is repaired by the
+-- client's consistency check.
+INSERT INTO `ticket_overview_summary`
+  (`ticket_id`, `comment_count`, `latest_comment_id`, `latest_comment_message`, `latest_comment_at`, `last_activity_at`)
+SELECT t.`ID`, COALESCE(cnt.`n`, 0), l.`id`, l.`message`, COALESCE(l.`updated_at`, l.`created_at`), COALESCE(l.`updated_at`, l.`created_at`)
+FROM `tickets` t
+LEFT JOIN (SELECT `ticket_id`, COUNT(*) AS `n` FROM `ticket_comments` WHERE `is_deleted` = 0 GROUP BY `ticket_id`) cnt
+       ON cnt.`ticket_id` = t.`ID`
+LEFT JOIN `ticket_comments` l
+       ON l.`id` = (SELECT c.`id` FROM `ticket_comments` c
+                     WHERE c.`ticket_id` = t.`ID` AND c.`is_deleted` = 0
+                     ORDER BY COALESCE(c.`updated_at`, c.`created_at`) DESC, c.`id` DESC
+                     LIMIT 1)
+ON DUPLICATE KEY UPDATE
+  `comment_count` = VALUES(`comment_count`),
+  `latest_comment_id` = VALUES(`latest_comment_id`),
+  `latest_comment_message` = VALUES(`latest_comment_message`),
+  `latest_comment_at` = VALUES(`latest_comment_at`);
+
+-- The client's consistency check runs at most once a day across all clients
+-- (ams_maintenance_jobs, see ams_attachment_blobs_2026_10_18_01.sql).
+INSERT IGNORE INTO `ams_maintenance_jobs` (`job`, `last_run`) VALUES ('overview_summary_repair', '1970-01-01 00:00:00');
@@ -0,0 +1,68 @@
+--
+-- Coalesced ticket edits
+--
+-- The ticket detail view saves all changed fields with one UPDATE. row_version
+-- is the optimistic concurrency token: the client sends the version it loaded
+-- and bumps it, an UPDATE that matches no row means someone else saved first.
+-- No lock is held while the user is editing.
+--
+-- updated_by_user is set by the same UPDATE so the trigger below can write the
+-- history entry without a second round trip.
+
+ALTER TABLE `tickets`
+  ADD COLUMN IF NOT EXISTS `row_version` INT UNSIGNED NOT NULL DEFAULT 0,
+  ADD COLUMN IF NOT EXISTS `updated_by_user` INT UNSIGNED NULL DEFAULT NULL;
+
+DROP TRIGGER IF EXISTS `trg_tickets_change_history_au`;
+
+DELIMITER //
+
+-- Status history may already be written by an older trigger on `tickets` whose
+-- name differs between installations. Such a trigger can maintain other things
+-- as well, so it is not dropped here: the migration stops and names it. Review
+-- and drop it by hand, then run this file again.
+DROP PROCEDURE IF EXISTS `ams_check_legacy_status_history_triggers` //
+CREATE PROCEDURE `ams_check_legacy_status_history_triggers`()
+BEGIN
+  DECLARE legacy TEXT DEFAULT NULL;
+  DECLARE message VARCHAR(512);
+
+  SELECT GROUP_CONCAT(`TRIGGER_NAME` ORDER BY `TRIGGER_NAME` SEPARATOR ', ') INTO legacy
+  FROM `information_schema`.`TRIGGERS`
+  WHERE `EVENT_OBJECT_SCHEMA` = DATABASE() AND `EVENT_OBJECT_TABLE` = 'tickets'
+    AND `ACTION_STATEMENT` LIKE '%ticket_status_history%'
+    AND `TRIGGER_NAME` <> 'trg_tickets_change_history_au';
+
+  IF legacy IS NOT NULL THEN
+    SET message = LEFT(CONCAT('Triggers on tickets already write ticket_status_history: ', legacy,
+                              '. Review and drop them, then run this migration again.'), 512);
+    SIGNAL SQLSTATE '45000' SET MESSAGE_TEXT = message;
+  END IF;
+END //
+
+CALL `ams_check_legacy_status_history_triggers`() //
+DROP PROCEDURE `ams_check_legacy_status_history_triggers` //
+
+-- One ticket_status_history row per versioned save, listing the fields it
+-- changed; an unchanged status shows as "Ticket edited" in the timeline. Other
+-- updates (older clients, maintenance) are recorded only when the status
+-- changes, without a user: updated_by_user is only current on a versioned save.
+CREATE TRIGGER `trg_tickets_change_history_au` AFTER UPDATE ON `tickets`
+FOR EACH ROW
+BEGIN
+  IF NEW.`row_version` <> OLD.`row_version` THEN
+    INSERT INTO `ticket_status_history` (`ticket_id`, `old_status`, `new_status`, `changed_at`, `changed_by_user`, `comment`)
+    VALUES (NEW.`ID`, OLD.`current_status`, NEW.`current_status`, NOW(), NEW.`updated_by_user`,
+            NULLIF(CONCAT_WS(', ',
+                       IF(NOT (OLD.`current_status` <=> NEW.`current_status`), 'status', NULL),
+                       IF(NOT (OLD.`priority` <=> NEW.`priority`), 'priority', NULL),
+                       IF(NOT (OLD.`title` <=> NEW.`title`), 'title', NULL),
+                       IF(NOT (OLD.`description` <=> NEW.`description`), 'description', NULL)),
+                   ''));
+  ELSEIF NOT (OLD.`current_status` <=> NEW.`current_status`) THEN
+    INSERT INTO `ticket_status_history` (`ticket_id`, `old_status`, `new_status`, `changed_at`, `changed_by_user`, `comment`)
+    VALUES (NEW.`ID`, OLD.`current_status`, NEW.`current_status`, NOW(), NULL, NULL);
+  END IF;
+END //
+
+DELIMITER ;
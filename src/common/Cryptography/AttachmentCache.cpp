@@ -0,0 +1,304 @@
+#include "pch.h"
+#include "AttachmentCache.h"
+
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
+#include <algorithm>
+
+#include "Logger.h"
+#include "Util.h"
+
+AttachmentCache& AttachmentCache::instance()
+{
+    static AttachmentCache cache;
+    return cache;
+}
+
+AttachmentCache::AttachmentCache()
+{
+    _cacheDir = QDir(QStandardPaths::writableLocation(QStandardPaths::AppLocalDataLocation)).filePath(QStringLiteral("AttachmentCache"));
+
+    if (!QDir().mkpath(_cacheDir))
+    {
+        LOG_WARNING("AttachmentCache: cannot create {}", _cacheDir.toStdString());
+        _cacheDir.clear();
+        return;
+    }
+
+    LoadIndex();
+}
+
+bool AttachmentCache::IsValidKey(const std::string& sha256Original)
+{
+    // The key becomes a file name, so only accept what Sha256File produces.
+    return sha256Original.size() == 64 &&
+           std::all_of(sha256Original.begin(), sha256Original.end(), [](char c) { return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'); });
+}
+
+bool AttachmentCache::MatchesKey(const QString& path, const std::string& sha256Original)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QCryptographicHash hash(QCryptographicHash::Sha256);
+    if (!hash.addData(&file))
+        return false;
+
+    return hash.result().toHex().toStdString() == sha256Original;
+}
+
+QString AttachmentCache::PathFor(const std::string& sha256Original) const
+{
+    return QDir(_cacheDir).filePath(QString::fromStdString(sha256Original));
+}
+
+void AttachmentCache::RemoveLocked(const std::string& sha256Original)
+{
+    auto it = _entries.find(sha256Original);
+    if (it != _entries.end())
+    {
+        _totalBytes -= it->second.size;
+        _lru.erase(it->second.lruPos);
+        _entries.erase(it);
+    }
+
+    QFile::remove(PathFor(sha256Original));
+}
+
+void AttachmentCache::LoadIndex()
+{
+    // Newest first; the modification time is bumped on every hit.
+    const QFileInfoList files = QDir(_cacheDir).entryInfoList(QDir::Files, QDir::Time);
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (const QFileInfo& file : files)
+    {
+        const std::string key = file.fileName().toStdString();
+        if (!IsValidKey(key))
+            continue;
+
+        const auto size = static_cast<std::uint64_t>(file.size());
+        _lru.push_back(key);
+        _entries.emplace(key, Entry{size, std::prev(_lru.end())});
+        _totalBytes += size;
+    }
+
+    if (_totalBytes > MaxCacheBytes)
+        ScheduleEviction();
+}
+
+QString AttachmentCache::Lookup(const std::string& sha256Original, std::uint64_t expectedSize)
+{
+    if (_cacheDir.isEmpty() || !_accessGranted || !IsValidKey(sha256Original))
+        return {};
+
+    const QString path = PathFor(sha256Original);
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        auto it = _entries.find(sha256Original);
+        if (it == _entries.end())
+            return {};
+
+        // Removed or truncated behind our back: forget it and fetch again.
+        const QFileInfo info(path);
+        if (!info.exists() || static_cast<std::uint64_t>(info.size()) != expectedSize)
+        {
+            RemoveLocked(sha256Original);
+            return {};
+        }
+
+        _lru.splice(_lru.begin(), _lru, it->second.lruPos);
+    }
+
+    // Same size is not the same content; the file is the one thing in the
+    // chain that nobody else verifies. Hashing locally still beats the share.
+    if (!MatchesKey(path, sha256Original))
+    {
+        LOG_WARNING("AttachmentCache: {} does not match its hash, dropped", path.toStdString());
+        Remove(sha256Original);
+        return {};
+    }
+
+    // Keeps the order across restarts.
+    QFile touch(path);
+    if (touch.open(QIODevice::ReadWrite))
+        touch.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+
+    return path;
+}
+
+QString AttachmentCache::Store(const std::string& sha256Original, const std::string& plain)
+{
+    if (_cacheDir.isEmpty() || !_accessGranted || !IsValidKey(sha256Original))
+        return {};
+
+    if (plain.size() > EvictTargetBytes)
+        return {};
+
+    const QString path = PathFor(sha256Original);
+
+    QSaveFile out(path);
+    if (!out.open(QIODevice::WriteOnly))
+        return {};
+
+    out.write(plain.data(), static_cast<qint64>(plain.size()));
+    if (!out.commit())
+    {
+        LOG_WARNING("AttachmentCache: failed to write {}", path.toStdString());
+        return {};
+    }
+
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // Access was revoked while the file was written.
+    if (!_accessGranted)
+    {
+        QFile::remove(path);
+        return {};
+    }
+
+    const auto size = static_cast<std::uint64_t>(plain.size());
+    auto it = _entries.find(sha256Original);
+    if (it != _entries.end())
+    {
+        _totalBytes = _totalBytes - it->second.size + size;
+        it->second.size = size;
+        _lru.splice(_lru.begin(), _lru, it->second.lruPos);
+    }
+    else
+    {
+        _lru.push_front(sha256Original);
+        _entries.emplace(sha256Original, Entry{size, _lru.begin()});
+        _totalBytes += size;
+    }
+
+    if (_totalBytes > MaxCacheBytes)
+        ScheduleEviction();
+
+    return path;
+}
+
+void AttachmentCache::Remove(const std::string& sha256Original)
+{
+    if (_cacheDir.isEmpty() || !IsValidKey(sha256Original))
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    RemoveLocked(sha256Original);
+}
+
+std::vector<std::string> AttachmentCache::Keys()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return {_lru.begin(), _lru.end()};
+}
+
+void AttachmentCache::SetAccess(std::uint32_t accountId, bool mayViewAttachments)
+{
+    if (_cacheDir.isEmpty())
+        return;
+
+    // Account the cached files belong to, kept next to them across restarts.
+    const QString ownerPath = QDir(_cacheDir).filePath(QStringLiteral("owner"));
+    const QByteArray account = QByteArray::number(accountId);
+
+    QByteArray owner;
+    QFile ownerFile(ownerPath);
+    if (ownerFile.open(QIODevice::ReadOnly))
+        owner = ownerFile.readAll().trimmed();
+    ownerFile.close();
+
+    if (mayViewAttachments && owner == account)
+    {
+        _accessGranted = true;
+        return;
+    }
+
+    _accessGranted = false;
+    Clear();
+
+    if (!mayViewAttachments)
+    {
+        QFile::remove(ownerPath);
+        return;
+    }
+
+    QSaveFile out(ownerPath);
+    if (!out.open(QIODevice::WriteOnly) || out.write(account) != account.size() || !out.commit())
+    {
+        LOG_WARNING("AttachmentCache: cannot write {}, cache stays off", ownerPath.toStdString());
+        return;
+    }
+
+    _accessGranted = true;
+}
+
+void AttachmentCache::Clear()
+{
+    std::size_t removed = 0;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        for (const auto& key : _lru)
+        {
+            QFile::remove(PathFor(key));
+            ++removed;
+        }
+
+        _lru.clear();
+        _entries.clear();
+        _totalBytes = 0;
+    }
+
+    if (removed > 0)
+        LOG_INFO("AttachmentCache: cleared {} file(s)", removed);
+}
+
+void AttachmentCache::ScheduleEviction()
+{
+    if (_evicting.exchange(true))
+        return;
+
+    Util::RunInThread([this]() { EvictToLimit(); });
+}
+
+void AttachmentCache::EvictToLimit()
+{
+    std::size_t removed = 0;
+
+    {
+        // Files are deleted under the lock so a concurrent Store of the same
+        // content cannot be deleted right after it was written.
+        std::lock_guard<std::mutex> lock(_mutex);
+
+        while (_totalBytes > EvictTargetBytes && !_lru.empty())
+        {
+            const std::string key = _lru.back();
+            auto it = _entries.find(key);
+
+            if (it != _entries.end())
+            {
+                _totalBytes -= it->second.size;
+                _entries.erase(it);
+            }
+            _lru.pop_back();
+
+            QFile::remove(PathFor(key));
+            ++removed;
+        }
+    }
+
+    _evicting = false;
+
+    if (removed > 0)
+        LOG_DEBUG("AttachmentCache: evicted {} file(s)", removed);
+}
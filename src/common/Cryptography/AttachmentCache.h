@@ -0,0 +1,71 @@
+#pragma once
+
+#include <QString>
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Local cache of decrypted attachments, keyed by sha256Original. Identical
+// content referenced from several tickets is stored once. Lives in the user's
+// local app data folder, so it never leaves the user profile, and is bounded
+// by size with least recently used files evicted in the background.
+//
+// Plaintext is only kept for one account that may view tickets (SetAccess);
+// entries of deleted attachments are dropped through Remove.
+class AttachmentCache
+{
+   public:
+    static AttachmentCache& instance();
+
+    // Path of the cached plaintext, or an empty string on a miss. A hit is
+    // hashed again; a file that no longer matches its key is dropped.
+    QString Lookup(const std::string& sha256Original, std::uint64_t expectedSize);
+
+    // Caller has verified that plain hashes to sha256Original.
+    QString Store(const std::string& sha256Original, const std::string& plain);
+
+    void Remove(const std::string& sha256Original);
+    std::vector<std::string> Keys();
+
+    // Called whenever the signed-in account or its permissions change. The
+    // cache is emptied when another account signs in or the account may no
+    // longer view tickets, and stays off until access is granted again.
+    void SetAccess(std::uint32_t accountId, bool mayViewAttachments);
+
+   private:
+    AttachmentCache();
+
+    static bool IsValidKey(const std::string& sha256Original);
+    static bool MatchesKey(const QString& path, const std::string& sha256Original);
+
+    void LoadIndex();
+    void ScheduleEviction();
+    void EvictToLimit();
+    void Clear();
+    void RemoveLocked(const std::string& sha256Original);
+    QString PathFor(const std::string& sha256Original) const;
+
+    static constexpr std::uint64_t MaxCacheBytes = 2ull * 1024 * 1024 * 1024;
+    // Evict down to this so a full cache does not evict on every store.
+    static constexpr std::uint64_t EvictTargetBytes = MaxCacheBytes / 10 * 8;
+
+    struct Entry
+    {
+        std::uint64_t size = 0;
+        std::list<std::string>::iterator lruPos;
+    };
+
+    QString _cacheDir;
+
+    std::mutex _mutex;
+    std::list<std::string> _lru;  // most recent first
+    std::unordered_map<std::string, Entry> _entries;
+    std::uint64_t _totalBytes = 0;
+
+    std::atomic_bool _evicting{false};
+    std::atomic_bool _accessGranted{false};
+};
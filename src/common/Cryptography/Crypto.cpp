@@ -427,10 +427,15 @@ std::vector<BYTE> Crypto::EncryptWithDPAPI(const std::vector<BYTE>& data)
 }
 
 std::string Crypto::GetSHA256Hash(const std::string& input)
+{
+	return GetSHA256Hash(input.data(), input.size());
+}
+
+std::string Crypto::GetSHA256Hash(const void* data, std::size_t size)
 {
 	unsigned char hash[SHA256_DIGEST_LENGTH];
 
-	if (!SHA256(reinterpret_cast<const unsigned char*>(input.data()), input.size(), hash))
+	if (!SHA256(static_cast<const unsigned char*>(data), size, hash))
 		throw std::runtime_error("SHA256 hashing failed");
 
 	std::ostringstream oss;
@@ -94,6 +94,7 @@ public:
 
 	// Hash function
 	std::string GetSHA256Hash(const std::string& input);
+	std::string GetSHA256Hash(const void* data, std::size_t size);
 
     // File
     std::string Sha256File(const std::string& filePath);
@@ -6,7 +6,10 @@
 #include <QFile>
 #include <QFileInfo>
 #include <QSaveFile>
+#include <QThread>
+#include <algorithm>
 
+#include "AttachmentCache.h"
 #include "ConnectionGuard.h"
 #include "Crypto.h"
 #include "FileCrypto.h"
@@ -70,6 +73,10 @@ bool FileStorageManager::CreateTicketAttachment(const QString& sourceFilePath, s
     if (!computeSha256(sourceFilePath, shaOriginal))
         return false;
 
+    // --- Same content already on the share: reference it instead of storing it again ---
+    if (linkExistingBlob(originalFilename, originalSize, shaOriginal, ticketID, uploaderUserID, description))
+        return true;
+
     // --- Read file ---
     QFile in(sourceFilePath);
     if (!in.open(QIODevice::ReadOnly))
@@ -150,9 +157,246 @@ bool FileStorageManager::CreateTicketAttachment(const QString& sourceFilePath, s
         conn->ExecutePreparedUpdate(*stmt);
     }
 
+    registerBlob(shaOriginal, originalSize, storedFileName, relPath, encryptedSize, shaEncrypted);
+
     return true;
 }
 
+bool FileStorageManager::linkExistingBlob(const QString& originalFilename, std::uint64_t originalSize, const QString& shaOriginal, std::uint64_t ticketID,
+                                          std::uint32_t uploaderUserID, const QString& description)
+{
+    try
+    {
+        ConnectionGuardAMS conn(ConnectionType::Sync);
+
+        auto select = conn->GetPreparedStatement(AMSPreparedStatement::DB_TAB_SELECT_BY_CONTENT);
+        select->SetString(0, shaOriginal.toStdString());
+        select->SetUInt64(1, originalSize);
+
+        auto result = conn->ExecutePreparedSelect(*select);
+        if (!result.IsValid())
+            return false;
+
+        auto* row = result.Fetch();
+        if (!row)
+            return false;
+
+        const std::uint64_t blobID = row[0].GetUInt64();
+        const std::string storedFileName = row[1].GetString();
+        const std::string filePath = row[2].GetString();
+        const std::uint64_t encryptedSize = row[3].GetUInt64();
+        const std::string shaEncrypted = row[4].GetString();
+
+        // The blob row alone is not enough, the file has to be intact on the share.
+        const QFileInfo stored(QDir(_rootPath).filePath(QString::fromStdString(filePath) + QString::fromStdString(storedFileName)));
+        if (!stored.exists() || static_cast<std::uint64_t>(stored.size()) != encryptedSize)
+        {
+            LOG_WARNING("CreateTicketAttachment: blob {} missing or truncated on share, storing again", blobID);
+            return false;
+        }
+
+        // Take the reference first: no row changed means garbage collection removed it meanwhile.
+        auto addRef = conn->GetPreparedStatement(AMSPreparedStatement::DB_TAB_ADD_REF);
+        addRef->SetUInt64(0, blobID);
+        if (conn->ExecutePreparedModification(*addRef) == 0)
+            return false;
+
+        auto insert = conn->GetPreparedStatement(AMSPreparedStatement::DB_TATT_INSERT_WITH_BLOB);
+        insert->SetUInt64(0, ticketID);
+        insert->SetUInt(1, uploaderUserID);
+        insert->SetString(2, Util::CurrentDateTimeStringStd());  // uploadedAt
+        insert->SetString(3, originalFilename.toStdString());
+        insert->SetString(4, description.toStdString());
+        insert->SetUInt64(5, originalSize);
+        insert->SetString(6, shaOriginal.toStdString());
+        insert->SetString(7, storedFileName);
+        insert->SetString(8, filePath);
+        insert->SetString(9, MimeTypeHelper::detectMimeType(originalFilename).toStdString());
+        insert->SetUInt64(10, encryptedSize);
+        insert->SetString(11, shaEncrypted);
+
+        // A failed insert leaves the count one too high until the next recount.
+        if (!conn->ExecutePreparedInsert(*insert))
+            return false;
+
+        LOG_DEBUG("CreateTicketAttachment: {} linked to existing blob {}", originalFilename.toStdString(), blobID);
+        return true;
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_ERROR("CreateTicketAttachment: blob lookup failed: {}", ex.what());
+        return false;
+    }
+}
+
+void FileStorageManager::registerBlob(const QString& shaOriginal, std::uint64_t originalSize, const QString& storedFileName, const QString& relPath,
+                                      std::uint64_t encryptedSize, const QString& shaEncrypted)
+{
+    try
+    {
+        ConnectionGuardAMS conn(ConnectionType::Sync);
+        auto stmt = conn->GetPreparedStatement(AMSPreparedStatement::DB_TAB_INSERT);
+
+        stmt->SetString(0, shaOriginal.toStdString());
+        stmt->SetUInt64(1, originalSize);
+        stmt->SetString(2, storedFileName.toStdString());
+        stmt->SetString(3, relPath.toStdString());
+        stmt->SetUInt64(4, encryptedSize);
+        stmt->SetString(5, shaEncrypted.toStdString());
+        stmt->SetString(6, Util::CurrentDateTimeStringStd());
+
+        conn->ExecutePreparedInsert(*stmt);
+    }
+    catch (const std::exception& ex)
+    {
+        // The attachment itself is stored; only later uploads miss the dedupe.
+        LOG_WARNING("CreateTicketAttachment: registering blob failed: {}", ex.what());
+    }
+}
+
+std::size_t FileStorageManager::CollectGarbage()
+{
+    struct Collectable
+    {
+        std::uint64_t id = 0;
+        QString fullPath;
+        std::string sha256Original;
+    };
+
+    std::size_t removed = 0;
+
+    try
+    {
+        ConnectionGuardAMS conn(ConnectionType::Sync);
+
+        // One client per day does the run; the recount scans the whole table.
+        auto claim = conn->GetPreparedStatement(AMSPreparedStatement::DB_TAB_CLAIM_GC_RUN);
+        if (conn->ExecutePreparedModification(*claim) == 0)
+        {
+            LOG_DEBUG("CollectGarbage: ran within the last day, skipped");
+            return 0;
+        }
+
+        // Counts are derived from all attachment rows, soft-deleted ones
+        // included, so failed inserts are reconciled here rather than on every write.
+        auto recount = conn->GetPreparedStatement(AMSPreparedStatement::DB_TAB_RECOUNT_REFS);
+        conn->ExecutePreparedUpdate(*recount);
+
+        auto release = conn->GetPreparedStatement(AMSPreparedStatement::DB_TAB_MARK_RELEASED);
+        conn->ExecutePreparedUpdate(*release);
+
+        std::vector<Collectable> collectable;
+        {
+            auto select = conn->GetPreparedStatement(AMSPreparedStatement::DB_TAB_SELECT_COLLECTABLE);
+            auto result = conn->ExecutePreparedSelect(*select);
+            if (!result.IsValid())
+                return 0;
+
+            while (result.Next())
+            {
+                Field* row = result.Fetch();
+                collectable.push_back({row[0].GetUInt64(),
+                                       QDir(_rootPath).filePath(QString::fromStdString(row[2].GetString()) + QString::fromStdString(row[1].GetString())),
+                                       row[3].GetString()});
+            }
+        }
+
+        for (const auto& blob : collectable)
+        {
+            // Runs on a QThread of the application; shutdown asks it to stop.
+            if (QThread::currentThread()->isInterruptionRequested())
+                break;
+
+            // Only the client whose delete wins removes the file; an upload that
+            // referenced the blob in the meantime makes the delete a no-op.
+            auto del = conn->GetPreparedStatement(AMSPreparedStatement::DB_TAB_DELETE_COLLECTABLE);
+            del->SetUInt64(0, blob.id);
+            if (conn->ExecutePreparedModification(*del) == 0)
+                continue;
+
+            AttachmentCache::instance().Remove(blob.sha256Original);
+
+            if (QFile::exists(blob.fullPath) && !QFile::remove(blob.fullPath))
+            {
+                LOG_WARNING("CollectGarbage: could not remove {}", blob.fullPath.toStdString());
+                continue;
+            }
+
+            ++removed;
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_ERROR("CollectGarbage: {}", ex.what());
+    }
+
+    if (removed > 0)
+        LOG_INFO("CollectGarbage: removed {} unreferenced attachment blob(s)", removed);
+
+    return removed;
+}
+
+std::size_t FileStorageManager::PruneAttachmentCache()
+{
+    // Placeholders per query, so a large cache does not build one huge IN list.
+    constexpr std::size_t KeysPerQuery = 100;
+
+    auto& cache = AttachmentCache::instance();
+    const std::vector<std::string> keys = cache.Keys();
+    std::size_t removed = 0;
+
+    try
+    {
+        ConnectionGuardAMS conn(ConnectionType::Sync);
+
+        for (std::size_t first = 0; first < keys.size(); first += KeysPerQuery)
+        {
+            if (QThread::currentThread()->isInterruptionRequested())
+                break;
+
+            const std::size_t count = std::min(KeysPerQuery, keys.size() - first);
+
+            // One row per key with its verdict. Only a key the server reports
+            // as unreferenced is dropped; an empty or failed result drops nothing.
+            std::string sql = "SELECT k.sha, EXISTS(SELECT 1 FROM ticket_attachments a WHERE a.sha256_original = k.sha AND a.is_deleted = 0) "
+                              "FROM (SELECT ? AS sha";
+            for (std::size_t i = 1; i < count; ++i)
+                sql += " UNION ALL SELECT ?";
+            sql += ") k";
+
+            auto stmt = conn->GetStatementRaw(sql);
+            for (std::size_t i = 0; i < count; ++i)
+                stmt->SetString(i, keys[first + i]);
+
+            auto result = conn->ExecutePreparedSelect(*stmt);
+            if (!result.IsValid())
+            {
+                LOG_WARNING("PruneAttachmentCache: no answer for {} cached file(s), kept", count);
+                continue;
+            }
+
+            while (result.Next())
+            {
+                Field* row = result.Fetch();
+                if (row[1].GetBool())
+                    continue;
+
+                cache.Remove(row[0].GetString());
+                ++removed;
+            }
+        }
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_ERROR("PruneAttachmentCache: {}", ex.what());
+    }
+
+    if (removed > 0)
+        LOG_INFO("PruneAttachmentCache: removed {} cached file(s) of deleted attachments", removed);
+
+    return removed;
+}
+
 std::optional<TicketAttachmentInformation> FileStorageManager::LoadAttachmentMeta(std::uint64_t id) const
 {
     try
@@ -201,35 +445,54 @@ bool FileStorageManager::RestoreAttachment(std::uint64_t attachmentID, const QSt
 
     const auto& meta = *metaOpt;
 
-    const QString fullPath =
-        QDir(_rootPath).filePath(QString::fromStdString(meta.filePath) + QString::fromStdString(meta.storedFileName));
-
-    // Hash check first
-    QString shaNow;
-    if (!computeSha256(fullPath, shaNow))
-        return false;
+    // Plaintext of a deleted attachment does not stay on this machine.
+    if (meta.isDeleted)
+        AttachmentCache::instance().Remove(meta.sha256Original);
 
-    if (shaNow.toStdString() != meta.sha256Encrypted)
+    // Same content opened before (from any ticket): no trip to the share.
+    if (const QString cached = meta.isDeleted ? QString() : AttachmentCache::instance().Lookup(meta.sha256Original, meta.fileSize); !cached.isEmpty())
     {
-        LOG_ERROR("RestoreAttachment: encrypted hash mismatch");
-        return false;
+        QFile::remove(targetPath);
+        if (QFile::copy(cached, targetPath))
+            return true;
+
+        LOG_WARNING("RestoreAttachment: copying cached file to {} failed", targetPath.toStdString());
     }
 
+    const QString fullPath =
+        QDir(_rootPath).filePath(QString::fromStdString(meta.filePath) + QString::fromStdString(meta.storedFileName));
+
+    // Read the share once and verify the hash on the bytes in memory
     QFile in(fullPath);
     if (!in.open(QIODevice::ReadOnly))
         return false;
 
-    QByteArray blob = in.readAll();
+    std::vector<std::uint8_t> blob(static_cast<std::size_t>(in.size()));
+    const qint64 bytesRead = in.read(reinterpret_cast<char*>(blob.data()), static_cast<qint64>(blob.size()));
     in.close();
 
-    std::vector<std::uint8_t> blobVec(blob.begin(), blob.end());
+    if (bytesRead != static_cast<qint64>(blob.size()))
+    {
+        LOG_ERROR("RestoreAttachment: short read on {}", fullPath.toStdString());
+        return false;
+    }
+
+    if (_crypto->GetSHA256Hash(blob.data(), blob.size()) != meta.sha256Encrypted)
+    {
+        LOG_ERROR("RestoreAttachment: encrypted hash mismatch");
+        return false;
+    }
 
-    auto plainOpt = FileCrypto::Decrypt(blobVec);
+    auto plainOpt = FileCrypto::Decrypt(blob);
     if (!plainOpt)
         return false;
 
     const std::string& plain = *plainOpt;
 
+    // Only content that matches its key goes into the content-addressed cache.
+    if (!meta.isDeleted && _crypto->GetSHA256Hash(plain) == meta.sha256Original)
+        AttachmentCache::instance().Store(meta.sha256Original, plain);
+
     QFile out(targetPath);
     if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate))
         return false;
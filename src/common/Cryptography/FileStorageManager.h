@@ -17,7 +17,20 @@ class FileStorageManager
 
     std::optional<TicketAttachmentInformation> LoadAttachmentMeta(std::uint64_t id) const;
 
+    // Recounts blob references from the live attachment rows and removes blobs
+    // that have been unreferenced for a day. Returns the number of files removed.
+    std::size_t CollectGarbage();
+
+    // Drops cached plaintext (AttachmentCache) whose content no live attachment
+    // references any more. Returns the number of cache entries removed.
+    std::size_t PruneAttachmentCache();
+
    private:
+    bool linkExistingBlob(const QString& originalFilename, std::uint64_t originalSize, const QString& shaOriginal, std::uint64_t ticketID,
+                          std::uint32_t uploaderUserID, const QString& description);
+    void registerBlob(const QString& shaOriginal, std::uint64_t originalSize, const QString& storedFileName, const QString& relPath,
+                      std::uint64_t encryptedSize, const QString& shaEncrypted);
+
     QString buildRelativePath(const QString& originalName) const;
     QString buildStoredFilename(std::uint64_t dbId, const QString& originalName) const;
 
@@ -4,6 +4,7 @@
 #include <cstring>
 #include <vector>
 
+#include "BlobStream.h"
 #include "ConnectionGuard.h"
 #include "DatabaseConnection.h"
 #include "Logger.h"
@@ -41,21 +42,21 @@ std::optional<Crypto::AesKey> MasterKeyStore::loadMasterKeyFromDb()
         auto stmt = conn->GetPreparedStatement(AMSPreparedStatement::DB_CS_SELECT_BY_NAME);
         stmt->SetString(0, FILE_MASTER_KEY_NAME);
 
-        auto result = conn->ExecutePreparedSelect(*stmt);
-        if (!result.IsValid())
+        auto result = conn->ExecutePreparedSelectRaw(*stmt);
+        if (!result || !result->next())
         {
             return std::nullopt;
         }
 
-        auto* fields = result.Fetch();
-        if (!fields)
+        const std::string algorithm(result->getString(1));  // Algorithm
+
+        // EncryptedKey, read from the connector's stream without an intermediate string
+        std::vector<std::uint8_t> blob;
+        if (!database::ReadBlobColumn(result.get(), 1, blob))
         {
             return std::nullopt;
         }
 
-        const std::string algorithm = fields[0].GetString();           // Algorithm
-        const std::vector<std::uint8_t> blob = fields[1].GetBinaryVectorUInt8();  // EncryptedKey
-
         if (algorithm != "AES-256-GCM")
         {
             LOG_ERROR("MasterKeyStore::loadMasterKeyFromDb: unsupported algorithm {}", algorithm);
@@ -84,7 +85,7 @@ bool MasterKeyStore::saveNewMasterKeyToDb(const Crypto::AesKey& masterKey, std::
         {
             auto updateStmt = conn->GetPreparedStatement(AMSPreparedStatement::DB_CS_UPDATE_KEY);
             updateStmt->SetUInt(0, version);
-            updateStmt->SetBinary(1, encrypted);
+            updateStmt->SetBinaryView(1, encrypted);
             updateStmt->SetString(2, algorithm);
             updateStmt->SetString(3, now);
             updateStmt->SetString(4, FILE_MASTER_KEY_NAME);
@@ -100,7 +101,7 @@ bool MasterKeyStore::saveNewMasterKeyToDb(const Crypto::AesKey& masterKey, std::
             auto insertStmt = conn->GetPreparedStatement(AMSPreparedStatement::DB_CS_INSERT_NEW_KEY);
             insertStmt->SetString(0, FILE_MASTER_KEY_NAME);
             insertStmt->SetUInt(1, version);
-            insertStmt->SetBinary(2, encrypted);
+            insertStmt->SetBinaryView(2, encrypted);
             insertStmt->SetString(3, algorithm);
             insertStmt->SetString(4, now);
             insertStmt->SetString(5, now);
@@ -150,7 +151,7 @@ std::vector<std::uint8_t> MasterKeyStore::encryptForDb(const Crypto::AesKey& mas
     return blob;
 }
 
-std::optional<Crypto::AesKey> MasterKeyStore::decryptFromDb(const std::vector<std::uint8_t>& blob)
+std::optional<Crypto::AesKey> MasterKeyStore::decryptFromDb(std::span<const std::uint8_t> blob)
 {
     if (blob.size() < Crypto::AES_IV_SIZE + Crypto::AES_TAG_SIZE)
     {
@@ -2,6 +2,8 @@
 
 #include <cstdint>
 #include <optional>
+#include <span>
+#include <vector>
 
 #include "Crypto.h"  // AesKey etc.
 
@@ -19,5 +21,5 @@ class MasterKeyStore
 
     static Crypto::AesKey getProtectorKey();
     static std::vector<std::uint8_t> encryptForDb(const Crypto::AesKey& masterKey);
-    static std::optional<Crypto::AesKey> decryptFromDb(const std::vector<std::uint8_t>& blob);
+    static std::optional<Crypto::AesKey> decryptFromDb(std::span<const std::uint8_t> blob);
 };
@@ -19,6 +19,15 @@ enum class MachineField : std::uint8_t
     Max
 };
 
+enum class TicketField : std::uint8_t
+{
+    Status,
+    Priority,
+    Title,
+    Description,
+    Max
+};
+
 struct FieldChange
 {
     MachineField field;
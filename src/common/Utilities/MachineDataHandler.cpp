@@ -138,6 +138,10 @@ void MachineDataHandler::LoadMachineLine()
 {
     ConnectionGuardAMS connection(ConnectionType::Sync);
 
+    const auto probe = _machineLineProbe.Check(*connection);
+    if (probe.unchanged)
+        return;
+
     auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_ML_SELECT_ALL_LINES_OVER_LOCATIONS);
     auto result = connection->ExecutePreparedSelect(*stmt);
 
@@ -171,12 +175,18 @@ void MachineDataHandler::LoadMachineLine()
         _machineLineById = std::move(byId);
         _machineLineIdsByLocation = std::move(idsByLoc);
     }
+
+    _machineLineProbe.MarkLoaded(probe);
 }
 
 void MachineDataHandler::LoadMachineManufacturer()
 {
     ConnectionGuardAMS connection(ConnectionType::Sync);
 
+    const auto probe = _machineManufacturerProbe.Check(*connection);
+    if (probe.unchanged)
+        return;
+
     auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_MM_SELECT_ALL_MANUFACTURERS);
     stmt->SetBool(0, false);
 
@@ -210,12 +220,18 @@ void MachineDataHandler::LoadMachineManufacturer()
         _machineManufacturerData = std::move(data);
         _machineManufacturerNameById = std::move(nameById);
     }
+
+    _machineManufacturerProbe.MarkLoaded(probe);
 }
 
 void MachineDataHandler::LoadMachineType()
 {
     ConnectionGuardAMS connection(ConnectionType::Sync);
 
+    const auto probe = _machineTypeProbe.Check(*connection);
+    if (probe.unchanged)
+        return;
+
     auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_MT_SELECT_ALL_TYPES);
     stmt->SetBool(0, false);
 
@@ -249,11 +265,18 @@ void MachineDataHandler::LoadMachineType()
         _machineTypeData = std::move(data);
         _machineTypeNameById = std::move(nameById);
     }
+
+    _machineTypeProbe.MarkLoaded(probe);
 }
 
 void MachineDataHandler::LoadFacilityRoom()
 {
     ConnectionGuardAMS connection(ConnectionType::Sync);
+
+    const auto probe = _facilityRoomProbe.Check(*connection);
+    if (probe.unchanged)
+        return;
+
     auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_FR_SELECT_ALL_ROOMS);
 
     auto result = connection->ExecutePreparedSelect(*stmt);
@@ -289,6 +312,16 @@ void MachineDataHandler::LoadFacilityRoom()
         _facilityRoomById = std::move(byId);
         _facilityRoomIdsByLocation = std::move(idsByLoc);
     }
+
+    _facilityRoomProbe.MarkLoaded(probe);
+}
+
+void MachineDataHandler::Refresh()
+{
+    RunWithRetry("LoadFacilityRoom", [this]() { LoadFacilityRoom(); });
+    RunWithRetry("LoadMachineLine", [this]() { LoadMachineLine(); });
+    RunWithRetry("LoadMachineManufacturer", [this]() { LoadMachineManufacturer(); });
+    RunWithRetry("LoadMachineType", [this]() { LoadMachineType(); });
 }
 
 void MachineDataHandler::WaitUntilReady()
@@ -2,6 +2,8 @@
 #include <future>
 #include<shared_mutex>
 
+#include "ChangeProbe.h"
+
 struct MachineTypeData;
 struct MachineManufacturerData;
 struct MachineLineData;
@@ -43,6 +45,9 @@ class MachineDataHandler
     void LoadMachineType();
     void LoadFacilityRoom();
 
+    // Reloads the tables whose version changed since the last load; unchanged ones cost one probe each.
+    void Refresh();
+
   //  void FillComboBoxWithData(QComboBox* comboBox, const std::string& locale, const std::string& place);
 
 
@@ -65,6 +70,13 @@ class MachineDataHandler
     std::vector<MachineTypeData> _machineTypeData;
     std::unordered_map<std::uint32_t, std::string> _machineTypeNameById;
 
+    static constexpr auto VersionProbe = database::Implementation::AMSPreparedStatement::DB_TV_SELECT_VERSION;
+
+    database::ChangeProbe _machineLineProbe{"machine_line", VersionProbe};
+    database::ChangeProbe _machineManufacturerProbe{"machine_manufacturer", VersionProbe};
+    database::ChangeProbe _machineTypeProbe{"machine_type", VersionProbe};
+    database::ChangeProbe _facilityRoomProbe{"facility_room", VersionProbe};
+
     mutable std::shared_mutex _dataMutex;
     template <typename Fn>
     void RunWithRetry(const char* name, Fn&& fn);
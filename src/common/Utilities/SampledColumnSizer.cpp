@@ -0,0 +1,292 @@
+#include "SampledColumnSizer.h"
+
+#include <QAbstractItemModel>
+#include <QFontMetrics>
+#include <QGuiApplication>
+#include <QHeaderView>
+#include <QScrollBar>
+#include <QStyle>
+#include <QTableView>
+#include <algorithm>
+#include <functional>
+
+SampledColumnSizer::SampledColumnSizer(QTableView* view) : QObject(view), _view(view)
+{
+    // Coalesces bursts of inserts, changes and scroll steps into one measurement
+    _resizeTimer.setSingleShot(true);
+    _resizeTimer.setInterval(50);
+    connect(&_resizeTimer, &QTimer::timeout, this, &SampledColumnSizer::ApplyWidths);
+
+    if (_view)
+    {
+        connect(_view->verticalScrollBar(), &QScrollBar::valueChanged, this, &SampledColumnSizer::ScheduleResize);
+        connect(_view->horizontalHeader(), &QHeaderView::sectionResized, this, &SampledColumnSizer::OnSectionResized);
+    }
+}
+
+void SampledColumnSizer::Track(const std::vector<int>& columns, int maxWidth)
+{
+    if (!_view)
+        return;
+
+    _maxWidth = maxWidth;
+    _columns.clear();
+
+    QHeaderView* header = _view->horizontalHeader();
+    for (const int column : columns)
+    {
+        header->setSectionResizeMode(column, QHeaderView::Interactive);
+        _columns.push_back(ColumnState{column});
+    }
+
+    AttachModel(_view->model());
+    ScheduleResize();
+}
+
+void SampledColumnSizer::SetCandidateCount(int count)
+{
+    _candidateCount = std::max(1, count);
+
+    for (auto& state : _columns)
+        state.candidatesDirty = true;
+
+    ScheduleResize();
+}
+
+void SampledColumnSizer::AttachModel(QAbstractItemModel* model)
+{
+    for (const auto& connection : _modelConnections)
+        disconnect(connection);
+    _modelConnections.clear();
+
+    _model = model;
+    if (!_model)
+        return;
+
+    _modelConnections.push_back(connect(_model, &QAbstractItemModel::rowsInserted, this, &SampledColumnSizer::OnRowsInserted));
+    _modelConnections.push_back(connect(_model, &QAbstractItemModel::rowsRemoved, this, &SampledColumnSizer::OnRowsRemoved));
+    _modelConnections.push_back(connect(_model, &QAbstractItemModel::dataChanged, this,
+                                        [this](const QModelIndex& topLeft, const QModelIndex& bottomRight) { OnDataChanged(topLeft, bottomRight); }));
+    _modelConnections.push_back(connect(_model, &QAbstractItemModel::modelReset, this, &SampledColumnSizer::OnModelReset));
+    _modelConnections.push_back(connect(_model, &QAbstractItemModel::layoutChanged, this, &SampledColumnSizer::ScheduleResize));
+}
+
+void SampledColumnSizer::OnRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    if (parent.isValid())
+        return;
+
+    for (auto& state : _columns)
+    {
+        if (state.candidatesDirty)
+            continue;
+
+        for (int row = first; row <= last; ++row)
+            Offer(state, row);
+    }
+
+    ScheduleResize();
+}
+
+void SampledColumnSizer::OnRowsRemoved(const QModelIndex& parent)
+{
+    if (parent.isValid())
+        return;
+
+    for (auto& state : _columns)
+    {
+        const auto removed = std::erase_if(state.candidates, [](const Candidate& c) { return !c.index.isValid(); });
+        if (removed > 0)
+        {
+            // Whatever was ranked below the removed rows is unknown
+            state.candidatesDirty = true;
+        }
+    }
+
+    ScheduleResize();
+}
+
+void SampledColumnSizer::OnDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight)
+{
+    if (!topLeft.isValid() || topLeft.parent().isValid())
+        return;
+
+    bool changed = false;
+
+    for (auto& state : _columns)
+    {
+        // e.g. the per-minute "Open For" refresh touches no sized column
+        if (state.column < topLeft.column() || state.column > bottomRight.column())
+            continue;
+
+        for (int row = topLeft.row(); row <= bottomRight.row(); ++row)
+        {
+            auto it = std::ranges::find_if(state.candidates, [row](const Candidate& c) { return c.index.row() == row; });
+            if (it != state.candidates.end())
+            {
+                // A candidate got shorter: something else may be longer now
+                const qsizetype length = _model->index(row, state.column).data(Qt::DisplayRole).toString().size();
+                if (length < it->length)
+                    state.candidatesDirty = true;
+
+                it->length = length;
+                state.widthDirty = true;
+                changed = true;
+            }
+            else if (!state.candidatesDirty)
+            {
+                const std::size_t before = state.candidates.size();
+                Offer(state, row);
+                changed = changed || state.widthDirty || state.candidates.size() != before;
+            }
+
+            changed = changed || IsVisibleRow(row);
+        }
+    }
+
+    if (changed)
+        ScheduleResize();
+}
+
+void SampledColumnSizer::OnModelReset()
+{
+    for (auto& state : _columns)
+    {
+        state.candidates.clear();
+        state.candidatesDirty = true;
+    }
+
+    ScheduleResize();
+}
+
+void SampledColumnSizer::OnSectionResized(int logicalIndex, int /*oldSize*/, int newSize)
+{
+    // Only a drag or double click on the header handle counts; hiding a
+    // section or the view stretching its last section does not
+    if (_applying || newSize == 0 || QGuiApplication::mouseButtons() == Qt::NoButton)
+        return;
+
+    auto it = std::ranges::find_if(_columns, [logicalIndex](const ColumnState& state) { return state.column == logicalIndex; });
+    if (it != _columns.end())
+        it->userSized = true;
+}
+
+void SampledColumnSizer::Offer(ColumnState& state, int row)
+{
+    const QModelIndex index = _model->index(row, state.column);
+    const qsizetype length = index.data(Qt::DisplayRole).toString().size();
+
+    if (static_cast<int>(state.candidates.size()) >= _candidateCount && length <= state.candidates.back().length)
+        return;
+
+    auto pos = std::ranges::upper_bound(state.candidates, length, std::greater<>{}, &Candidate::length);
+    state.candidates.insert(pos, Candidate{length, QPersistentModelIndex(index)});
+
+    if (static_cast<int>(state.candidates.size()) > _candidateCount)
+        state.candidates.pop_back();
+
+    state.widthDirty = true;
+}
+
+void SampledColumnSizer::RebuildCandidates(ColumnState& state)
+{
+    // Text lengths only; the expensive part, measuring, stays bounded by the candidate count
+    state.candidates.clear();
+    state.candidatesDirty = false;
+
+    const int rows = _model ? _model->rowCount() : 0;
+    for (int row = 0; row < rows; ++row)
+        Offer(state, row);
+
+    state.widthDirty = true;
+}
+
+bool SampledColumnSizer::IsVisibleRow(int row) const
+{
+    if (!_view)
+        return false;
+
+    const int top = _view->rowAt(0);
+    if (top < 0)
+        return false;
+
+    int bottom = _view->rowAt(_view->viewport()->height() - 1);
+    if (bottom < 0)
+        bottom = _model->rowCount() - 1;
+
+    return row >= top && row <= bottom;
+}
+
+void SampledColumnSizer::ScheduleResize()
+{
+    if (!_resizeTimer.isActive())
+        _resizeTimer.start();
+}
+
+int SampledColumnSizer::MeasureText(const QModelIndex& index) const
+{
+    const QString text = index.data(Qt::DisplayRole).toString();
+    if (text.isEmpty())
+        return 0;
+
+    QFont font = _view->font();
+    if (const QVariant f = index.data(Qt::FontRole); f.canConvert<QFont>())
+        font = f.value<QFont>();
+
+    // Same padding QStyledItemDelegate puts around the text, plus the grid line
+    const int margin = 2 * (_view->style()->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, _view) + 1) + (_view->showGrid() ? 1 : 0);
+    return QFontMetrics(font).horizontalAdvance(text) + margin;
+}
+
+void SampledColumnSizer::ApplyWidths()
+{
+    if (!_view || !_model || _view->model() != _model)
+        return;
+
+    QHeaderView* header = _view->horizontalHeader();
+
+    const int rows = _model->rowCount();
+    const int top = _view->rowAt(0);
+    int bottom = _view->rowAt(_view->viewport()->height() - 1);
+    if (bottom < 0)
+        bottom = rows - 1;
+
+    for (auto& state : _columns)
+    {
+        if (state.userSized || header->isSectionHidden(state.column))
+            continue;
+
+        if (state.candidatesDirty)
+            RebuildCandidates(state);
+
+        if (state.widthDirty)
+        {
+            state.candidateWidth = 0;
+            for (const auto& candidate : state.candidates)
+            {
+                if (candidate.index.isValid())
+                    state.candidateWidth = std::max(state.candidateWidth, MeasureText(_model->index(candidate.index.row(), state.column)));
+            }
+            state.widthDirty = false;
+        }
+
+        int width = std::max(header->sectionSizeHint(state.column), state.candidateWidth);
+
+        // Short texts can still be wide ("WWW" vs. "iiii"); the visible rows settle that
+        if (top >= 0)
+        {
+            for (int row = top; row <= bottom; ++row)
+                width = std::max(width, MeasureText(_model->index(row, state.column)));
+        }
+
+        if (_maxWidth > 0)
+            width = std::min(width, _maxWidth);
+
+        if (width != header->sectionSize(state.column))
+        {
+            _applying = true;
+            header->resizeSection(state.column, width);
+            _applying = false;
+        }
+    }
+}
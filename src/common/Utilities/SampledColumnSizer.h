@@ -0,0 +1,76 @@
+#pragma once
+
+#include <QObject>
+#include <QPersistentModelIndex>
+#include <QPointer>
+#include <QTimer>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+class QAbstractItemModel;
+class QTableView;
+QT_END_NAMESPACE
+
+// Replacement for QHeaderView::ResizeToContents on large tables. Instead of
+// measuring every row on each reset or dataChanged, a column is sized from a
+// bounded sample: the visible rows plus the rows with the longest texts, which
+// are tracked incrementally from the model signals. Widths are only measured
+// again when that sample changes. A column the user resized by hand keeps that
+// width and is no longer sized until Track is called again.
+class SampledColumnSizer : public QObject
+{
+    Q_OBJECT
+
+   public:
+    explicit SampledColumnSizer(QTableView* view);
+
+    // Sizes these columns from now on and switches them to Interactive. Call
+    // again after the view got a new model.
+    void Track(const std::vector<int>& columns, int maxWidth = 0);
+
+    // Longest texts remembered per column.
+    void SetCandidateCount(int count);
+
+   private:
+    struct Candidate
+    {
+        qsizetype length = 0;
+        QPersistentModelIndex index;
+    };
+
+    struct ColumnState
+    {
+        int column = 0;
+        std::vector<Candidate> candidates;  // longest first
+        int candidateWidth = 0;
+        bool candidatesDirty = true;  // candidates no longer known to be the longest
+        bool widthDirty = true;
+        bool userSized = false;
+    };
+
+    void AttachModel(QAbstractItemModel* model);
+    void OnRowsInserted(const QModelIndex& parent, int first, int last);
+    void OnRowsRemoved(const QModelIndex& parent);
+    void OnDataChanged(const QModelIndex& topLeft, const QModelIndex& bottomRight);
+    void OnModelReset();
+    void OnSectionResized(int logicalIndex, int oldSize, int newSize);
+
+    void Offer(ColumnState& state, int row);
+    void RebuildCandidates(ColumnState& state);
+    bool IsVisibleRow(int row) const;
+
+    void ScheduleResize();
+    void ApplyWidths();
+    int MeasureText(const QModelIndex& index) const;
+
+    QPointer<QTableView> _view;
+    QPointer<QAbstractItemModel> _model;
+    std::vector<QMetaObject::Connection> _modelConnections;
+
+    std::vector<ColumnState> _columns;
+    int _candidateCount = 32;
+    int _maxWidth = 0;
+    bool _applying = false;  // sectionResized below comes from ApplyWidths
+
+    QTimer _resizeTimer;
+};
@@ -33,7 +33,9 @@ and TrinityCore
 #include <QRandomGenerator>
 #include <QHeaderView>
 
+#include "BlobStream.h"
 #include "Logger.h"
+#include "SampledColumnSizer.h"
 #include "ThreadWorker.h"
 #include "TranslateText.h"
 #include "oclero/qlementine/style/QlementineStyle.hpp"
@@ -762,13 +764,14 @@ void Util::SetLoading(QPushButton* button, bool enable, std::initializer_list<QW
 
 std::vector<char> Util::ReadBlobOrEmpty(sql::ResultSet* rs, int col)
 {
+	std::vector<char> data;
 	if (!rs || rs->isNull(col))
-		return {};
+		return data;
 
-	if (auto* s = rs->getBlob(col))
-		return { std::istreambuf_iterator<char>(*s), std::istreambuf_iterator<char>() };
+	if (std::unique_ptr<std::istream> s{ rs->getBlob(col) })
+		database::ReadBlobStream(*s, data);
 
-	return {};
+	return data;
 }
 
 void Util::SetLoading(QPushButton* button, bool enable)
@@ -1161,6 +1164,8 @@ void Util::SetupStretchColumn(QTableView* tableView, int stretchColumn, int minS
     header->setStretchLastSection(false);
     tableView->setHorizontalScrollMode(QAbstractItemView::ScrollPerPixel);
 
+    // ResizeToContents measures every row on each change; the sizer measures a bounded sample
+    std::vector<int> sizedColumns;
     for (int col = 0; col < columnCount; ++col)
     {
         if (col == stretchColumn)
@@ -1169,10 +1174,17 @@ void Util::SetupStretchColumn(QTableView* tableView, int stretchColumn, int minS
         }
         else
         {
-            header->setSectionResizeMode(col, QHeaderView::ResizeToContents);
+            sizedColumns.push_back(col);
         }
     }
 
+    auto* sizer = tableView->findChild<SampledColumnSizer*>(QString(), Qt::FindDirectChildrenOnly);
+    if (sizer == nullptr)
+    {
+        sizer = new SampledColumnSizer(tableView);
+    }
+    sizer->Track(sizedColumns);
+
     if (minStretchWidth > 0)
     {
         const int current = header->sectionSize(stretchColumn);
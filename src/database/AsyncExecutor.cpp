@@ -9,21 +9,46 @@
 namespace database
 {
 
-AsyncExecutor::AsyncExecutor() : running_(true)
+AsyncExecutor::AsyncExecutor(std::size_t workerCount) : running_(true)
 {
-    worker_ = std::thread(&AsyncExecutor::Run, this);
+    EnsureWorkers(workerCount);
 }
 
 AsyncExecutor::~AsyncExecutor()
 {
     Stop();
-    if (worker_.joinable())
-        worker_.join();
+
+    std::vector<std::thread> workers;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        workers.swap(workers_);
+    }
+
+    for (auto& worker : workers)
+    {
+        if (worker.joinable())
+            worker.join();
+    }
+}
+
+void AsyncExecutor::EnsureWorkers(std::size_t workerCount)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_.load())
+        return;
+
+    while (workers_.size() < workerCount)
+        workers_.emplace_back(&AsyncExecutor::Run, this);
+}
+
+std::size_t AsyncExecutor::WorkerCount() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return workers_.size();
 }
 
-CancellationToken AsyncExecutor::Submit(Task task, std::size_t maxQueueDepth)
+CancellationToken AsyncExecutor::Submit(Task task, std::size_t maxQueueDepth, CancellationToken token)
 {
-    CancellationToken token;
     {
         std::unique_lock<std::mutex> lock(mutex_);
         if (!running_.load())
@@ -42,7 +67,9 @@ CancellationToken AsyncExecutor::Submit(Task task, std::size_t maxQueueDepth)
         }
         tasks_.emplace(std::move(task), token);
     }
-    cv_.notify_one();
+    // Producers blocked on maxQueueDepth share this condition variable, so wake
+    // everyone to make sure an idle worker sees the new task.
+    cv_.notify_all();
     return token;
 }
 
@@ -11,6 +11,7 @@
 #include <queue>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 
 namespace database
 {
@@ -30,7 +31,7 @@ private:
 class AsyncExecutor
 {
 public:
-    AsyncExecutor();
+    explicit AsyncExecutor(std::size_t workerCount = 1);
     ~AsyncExecutor();
 
     AsyncExecutor(const AsyncExecutor&) = delete;
@@ -38,10 +39,14 @@ public:
 
     using Task = std::function<void()>;
 
-    CancellationToken Submit(Task task, std::size_t maxQueueDepth = 0);
+    CancellationToken Submit(Task task, std::size_t maxQueueDepth = 0, CancellationToken token = {});
+
+    // Grows the worker set so up to workerCount tasks run concurrently. Never shrinks.
+    void EnsureWorkers(std::size_t workerCount);
 
     void Stop();
     std::size_t QueueSize() const;
+    std::size_t WorkerCount() const;
 
 private:
     void Run();
@@ -49,7 +54,7 @@ private:
     mutable std::mutex mutex_;
     std::condition_variable cv_;
     std::queue<std::pair<Task, CancellationToken>> tasks_;
-    std::thread worker_;
+    std::vector<std::thread> workers_;
     std::atomic<bool> running_;
 };
 
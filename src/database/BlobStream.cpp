@@ -0,0 +1,143 @@
+#include "BlobStream.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace database
+{
+
+namespace
+{
+
+constexpr std::size_t ReadChunkSize = 64 * 1024;
+
+template <typename Buffer>
+void ReadAll(std::istream& stream, Buffer& out)
+{
+    out.clear();
+
+    // The connector hands out memory-backed streams, so the size is usually known.
+    const auto start = stream.tellg();
+    if (start != std::istream::pos_type(-1) && stream.seekg(0, std::ios::end))
+    {
+        const auto end = stream.tellg();
+        stream.seekg(start);
+
+        if (end != std::istream::pos_type(-1) && end >= start)
+        {
+            out.resize(static_cast<std::size_t>(end - start));
+            stream.read(reinterpret_cast<char*>(out.data()), static_cast<std::streamsize>(out.size()));
+            out.resize(static_cast<std::size_t>(stream.gcount()));
+            return;
+        }
+    }
+
+    stream.clear();
+
+    std::size_t used = 0;
+    while (stream)
+    {
+        out.resize(used + ReadChunkSize);
+        stream.read(reinterpret_cast<char*>(out.data()) + used, static_cast<std::streamsize>(ReadChunkSize));
+        used += static_cast<std::size_t>(stream.gcount());
+    }
+    out.resize(used);
+}
+
+} // namespace
+
+SpanStreamBuf::SpanStreamBuf(std::span<const std::uint8_t> data)
+{
+    Reset(data);
+}
+
+void SpanStreamBuf::Reset(std::span<const std::uint8_t> data)
+{
+    // The get area is never written through; streambuf just wants char*.
+    auto* begin = const_cast<char*>(reinterpret_cast<const char*>(data.data()));
+    setg(begin, begin, begin + data.size());
+}
+
+std::streamsize SpanStreamBuf::showmanyc()
+{
+    return egptr() - gptr();
+}
+
+std::streamsize SpanStreamBuf::xsgetn(char* out, std::streamsize count)
+{
+    const std::streamsize available = std::min<std::streamsize>(count, egptr() - gptr());
+    if (available > 0)
+    {
+        std::copy_n(gptr(), available, out);
+        // gbump takes an int, which would wrap for reads over 2 GiB
+        setg(eback(), gptr() + available, egptr());
+    }
+    return available;
+}
+
+SpanStreamBuf::pos_type SpanStreamBuf::seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which)
+{
+    if (!(which & std::ios_base::in))
+        return pos_type(off_type(-1));
+
+    off_type base = 0;
+    if (dir == std::ios_base::cur)
+        base = gptr() - eback();
+    else if (dir == std::ios_base::end)
+        base = egptr() - eback();
+
+    const off_type target = base + offset;
+    if (target < 0 || target > egptr() - eback())
+        return pos_type(off_type(-1));
+
+    setg(eback(), eback() + target, egptr());
+    return pos_type(target);
+}
+
+SpanStreamBuf::pos_type SpanStreamBuf::seekpos(pos_type position, std::ios_base::openmode which)
+{
+    return seekoff(off_type(position), std::ios_base::beg, which);
+}
+
+BlobInputStream::BlobInputStream(std::span<const std::uint8_t> view) : std::istream(nullptr), buffer_(view)
+{
+    rdbuf(&buffer_);
+}
+
+BlobInputStream::BlobInputStream(std::string owned) : std::istream(nullptr), owned_(std::move(owned))
+{
+    buffer_.Reset({reinterpret_cast<const std::uint8_t*>(owned_.data()), owned_.size()});
+    rdbuf(&buffer_);
+}
+
+void ReadBlobStream(std::istream& stream, std::string& out)
+{
+    ReadAll(stream, out);
+}
+
+void ReadBlobStream(std::istream& stream, std::vector<char>& out)
+{
+    ReadAll(stream, out);
+}
+
+void ReadBlobStream(std::istream& stream, std::vector<std::uint8_t>& out)
+{
+    ReadAll(stream, out);
+}
+
+bool ReadBlobColumn(sql::ResultSet* result, std::size_t index, std::vector<std::uint8_t>& buffer)
+{
+    buffer.clear();
+
+    if (!result || result->isNull(static_cast<std::int32_t>(index + 1)))
+        return false;
+
+    std::unique_ptr<std::istream> stream(result->getBlob(static_cast<std::int32_t>(index + 1)));
+    if (stream)
+        ReadAll(*stream, buffer);
+
+    return true;
+}
+
+} // namespace database
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <span>
+#include <streambuf>
+#include <string>
+#include <vector>
+
+#include <mariadb/conncpp.hpp>
+
+namespace database
+{
+
+// Read-only streambuf over memory it does not own. Lets the connector pull a
+// blob parameter straight from the caller's buffer.
+class SpanStreamBuf : public std::streambuf
+{
+public:
+    SpanStreamBuf() = default;
+    explicit SpanStreamBuf(std::span<const std::uint8_t> data);
+
+    void Reset(std::span<const std::uint8_t> data);
+
+protected:
+    std::streamsize showmanyc() override;
+    std::streamsize xsgetn(char* out, std::streamsize count) override;
+    pos_type seekoff(off_type offset, std::ios_base::seekdir dir, std::ios_base::openmode which) override;
+    pos_type seekpos(pos_type position, std::ios_base::openmode which) override;
+};
+
+// Input stream handed to sql::PreparedStatement::setBlob. Either views the
+// caller's bytes or owns a single copy of them.
+class BlobInputStream : public std::istream
+{
+public:
+    explicit BlobInputStream(std::span<const std::uint8_t> view);
+    explicit BlobInputStream(std::string owned);
+
+    BlobInputStream(const BlobInputStream&) = delete;
+    BlobInputStream& operator=(const BlobInputStream&) = delete;
+
+private:
+    std::string owned_;
+    SpanStreamBuf buffer_;
+};
+
+// Reads the whole stream into out in one go when the size is known, in large
+// chunks otherwise.
+void ReadBlobStream(std::istream& stream, std::string& out);
+void ReadBlobStream(std::istream& stream, std::vector<char>& out);
+void ReadBlobStream(std::istream& stream, std::vector<std::uint8_t>& out);
+
+// Bulk-reads a blob column (0-based index) into buffer, reusing its capacity.
+// Returns false for NULL. Keep one buffer across rows to avoid reallocating.
+bool ReadBlobColumn(sql::ResultSet* result, std::size_t index, std::vector<std::uint8_t>& buffer);
+
+} // namespace database
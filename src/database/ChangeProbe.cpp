@@ -0,0 +1,96 @@
+#include "ChangeProbe.h"
+
+#include <map>
+#include <memory>
+
+#include "Logger.h"
+#include "QueryResult.h"
+
+namespace database
+{
+
+struct ChangeProbe::Counters
+{
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> misses{0};
+};
+
+namespace
+{
+
+std::mutex& RegistryMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+// Never shrinks, so the counters handed out stay valid for the whole run.
+template <typename Counters>
+std::map<std::string, std::unique_ptr<Counters>>& Registry()
+{
+    static std::map<std::string, std::unique_ptr<Counters>> registry;
+    return registry;
+}
+
+} // namespace
+
+ChangeProbe::ChangeProbe(std::string table, StatementName statement) : table_(std::move(table)), statement_(statement)
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+
+    auto& slot = Registry<Counters>()[table_];
+    if (!slot)
+        slot = std::make_unique<Counters>();
+
+    counters_ = slot.get();
+}
+
+std::optional<ChangeProbe::Version> ChangeProbe::ReadVersion(DatabaseConnection& connection) const
+{
+    auto stmt = connection.GetPreparedStatement(statement_);
+    if (!stmt)
+        return std::nullopt;
+
+    stmt->SetString(0, table_);
+
+    auto result = connection.ExecutePreparedSelect(*stmt);
+    if (!result.IsValid() || !result.Next())
+        return std::nullopt;
+
+    Field* fields = result.Fetch();
+    return fields[0].GetUInt64();
+}
+
+ChangeProbe::Result ChangeProbe::Check(DatabaseConnection& connection, Version loaded) const
+{
+    Result result;
+
+    if (auto version = ReadVersion(connection))
+        result.version = *version;
+    else
+        LOG_DEBUG("ChangeProbe: no version for {}, reloading", table_);
+
+    result.unchanged = result.version != NoVersion && result.version == loaded;
+
+    if (result.unchanged)
+        counters_->hits.fetch_add(1, std::memory_order_relaxed);
+    else
+        counters_->misses.fetch_add(1, std::memory_order_relaxed);
+
+    return result;
+}
+
+std::vector<ChangeProbeStats> ChangeProbe::GetDiagnostics()
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+
+    std::vector<ChangeProbeStats> out;
+    out.reserve(Registry<Counters>().size());
+
+    for (const auto& [table, counters] : Registry<Counters>())
+        out.push_back({table, counters->hits.load(std::memory_order_relaxed), counters->misses.load(std::memory_order_relaxed)});
+
+    return out;
+}
+
+} // namespace database
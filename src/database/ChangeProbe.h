@@ -0,0 +1,129 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "DatabaseConnection.h"
+#include "PreparedStatementNames.h"
+
+namespace database
+{
+
+struct ChangeProbeStats
+{
+    std::string table;
+    std::uint64_t hits = 0;    // probe matched, full reload skipped
+    std::uint64_t misses = 0;  // changed, never loaded or probe failed
+};
+
+// Decides whether a cached table has to be read again. The probe statement
+// returns the table's version counter (one primary key lookup in
+// ams_table_version, bumped by triggers on every write), so an unchanged table
+// costs one tiny query instead of a full transfer.
+class ChangeProbe
+{
+public:
+    using Version = std::uint64_t;
+    static constexpr Version NoVersion = ~Version{0};
+
+    struct Result
+    {
+        Version version = NoVersion;
+        bool unchanged = false;
+    };
+
+    // statement takes the table name as its only parameter and returns the version.
+    template <typename StatementEnum>
+    ChangeProbe(std::string table, StatementEnum statement) : ChangeProbe(std::move(table), ToStatementName(statement))
+    {
+    }
+
+    ChangeProbe(std::string table, StatementName statement);
+
+    // Reads the current version and compares it with `loaded`. Counts a hit or miss.
+    Result Check(DatabaseConnection& connection, Version loaded) const;
+
+    // Single data set per probe: compares with the version of the last MarkLoaded.
+    Result Check(DatabaseConnection& connection) const { return Check(connection, loaded_.load(std::memory_order_acquire)); }
+    // Call once the full load succeeded, with the result of the Check before it.
+    void MarkLoaded(const Result& result) { loaded_.store(result.version, std::memory_order_release); }
+    void Invalidate() { loaded_.store(NoVersion, std::memory_order_release); }
+
+    const std::string& GetTable() const { return table_; }
+
+    // Hits and misses per table since start, over all probes of that table.
+    static std::vector<ChangeProbeStats> GetDiagnostics();
+
+private:
+    struct Counters;
+
+    std::optional<Version> ReadVersion(DatabaseConnection& connection) const;
+
+    std::string table_;
+    StatementName statement_;
+    Counters* counters_;
+    std::atomic<Version> loaded_{NoVersion};
+};
+
+// Results of a parameterised read of one table (by location, with or without
+// deleted rows, ...), reused while the table's version is unchanged.
+template <typename T>
+class ProbedCache
+{
+public:
+    template <typename StatementEnum>
+    ProbedCache(std::string table, StatementEnum statement) : probe_(std::move(table), statement)
+    {
+    }
+
+    // load(connection) returns std::optional<T>; nullopt (query failed) is not cached.
+    template <typename Load>
+    T Get(DatabaseConnection& connection, const std::string& key, Load&& load)
+    {
+        ChangeProbe::Version loaded = ChangeProbe::NoVersion;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (auto it = entries_.find(key); it != entries_.end())
+                loaded = it->second.first;
+        }
+
+        const auto probe = probe_.Check(connection, loaded);
+        if (probe.unchanged)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (auto it = entries_.find(key); it != entries_.end() && it->second.first == probe.version)
+                return it->second.second;
+        }
+
+        std::optional<T> value = load(connection);
+        if (!value)
+            return T{};
+
+        if (probe.version != ChangeProbe::NoVersion)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            entries_[key] = {probe.version, *value};
+        }
+
+        return std::move(*value);
+    }
+
+    void Invalidate()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        entries_.clear();
+    }
+
+private:
+    ChangeProbe probe_;
+    std::mutex mutex_;
+    std::unordered_map<std::string, std::pair<ChangeProbe::Version, T>> entries_;
+};
+
+} // namespace database
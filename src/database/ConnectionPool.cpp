@@ -1,7 +1,9 @@
 
 #include "ConnectionPool.h"
 
+#include <algorithm>
 #include <chrono>
+#include <future>
 #include <stdexcept>
 
 #include "MySQLPreparedStatements.h"
@@ -54,7 +56,7 @@ void ConnectionPool::Configure(const PoolConfig& config)
 {
     stopping_.store(true);
     LOG_WARNING("ConnectionPool reconfigure requested; pausing Acquire until reconfiguration completes.");
-    cv_.notify_all();
+    NotifyAllWaiters();
     maintenanceRunning_.store(false);
     if (maintenanceThread_.joinable())
         maintenanceThread_.join();
@@ -62,10 +64,15 @@ void ConnectionPool::Configure(const PoolConfig& config)
     std::lock_guard<std::mutex> lock(mutex_);
     config_ = config;
 
+    // Without a lag query there is nothing to measure; trust the replica.
+    replicaInRotation_.store(config.replicaConfig.lagQuery.empty());
+    replicaLagSeconds_.store(-1);
+
     syncConnections_.clear();
     asyncConnections_.clear();
     replicaSyncConnections_.clear();
     replicaAsyncConnections_.clear();
+    brokenConnections_.clear();
 
     while (!availableSync_.empty())
         availableSync_.pop();
@@ -92,84 +99,204 @@ void ConnectionPool::Configure(const PoolConfig& config)
         InitializePool(ConnectionType::Async, config.asyncLimits, config.replica, true);
     }
 
+    // One worker per connection the pool may hand out, so independent async
+    // queries run side by side instead of queueing behind each other.
+    asyncExecutor_.EnsureWorkers(std::max(config.syncLimits.maxSize, config.asyncLimits.maxSize));
+
     maintenanceRunning_.store(true);
     maintenanceThread_ = std::thread(&ConnectionPool::MaintenanceLoop, this);
 
     stopping_.store(false);
     LOG_WARNING("ConnectionPool reconfigure completed; Acquire resumed.");
-    cv_.notify_all();
+    NotifyAllWaiters();
 }
 
 std::shared_ptr<DatabaseConnection> ConnectionPool::Acquire(ConnectionType type, bool preferReplica)
 {
+    return Acquire(type, preferReplica, LeasePriorityScope::Current());
+}
+
+std::shared_ptr<DatabaseConnection> ConnectionPool::Acquire(ConnectionType type, bool preferReplica, LeasePriority priority)
+{
+    const auto waitStart = std::chrono::steady_clock::now();
+    const bool background = priority == LeasePriority::Background;
+
     std::unique_lock<std::mutex> lock(mutex_);
     auto& primaryQueue = (type == ConnectionType::Sync) ? availableSync_ : availableAsync_;
     auto& replicaQueue = (type == ConnectionType::Sync) ? availableReplicaSync_ : availableReplicaAsync_;
+    auto& admission = Admission(type);
+
+    auto take = [](std::queue<std::shared_ptr<DatabaseConnection>>& queue)
+    {
+        auto connection = queue.front();
+        queue.pop();
+        return connection;
+    };
+
+    // Called with the lock held: books the lease against its priority.
+    auto lease = [&](std::shared_ptr<DatabaseConnection> connection)
+    {
+        connection->SetLeasePriority(priority);
+        if (background)
+            ++admission.backgroundLeased;
+        else if (--admission.interactiveWaiters == 0 && (!primaryQueue.empty() || !replicaQueue.empty()))
+            admission.backgroundCv.notify_all();  // connections held back for us are free again
+
+        (background ? backgroundWait_ : interactiveWait_).Record(std::chrono::steady_clock::now() - waitStart);
+        return connection;
+    };
+
+    if (!background)
+        ++admission.interactiveWaiters;
 
     while (true)
     {
         if (stopping_.load())
         {
+            if (!background)
+                --admission.interactiveWaiters;
+
             LOG_WARNING("ConnectionPool Acquire aborted: pool is stopping.");
             return {};
         }
 
-        if (preferReplica && !replicaQueue.empty())
-        {
-            auto connection = replicaQueue.front();
-            replicaQueue.pop();
-            return connection;
-        }
+        // Callers that may write never get a replica; replica-eligible reads
+        // fall back to the primary when the replica is lagging or busy.
+        const bool useReplica = preferReplica && ReplicaUsableForReads();
 
-        if (!primaryQueue.empty())
+        std::shared_ptr<DatabaseConnection> connection;
+        if (!background || AdmitsBackground(type))
         {
-            auto connection = primaryQueue.front();
-            primaryQueue.pop();
-            return connection;
+            if (useReplica && !replicaQueue.empty())
+                connection = take(replicaQueue);
+            else if (!primaryQueue.empty())
+                connection = take(primaryQueue);
+            else
+                connection = TryGrowPool(type, lock);
         }
 
-        if (config_.useReplicaForReads && !replicaQueue.empty())
+        if (connection)
         {
-            auto connection = replicaQueue.front();
-            replicaQueue.pop();
-            return connection;
+            if (!NeedsValidation(*connection))
+                return lease(std::move(connection));
+
+            // Validate-on-borrow runs outside the lock so a dead server does not
+            // stall Release() and the other borrowers.
+            lock.unlock();
+            const bool healthy = EnsureConnected(connection);
+            lock.lock();
+
+            if (healthy)
+                return lease(std::move(connection));
+
+            LOG_WARNING("ConnectionPool dropped a connection that failed validation on borrow.");
+            brokenConnections_.push_back(connection);
+            continue;
         }
 
-        const bool ready = cv_.wait_for(lock, std::chrono::seconds(5), [&]()
-                                        { return stopping_.load() || !primaryQueue.empty() || !replicaQueue.empty(); });
+        const auto available = [&]() { return !primaryQueue.empty() || (useReplica && !replicaQueue.empty()); };
+
+        const bool ready = background
+            ? admission.backgroundCv.wait_for(lock, std::chrono::seconds(5), [&]() { return stopping_.load() || (available() && AdmitsBackground(type)); })
+            : admission.interactiveCv.wait_for(lock, std::chrono::seconds(5), [&]() { return stopping_.load() || available(); });
         if (!ready)
             LOG_WARNING("ConnectionPool Acquire still waiting for an available connection.");
 
     }
 }
 
+std::shared_ptr<DatabaseConnection> ConnectionPool::TryGrowPool(ConnectionType type, std::unique_lock<std::mutex>& lock)
+{
+    const bool sync = type == ConnectionType::Sync;
+    const auto& limits = sync ? config_.syncLimits : config_.asyncLimits;
+    auto& connections = sync ? syncConnections_ : asyncConnections_;
+    auto& pending = sync ? pendingSyncGrowth_ : pendingAsyncGrowth_;
+
+    if (!config_.primary.isActive || connections.size() + pending >= limits.maxSize)
+        return {};
+
+    ++pending;
+    const MySQLSettings settings = config_.primary;
+
+    // Connecting may take a while (TLS, SSH tunnel); don't block Release() meanwhile.
+    lock.unlock();
+    std::shared_ptr<DatabaseConnection> connection;
+    try
+    {
+        connection = CreateConnection(settings, type, false);
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_ERROR(std::string("Failed to grow connection pool: ") + ex.what());
+    }
+    lock.lock();
+
+    --pending;
+    if (connection && !stopping_.load())
+    {
+        connections.push_back(connection);
+        LOG_DEBUG("ConnectionPool grew {} pool to {} connections", sync ? "sync" : "async", connections.size());
+        return connection;
+    }
+
+    return {};
+}
+
 void ConnectionPool::Release(const std::shared_ptr<DatabaseConnection>& connection)
 {
     if (!connection)
         return;
 
+    connection->MarkIdle();
+    if (connection->TakeWriteMark() && !connection->IsReplica())
+        lastPrimaryWrite_.store(std::chrono::steady_clock::now().time_since_epoch().count());
+
     std::scoped_lock lock(mutex_);
+    AvailableQueue(*connection).push(connection);
 
-    if (connection->IsReplica())
-    {
-        auto& queue = (connection->GetConnectionType() == ConnectionType::Sync) ? availableReplicaSync_ : availableReplicaAsync_;
-        queue.push(connection);
-    }
+    auto& admission = Admission(connection->GetConnectionType());
+    if (connection->GetLeasePriority() == LeasePriority::Background && admission.backgroundLeased > 0)
+        --admission.backgroundLeased;
+    connection->SetLeasePriority(LeasePriority::Interactive);
+
+    NotifyWaiters(connection->GetConnectionType());
+}
+
+bool ConnectionPool::AdmitsBackground(ConnectionType type) const
+{
+    const auto& admission = type == ConnectionType::Sync ? syncAdmission_ : asyncAdmission_;
+    const auto& limits = type == ConnectionType::Sync ? config_.syncLimits : config_.asyncLimits;
+    return admission.interactiveWaiters == 0 && admission.backgroundLeased < std::max<std::size_t>(limits.maxBackground, 1);
+}
+
+// Call with mutex_ held.
+void ConnectionPool::NotifyWaiters(ConnectionType type)
+{
+    // notify_all: a waiter that only takes the primary queue (or is over its
+    // quota) would otherwise swallow the wakeup meant for another one.
+    auto& admission = Admission(type);
+    if (admission.interactiveWaiters > 0)
+        admission.interactiveCv.notify_all();
     else
+        admission.backgroundCv.notify_all();
+}
+
+void ConnectionPool::NotifyAllWaiters()
+{
+    for (auto* admission : {&syncAdmission_, &asyncAdmission_})
     {
-        auto& queue = (connection->GetConnectionType() == ConnectionType::Sync) ? availableSync_ : availableAsync_;
-        queue.push(connection);
+        admission->interactiveCv.notify_all();
+        admission->backgroundCv.notify_all();
     }
-
-    cv_.notify_one();
 }
 
-CancellationToken ConnectionPool::SubmitAsync(ConnectionType type, std::function<void(std::shared_ptr<DatabaseConnection>)> task, bool preferReplica)
+CancellationToken ConnectionPool::SubmitAsync(ConnectionType type, std::function<void(std::shared_ptr<DatabaseConnection>)> task, bool preferReplica,
+                                              CancellationToken token)
 {
     auto maxDepth = (type == ConnectionType::Sync) ? config_.syncLimits.maxQueueDepth : config_.asyncLimits.maxQueueDepth;
     return asyncExecutor_.Submit(
-        [this, task = std::move(task), preferReplica, type]() {
-            auto connection = Acquire(type, preferReplica && config_.useReplicaForReads);
+        [this, task = std::move(task), preferReplica, type, priority = LeasePriorityScope::Current()]() {
+            auto connection = Acquire(type, preferReplica && config_.useReplicaForReads, priority);
             if (!connection)
             {
                 LOG_WARNING("Async query skipped because no connection was available.");
@@ -186,7 +313,52 @@ CancellationToken ConnectionPool::SubmitAsync(ConnectionType type, std::function
             }
             Release(connection);
         },
-        maxDepth);
+        maxDepth, std::move(token));
+}
+
+void ConnectionPool::SubmitControl(std::function<void()> fn)
+{
+    controlExecutor_.Submit(std::move(fn));
+}
+
+bool ConnectionPool::KillQuery(const DatabaseConnection& target)
+{
+    const std::uint64_t threadId = target.GetServerThreadId();
+    if (threadId == 0)
+        return false;
+
+    std::scoped_lock lock(controlMutex_);
+
+    auto& control = target.IsReplica() ? replicaControl_ : primaryControl_;
+    if (!control || !control->IsConnected())
+    {
+        try
+        {
+            control = CreateConnection(target.GetSettings(), ConnectionType::Sync, target.IsReplica());
+        }
+        catch (const std::exception& ex)
+        {
+            LOG_ERROR(std::string("Failed to open control connection for KILL QUERY: ") + ex.what());
+            control.reset();
+            return false;
+        }
+    }
+
+    if (!control->ExecuteUpdate("KILL QUERY " + std::to_string(threadId)))
+    {
+        // Reconnect on the next attempt.
+        control.reset();
+        return false;
+    }
+
+    killedQueries_.fetch_add(1, std::memory_order_relaxed);
+    LOG_DEBUG("ConnectionPool killed the query on connection {}", threadId);
+    return true;
+}
+
+void ConnectionPool::RecordInterruptedLease(bool timedOut)
+{
+    (timedOut ? timedOutLeases_ : cancelledLeases_).fetch_add(1, std::memory_order_relaxed);
 }
 
 void ConnectionPool::StartMaintenance()
@@ -195,7 +367,7 @@ void ConnectionPool::StartMaintenance()
     if (maintenanceRunning_.compare_exchange_strong(expected, true))
     {
         stopping_.store(false);
-        cv_.notify_all();
+        NotifyAllWaiters();
 
         maintenanceThread_ = std::thread(&ConnectionPool::MaintenanceLoop, this);
     }
@@ -205,7 +377,7 @@ void ConnectionPool::StopMaintenance()
 {
     stopping_.store(true);
     LOG_WARNING("ConnectionPool stopping; releasing any waiting Acquire calls.");
-    cv_.notify_all();
+    NotifyAllWaiters();
 
     bool expected = true;
     if (maintenanceRunning_.compare_exchange_strong(expected, false))
@@ -222,6 +394,13 @@ void ConnectionPool::Shutdown()
 {
     StopMaintenance();
 
+    controlExecutor_.Stop();
+    {
+        std::scoped_lock controlLock(controlMutex_);
+        primaryControl_.reset();
+        replicaControl_.reset();
+    }
+
     std::scoped_lock lock(mutex_);
 
     auto disconnectAll = [](std::vector<std::shared_ptr<DatabaseConnection>>& connections)
@@ -238,6 +417,7 @@ void ConnectionPool::Shutdown()
     disconnectAll(asyncConnections_);
     disconnectAll(replicaSyncConnections_);
     disconnectAll(replicaAsyncConnections_);
+    brokenConnections_.clear();
 
     while (!availableSync_.empty())
         availableSync_.pop();
@@ -248,7 +428,7 @@ void ConnectionPool::Shutdown()
     while (!availableReplicaAsync_.empty())
         availableReplicaAsync_.pop();
 
-    cv_.notify_all();
+    NotifyAllWaiters();
 }
 
 DiagnosticsSnapshot ConnectionPool::GetDiagnostics() const
@@ -263,11 +443,27 @@ DiagnosticsSnapshot ConnectionPool::GetDiagnostics() const
     snapshot.asyncAvailable = availableAsync_.size();
     snapshot.replicaSyncAvailable = availableReplicaSync_.size();
     snapshot.replicaAsyncAvailable = availableReplicaAsync_.size();
+    snapshot.brokenConnections = brokenConnections_.size();
+    snapshot.replicaLagSeconds = replicaLagSeconds_.load();
+    snapshot.replicaInRotation = replicaInRotation_.load();
     snapshot.queuedJobs = asyncExecutor_.QueueSize();
     snapshot.registeredStatements = PreparedStatementRegistry::Instance().GetAll().size();
+    snapshot.killedQueries = killedQueries_.load(std::memory_order_relaxed);
+    snapshot.cancelledLeases = cancelledLeases_.load(std::memory_order_relaxed);
+    snapshot.timedOutLeases = timedOutLeases_.load(std::memory_order_relaxed);
+    snapshot.unboundedLeases = unboundedLeases_.load(std::memory_order_relaxed);
+    snapshot.backgroundLeased = syncAdmission_.backgroundLeased + asyncAdmission_.backgroundLeased;
+    snapshot.interactiveWait = interactiveWait_.Snapshot();
+    snapshot.backgroundWait = backgroundWait_.Snapshot();
     return snapshot;
 }
 
+void ConnectionPool::ResetWaitStats()
+{
+    interactiveWait_.Reset();
+    backgroundWait_.Reset();
+}
+
 void ConnectionPool::InitializePool(ConnectionType type, const PoolLimits& limits, const MySQLSettings& settings, bool replica)
 {
     auto& connections = replica ? ((type == ConnectionType::Sync) ? replicaSyncConnections_ : replicaAsyncConnections_)
@@ -294,90 +490,299 @@ void ConnectionPool::MaintenanceLoop()
 {
     while (maintenanceRunning_.load())
     {
+        RefreshReplicaLag();
+
+        std::uint32_t waitSeconds = config_.maintenance.pingIntervalSeconds;
+        {
+            // Broken connections are retried sooner than the regular ping cycle.
+            std::scoped_lock lock(mutex_);
+            if (!brokenConnections_.empty())
+                waitSeconds = std::min(waitSeconds, config_.maintenance.reconnectDelaySeconds);
+        }
+
         std::unique_lock<std::mutex> maintenanceLock(maintenanceMutex_);
-        maintenanceCv_.wait_for(maintenanceLock, std::chrono::seconds(config_.maintenance.pingIntervalSeconds),
+        maintenanceCv_.wait_for(maintenanceLock, std::chrono::seconds(waitSeconds),
                                 [this]() { return !maintenanceRunning_.load(); });
         if (!maintenanceRunning_.load())
             break;
+        maintenanceLock.unlock();
 
-        std::unique_lock<std::mutex> lock(mutex_);
-        auto checkConnections = [&](std::vector<std::shared_ptr<DatabaseConnection>>& connections, std::queue<std::shared_ptr<DatabaseConnection>>& availableQueue, bool replica) {
-            for (auto& connection : connections)
+        CheckIdleConnections();
+    }
+}
+
+void ConnectionPool::CheckIdleConnections()
+{
+    std::vector<std::shared_ptr<DatabaseConnection>> candidates;
+
+    {
+        std::scoped_lock lock(mutex_);
+
+        // Only idle connections are checked; leased ones belong to their borrower,
+        // and anything used recently has just proven itself.
+        auto takeIdle = [&](std::queue<std::shared_ptr<DatabaseConnection>>& queue)
+        {
+            std::queue<std::shared_ptr<DatabaseConnection>> keep;
+            while (!queue.empty())
             {
-                if (!EnsureConnected(connection))
-                    continue;
-
-                if (!connection->Ping())
-                {
-                    LOG_WARNING("Ping failed, reconnecting...");
-                    connection->Disconnect();
-                    lock.unlock();
-                    std::this_thread::sleep_for(std::chrono::seconds(config_.maintenance.reconnectDelaySeconds));
-                    lock.lock();
-                    connection->Connect();
-                }
-
-                if (replica && config_.replicaConfig.enabled && !config_.replicaConfig.lagQuery.empty())
-                {
-                    try
-                    {
-                        lock.unlock();
-                        auto lagResult = connection->ExecuteSelect(config_.replicaConfig.lagQuery);
-                        lock.lock();
-                        if (lagResult.IsValid() && lagResult.GetFieldCount() > 0)
-                        {
-                            if (Field* fields = lagResult.Fetch())
-                            {
-                                const Field& lagField = fields[0];
-                                if (lagField.IsNull())
-                                    continue;
-
-                                auto lagString = lagField.ToString();
-                                std::uint64_t lagSeconds = 0;
-                                if (!lagString.empty())
-                                    lagSeconds = static_cast<std::uint64_t>(std::stoull(lagString));
-                                if (lagSeconds > config_.replicaConfig.maxAllowedLagSeconds)
-                                {
-                                    LOG_WARNING("Replica lag exceeds configured threshold: " + std::to_string(lagSeconds) + "s");
-                                }
-                            }
-                        }
-                    }
-                    catch (const std::exception& ex)
-                    {
-                        if (!lock.owns_lock())
-                            lock.lock();
-                        LOG_ERROR(std::string("Replica lag check failed: ") + ex.what());
-                    }
-                }
+                auto connection = queue.front();
+                queue.pop();
+                if (NeedsValidation(*connection))
+                    candidates.push_back(std::move(connection));
+                else
+                    keep.push(std::move(connection));
             }
+            std::swap(queue, keep);
+        };
+
+        takeIdle(availableSync_);
+        takeIdle(availableAsync_);
+        takeIdle(availableReplicaSync_);
+        takeIdle(availableReplicaAsync_);
 
-            std::queue<std::shared_ptr<DatabaseConnection>> refreshed;
-            while (!availableQueue.empty())
+        candidates.insert(candidates.end(), brokenConnections_.begin(), brokenConnections_.end());
+        brokenConnections_.clear();
+    }
+
+    if (candidates.empty())
+        return;
+
+    // Pings and reconnects run a few at a time and without the pool lock, so
+    // Acquire/Release keep going while one server is slow to answer, and a
+    // large pool does not spawn a thread per idle connection.
+    std::vector<bool> healthy(candidates.size(), false);
+    for (std::size_t first = 0; first < candidates.size(); first += MaxParallelChecks)
+    {
+        const std::size_t last = std::min(first + MaxParallelChecks, candidates.size());
+
+        std::vector<std::future<bool>> checks;
+        checks.reserve(last - first);
+        for (std::size_t i = first; i < last; ++i)
+            checks.push_back(std::async(std::launch::async, [this, connection = candidates[i]]() { return EnsureConnected(connection); }));
+
+        for (std::size_t i = first; i < last; ++i)
+            healthy[i] = checks[i - first].get();
+    }
+
+    {
+        std::scoped_lock lock(mutex_);
+        for (std::size_t i = 0; i < candidates.size(); ++i)
+        {
+            const auto& connection = candidates[i];
+            if (!IsPooled(connection))
+                continue;
+
+            if (healthy[i])
             {
-                auto conn = availableQueue.front();
-                availableQueue.pop();
-                if (conn->IsConnected())
-                    refreshed.push(conn);
+                connection->MarkIdle();
+                AvailableQueue(*connection).push(connection);
             }
-            std::swap(availableQueue, refreshed);
-        };
+            else
+            {
+                brokenConnections_.push_back(connection);
+            }
+        }
+    }
+
+    NotifyAllWaiters();
+}
+
+void ConnectionPool::RefreshReplicaLag()
+{
+    if (!config_.replicaConfig.enabled || config_.replicaConfig.lagQuery.empty())
+        return;
+
+    // Lag is a property of the server; one idle replica connection is enough.
+    // With all of them leased the previous measurement stays in effect.
+    std::shared_ptr<DatabaseConnection> connection;
+    {
+        std::scoped_lock lock(mutex_);
+        for (auto* queue : {&availableReplicaAsync_, &availableReplicaSync_})
+        {
+            if (!queue->empty())
+            {
+                connection = queue->front();
+                queue->pop();
+                break;
+            }
+        }
+    }
+
+    if (!connection)
+        return;
+
+    // A dead replica would throw or hang in the lag query; take it out of
+    // rotation and let the broken-connection retry bring it back.
+    if (!EnsureConnected(connection))
+    {
+        {
+            std::scoped_lock lock(mutex_);
+            brokenConnections_.push_back(connection);
+        }
+
+        replicaLagSeconds_.store(-1);
+        if (replicaInRotation_.exchange(false))
+            LOG_WARNING("Replica unreachable; reads go to the primary");
+        return;
+    }
+
+    std::optional<std::uint64_t> lag;
+    try
+    {
+        lag = QueryReplicaLag(*connection);
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_ERROR(std::string("Replica lag check failed: ") + ex.what());
+    }
+
+    Release(connection);
+
+    const bool inRotation = lag && *lag <= config_.replicaConfig.maxAllowedLagSeconds;
+    replicaLagSeconds_.store(lag ? static_cast<std::int64_t>(*lag) : -1);
+
+    if (replicaInRotation_.exchange(inRotation) == inRotation)
+        return;
+
+    if (inRotation)
+        LOG_INFO("Replica back in read rotation, lag " + std::to_string(*lag) + "s");
+    else if (lag)
+        LOG_WARNING("Replica lag exceeds configured threshold: " + std::to_string(*lag) + "s; reads go to the primary");
+    else
+        LOG_WARNING("Replica lag unknown; reads go to the primary");
+}
+
+std::optional<std::uint64_t> ConnectionPool::QueryReplicaLag(DatabaseConnection& connection) const
+{
+    sql::Connection* raw = connection.GetRawConnection();
+    if (!raw)
+        return std::nullopt;
 
-        checkConnections(syncConnections_, availableSync_, false);
-        checkConnections(asyncConnections_, availableAsync_, false);
-        checkConnections(replicaSyncConnections_, availableReplicaSync_, true);
-        checkConnections(replicaAsyncConnections_, availableReplicaAsync_, true);
+    std::unique_ptr<sql::Statement> statement(raw->createStatement());
+    std::unique_ptr<sql::ResultSet> result(statement->executeQuery(config_.replicaConfig.lagQuery));
+
+    // SHOW SLAVE STATUS is empty on a server that is not replicating.
+    if (!result || !result->next())
+        return std::nullopt;
+
+    // A custom lag query returns the lag as its only column, SHOW SLAVE STATUS
+    // names it. NULL means the replication threads are stopped.
+    sql::ResultSetMetaData* meta = result->getMetaData();
+    if (meta && meta->getColumnCount() == 1)
+    {
+        if (result->isNull(1))
+            return std::nullopt;
+        return result->getUInt64(1);
     }
+
+    if (result->isNull("Seconds_Behind_Master"))
+        return std::nullopt;
+
+    return static_cast<std::uint64_t>(std::stoull(std::string(result->getString("Seconds_Behind_Master"))));
+}
+
+bool ConnectionPool::ReplicaUsableForReads() const
+{
+    if (!config_.useReplicaForReads || !replicaInRotation_.load())
+        return false;
+
+    // Read-your-writes: after this session wrote, a replica within the lag
+    // threshold has caught up once that threshold has passed.
+    const std::chrono::steady_clock::time_point lastWrite{std::chrono::steady_clock::duration(lastPrimaryWrite_.load())};
+    return std::chrono::steady_clock::now() - lastWrite > std::chrono::seconds(config_.replicaConfig.maxAllowedLagSeconds + 1);
 }
 
 bool ConnectionPool::EnsureConnected(const std::shared_ptr<DatabaseConnection>& connection)
 {
-    if (!connection->IsConnected())
+    if (connection->IsConnected())
+    {
+        if (connection->Ping())
+            return true;
+
+        LOG_WARNING("Ping failed, reconnecting...");
+        connection->Disconnect();
+    }
+    else
     {
         LOG_WARNING("Reconnecting database connection...");
-        return connection->Connect();
     }
-    return true;
+
+    return connection->Connect();
+}
+
+bool ConnectionPool::NeedsValidation(const DatabaseConnection& connection) const
+{
+    return connection.IdleTime() >= std::chrono::seconds(config_.maintenance.validateAfterIdleSeconds);
+}
+
+bool ConnectionPool::IsPooled(const std::shared_ptr<DatabaseConnection>& connection) const
+{
+    const bool sync = connection->GetConnectionType() == ConnectionType::Sync;
+    const auto& connections = connection->IsReplica() ? (sync ? replicaSyncConnections_ : replicaAsyncConnections_)
+                                                      : (sync ? syncConnections_ : asyncConnections_);
+    return std::find(connections.begin(), connections.end(), connection) != connections.end();
+}
+
+void ConnectionPool::WaitHistogram::Record(std::chrono::steady_clock::duration wait)
+{
+    const auto micros = static_cast<std::uint64_t>(std::max<std::int64_t>(std::chrono::duration_cast<std::chrono::microseconds>(wait).count(), 0));
+
+    std::size_t bucket = 0;
+    while (bucket + 1 < BucketCount && (std::uint64_t{1} << bucket) <= micros)
+        ++bucket;
+    buckets_[bucket].fetch_add(1, std::memory_order_relaxed);
+
+    auto max = maxMicros_.load(std::memory_order_relaxed);
+    while (micros > max && !maxMicros_.compare_exchange_weak(max, micros, std::memory_order_relaxed))
+        ;
+}
+
+LeaseWaitStats ConnectionPool::WaitHistogram::Snapshot() const
+{
+    std::array<std::uint64_t, BucketCount> counts{};
+    LeaseWaitStats stats;
+    for (std::size_t i = 0; i < BucketCount; ++i)
+    {
+        counts[i] = buckets_[i].load(std::memory_order_relaxed);
+        stats.leases += counts[i];
+    }
+
+    stats.maxMs = static_cast<double>(maxMicros_.load(std::memory_order_relaxed)) / 1000.0;
+    if (stats.leases == 0)
+        return stats;
+
+    // Upper bound of the bucket holding the quantile, capped by the observed maximum.
+    auto quantile = [&](double q)
+    {
+        const auto rank = static_cast<std::uint64_t>(q * static_cast<double>(stats.leases - 1)) + 1;
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BucketCount; ++i)
+        {
+            seen += counts[i];
+            if (seen >= rank)
+                return std::min(static_cast<double>(std::uint64_t{1} << i) / 1000.0, stats.maxMs);
+        }
+        return stats.maxMs;
+    };
+
+    stats.p50Ms = quantile(0.50);
+    stats.p99Ms = quantile(0.99);
+    return stats;
+}
+
+void ConnectionPool::WaitHistogram::Reset()
+{
+    for (auto& bucket : buckets_)
+        bucket.store(0, std::memory_order_relaxed);
+    maxMicros_.store(0, std::memory_order_relaxed);
+}
+
+std::queue<std::shared_ptr<DatabaseConnection>>& ConnectionPool::AvailableQueue(const DatabaseConnection& connection)
+{
+    const bool sync = connection.GetConnectionType() == ConnectionType::Sync;
+    if (connection.IsReplica())
+        return sync ? availableReplicaSync_ : availableReplicaAsync_;
+    return sync ? availableSync_ : availableAsync_;
 }
 
 } // namespace database
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <functional>
 #include <memory>
@@ -9,6 +11,7 @@
 #include <queue>
 #include <string>
 #include <thread>
+#include <utility>
 #include <vector>
 
 #include "AsyncExecutor.h"
@@ -18,6 +21,15 @@
 namespace database
 {
 
+// Time spent in Acquire for one lease priority, in milliseconds.
+struct LeaseWaitStats
+{
+    std::uint64_t leases = 0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+};
+
 struct DiagnosticsSnapshot
 {
     std::size_t syncPoolSize = 0;
@@ -28,8 +40,38 @@ struct DiagnosticsSnapshot
     std::size_t asyncAvailable = 0;
     std::size_t replicaSyncAvailable = 0;
     std::size_t replicaAsyncAvailable = 0;
+    std::size_t brokenConnections = 0;
+    std::int64_t replicaLagSeconds = -1;  // -1 when unknown
+    bool replicaInRotation = false;
     std::size_t queuedJobs = 0;
     std::size_t registeredStatements = 0;
+    std::uint64_t killedQueries = 0;     // KILL QUERY sent for cancelled leases
+    std::uint64_t cancelledLeases = 0;   // leases handed back early by Cancel()
+    std::uint64_t timedOutLeases = 0;    // leases handed back by a deadline
+    std::uint64_t unboundedLeases = 0;   // deadline could not be set on the server
+    std::size_t backgroundLeased = 0;    // sync + async connections held by background leases
+    LeaseWaitStats interactiveWait;
+    LeaseWaitStats backgroundWait;
+};
+
+// Tags every lease taken on this thread while it lives, e.g. at the top of a
+// refresh task: LeasePriorityScope background(LeasePriority::Background);
+// Threads start out Interactive. SubmitAsync carries the submitter's priority
+// over to the worker.
+class LeasePriorityScope
+{
+public:
+    explicit LeasePriorityScope(LeasePriority priority) : previous_(std::exchange(current_, priority)) { }
+    ~LeasePriorityScope() { current_ = previous_; }
+
+    LeasePriorityScope(const LeasePriorityScope&) = delete;
+    LeasePriorityScope& operator=(const LeasePriorityScope&) = delete;
+
+    static LeasePriority Current() { return current_; }
+
+private:
+    static inline thread_local LeasePriority current_ = LeasePriority::Interactive;
+    LeasePriority previous_;
 };
 
 class ConnectionPool
@@ -48,28 +90,87 @@ public:
     static std::shared_ptr<DatabaseConnection> GetConnection(ConnectionType type, bool preferReplica = false);
     static void ReturnConnection(const std::shared_ptr<DatabaseConnection>& connection);
 
+    // Interactive waiters are always served first. Background waiters only get
+    // a connection when no interactive waiter of the same type is queued and
+    // fewer than PoolLimits::maxBackground background leases are out.
     std::shared_ptr<DatabaseConnection> Acquire(ConnectionType type, bool preferReplica = false);
+    std::shared_ptr<DatabaseConnection> Acquire(ConnectionType type, bool preferReplica, LeasePriority priority);
     void Release(const std::shared_ptr<DatabaseConnection>& connection);
 
     CancellationToken SubmitAsync(ConnectionType type, std::function<void(std::shared_ptr<DatabaseConnection>)> task,
-                                  bool preferReplica = false);
+                                  bool preferReplica = false, CancellationToken token = {});
+
+    // Queues fn on the control worker, which is separate from the query workers
+    // so a cancellation is not stuck behind the queries it should stop.
+    void SubmitControl(std::function<void()> fn);
+    // Stops the statement running on target with KILL QUERY from a side
+    // connection to the same server. Blocks; call it from SubmitControl.
+    bool KillQuery(const DatabaseConnection& target);
+    void RecordInterruptedLease(bool timedOut);
+    void RecordUnboundedLease() { unboundedLeases_.fetch_add(1, std::memory_order_relaxed); }
 
     void StartMaintenance();
     void StopMaintenance();
     void Shutdown();
 
     DiagnosticsSnapshot GetDiagnostics() const;
+    // Starts the interactive/background wait statistics over, for a measurement window.
+    void ResetWaitStats();
 
 private:
+    // Log2 buckets of microseconds; lock-free so Acquire can record outside the pool lock.
+    class WaitHistogram
+    {
+    public:
+        void Record(std::chrono::steady_clock::duration wait);
+        LeaseWaitStats Snapshot() const;
+        void Reset();
+
+    private:
+        // Bucket i counts waits below 2^i microseconds; the last one everything longer.
+        static constexpr std::size_t BucketCount = 28;
+
+        std::array<std::atomic<std::uint64_t>, BucketCount> buckets_{};
+        std::atomic<std::uint64_t> maxMicros_{0};
+    };
+
+    // Waiters of one connection type. Interactive and background waiters sleep
+    // apart so a released connection wakes an interactive waiter whenever there
+    // is one; waiters of the other type are never woken for it.
+    struct TypeAdmission
+    {
+        std::size_t interactiveWaiters = 0;
+        std::size_t backgroundLeased = 0;
+        std::condition_variable interactiveCv;
+        std::condition_variable backgroundCv;
+    };
+
+    // Idle connections validated at once by CheckIdleConnections.
+    static constexpr std::size_t MaxParallelChecks = 4;
 
     void InitializePool(ConnectionType type, const PoolLimits& limits, const MySQLSettings& settings, bool replica);
+    std::shared_ptr<DatabaseConnection> TryGrowPool(ConnectionType type, std::unique_lock<std::mutex>& lock);
     void MaintenanceLoop();
+    void CheckIdleConnections();
+    void RefreshReplicaLag();
+    std::optional<std::uint64_t> QueryReplicaLag(DatabaseConnection& connection) const;
+    bool ReplicaUsableForReads() const;
     bool EnsureConnected(const std::shared_ptr<DatabaseConnection>& connection);
+    bool NeedsValidation(const DatabaseConnection& connection) const;
+    bool IsPooled(const std::shared_ptr<DatabaseConnection>& connection) const;
+    std::queue<std::shared_ptr<DatabaseConnection>>& AvailableQueue(const DatabaseConnection& connection);
+    TypeAdmission& Admission(ConnectionType type) { return type == ConnectionType::Sync ? syncAdmission_ : asyncAdmission_; }
+    bool AdmitsBackground(ConnectionType type) const;
+    void NotifyWaiters(ConnectionType type);
+    void NotifyAllWaiters();
 
     PoolConfig config_;
 
     mutable std::mutex mutex_;
-    std::condition_variable cv_;
+    TypeAdmission syncAdmission_;
+    TypeAdmission asyncAdmission_;
+    WaitHistogram interactiveWait_;
+    WaitHistogram backgroundWait_;
 
     std::vector<std::shared_ptr<DatabaseConnection>> syncConnections_;
     std::vector<std::shared_ptr<DatabaseConnection>> asyncConnections_;
@@ -79,9 +180,31 @@ private:
     std::queue<std::shared_ptr<DatabaseConnection>> availableAsync_;
     std::queue<std::shared_ptr<DatabaseConnection>> availableReplicaSync_;
     std::queue<std::shared_ptr<DatabaseConnection>> availableReplicaAsync_;
+    // Connections that failed a health check; retried by the maintenance thread.
+    std::vector<std::shared_ptr<DatabaseConnection>> brokenConnections_;
+    std::size_t pendingSyncGrowth_ = 0;
+    std::size_t pendingAsyncGrowth_ = 0;
+
+    // Fed by the maintenance thread; replicas lagging past maxAllowedLagSeconds
+    // (or with unknown lag) take no reads.
+    std::atomic<bool> replicaInRotation_{false};
+    std::atomic<std::int64_t> replicaLagSeconds_{-1};
+    // Last time a primary connection that had written came back. Reads stay on
+    // the primary until an in-rotation replica must have caught up.
+    std::atomic<std::chrono::steady_clock::rep> lastPrimaryWrite_{0};
 
     AsyncExecutor asyncExecutor_;
 
+    // Side connections for KILL QUERY, one per server, created on first use.
+    std::mutex controlMutex_;
+    std::shared_ptr<DatabaseConnection> primaryControl_;
+    std::shared_ptr<DatabaseConnection> replicaControl_;
+    AsyncExecutor controlExecutor_{1};
+    std::atomic<std::uint64_t> killedQueries_{0};
+    std::atomic<std::uint64_t> cancelledLeases_{0};
+    std::atomic<std::uint64_t> timedOutLeases_{0};
+    std::atomic<std::uint64_t> unboundedLeases_{0};
+
     std::atomic<bool> maintenanceRunning_;
     std::atomic<bool> stopping_{false};
     std::thread maintenanceThread_;
@@ -1,5 +1,6 @@
 #include "DatabaseConnection.h"
 
+#include <format>
 #include <memory>
 #include <stdexcept>
 #include <string>
@@ -60,7 +61,7 @@ namespace
 } // namespace
 
 DatabaseConnection::DatabaseConnection(const MySQLSettings& settings, ConnectionType type, bool replica)
-    : settings_(settings), type_(type), replica_(replica)
+    : settings_(settings), type_(type), replica_(replica), idleSince_(std::chrono::steady_clock::now().time_since_epoch().count())
 {
 }
 
@@ -96,6 +97,18 @@ bool DatabaseConnection::Connect()
         const auto url = BuildJdbcUrl(effectiveSettings);
         connection_.reset(driver->connect(url, effectiveSettings.username, effectiveSettings.password));
 
+        try
+        {
+            auto statement = CreateStatement();
+            auto result = std::unique_ptr<sql::ResultSet>(statement->executeQuery("SELECT CONNECTION_ID()"));
+            serverThreadId_.store(result && result->next() ? result->getUInt64(1) : 0, std::memory_order_relaxed);
+        }
+        catch (const std::exception& ex)
+        {
+            serverThreadId_.store(0, std::memory_order_relaxed);
+            LOG_WARNING(std::string("Failed to read connection id, queries on it cannot be killed: ") + ex.what());
+        }
+
         if (settings_.ssh.enabled)
             LOG_SQL("Connected to database via SSH tunnel: " + settings_.hostname);
         else
@@ -123,6 +136,8 @@ bool DatabaseConnection::IsConnected() const
 
 void DatabaseConnection::Disconnect()
 {
+    serverThreadId_.store(0, std::memory_order_relaxed);
+
     if (connection_)
     {
         connection_->close();
@@ -156,6 +171,7 @@ bool DatabaseConnection::ExecuteInsert(const std::string& query)
         auto statement = CreateStatement();
         statement->execute(query);
         lastAffectedRows_ = statement->getUpdateCount();
+        hasWritten_ = true;
         return true;
     }
     catch (sql::SQLException& e)
@@ -177,6 +193,7 @@ bool DatabaseConnection::ExecuteUpdate(const std::string& query)
         auto statement = CreateStatement();
         statement->execute(query);
         lastAffectedRows_ = statement->getUpdateCount();
+        hasWritten_ = true;
         return true;
     }
     catch (sql::SQLException& e)
@@ -198,6 +215,7 @@ bool DatabaseConnection::ExecuteDelete(const std::string& query)
         auto statement = CreateStatement();
         statement->execute(query);
         lastAffectedRows_ = statement->getUpdateCount();
+        hasWritten_ = true;
         return true;
     }
     catch (sql::SQLException& e)
@@ -213,12 +231,17 @@ bool DatabaseConnection::ExecuteDelete(const std::string& query)
 }
 
 QueryResult DatabaseConnection::ExecutePreparedSelect(PreparedStatement& statement)
+{
+    return QueryResult(ExecutePreparedSelectRaw(statement));
+}
+
+std::unique_ptr<sql::ResultSet> DatabaseConnection::ExecutePreparedSelectRaw(PreparedStatement& statement)
 {
     try
     {
         auto result = std::unique_ptr<sql::ResultSet>(statement.GetRaw()->executeQuery());
         lastAffectedRows_ = 0;
-        return QueryResult(std::move(result));
+        return result;
     }
     catch (sql::SQLException& ex)
     {
@@ -288,6 +311,7 @@ bool DatabaseConnection::ExecutePreparedInsert(PreparedStatement& statement)
 
         raw->execute();
         lastAffectedRows_ = raw->getUpdateCount();
+        hasWritten_ = true;
         return true;
     }
     catch (const std::exception& ex)
@@ -318,6 +342,7 @@ bool DatabaseConnection::ExecutePreparedUpdate(PreparedStatement& statement)
 
         raw->execute();
         lastAffectedRows_ = raw->getUpdateCount();
+        hasWritten_ = true;
         return true;
     }
     catch (const std::exception& ex)
@@ -348,6 +373,7 @@ std::uint64_t DatabaseConnection::ExecutePreparedDelete(PreparedStatement& state
 
         raw->execute();
         lastAffectedRows_ = raw->getUpdateCount();
+        hasWritten_ = true;
     }
     catch (const std::exception& ex)
     {
@@ -377,6 +403,7 @@ std::uint64_t DatabaseConnection::ExecutePreparedModification(PreparedStatement&
 
         raw->execute();
         lastAffectedRows_ = raw->getUpdateCount();
+        hasWritten_ = true;
     }
     catch (const std::exception& ex)
     {
@@ -474,7 +501,7 @@ sql::PreparedStatement* DatabaseConnection::GetRawPreparedStatement(const std::s
     return raw;
 }
 
-bool DatabaseConnection::TryPrepareStatement(StatementName name, std::string& error)
+bool DatabaseConnection::TryPrepareStatement(StatementName name, std::string& error, std::vector<std::vector<Field>>* plan)
 {
     try
     {
@@ -483,21 +510,48 @@ bool DatabaseConnection::TryPrepareStatement(StatementName name, std::string& er
 
         // Run a lightweight EXPLAIN against the statement to ensure referenced tables
         // actually exist. Some drivers only validate syntax during prepare(), so a
-        // missing table could otherwise go unnoticed.
+        // missing table could otherwise go unnoticed. Placeholders become '1' rather
+        // than NULL: "col = NULL" is an impossible WHERE and would hide the plan.
         try
         {
             std::string explainQuery = "EXPLAIN ";
-            explainQuery.reserve(metadata.query.size() + 8);
+            explainQuery.reserve(metadata.query.size() + 16);
+
+            char quote = 0;
             for (char ch : metadata.query)
             {
-                if (ch == '?')
-                    explainQuery.append("NULL");
-                else
-                    explainQuery.push_back(ch);
+                if (quote)
+                {
+                    if (ch == quote)
+                        quote = 0;
+                }
+                else if (ch == '\'' || ch == '"' || ch == '`')
+                {
+                    quote = ch;
+                }
+                else if (ch == '?')
+                {
+                    explainQuery.append("'1'");
+                    continue;
+                }
+
+                explainQuery.push_back(ch);
             }
 
             auto explain = CreateStatement();
-            explain->execute(explainQuery);
+            std::unique_ptr<sql::ResultSet> rows(explain->executeQuery(explainQuery));
+
+            if (plan && rows)
+            {
+                const auto columns = rows->getMetaData()->getColumnCount();
+                while (rows->next())
+                {
+                    auto& row = plan->emplace_back();
+                    row.reserve(columns);
+                    for (std::size_t i = 0; i < columns; ++i)
+                        row.push_back(FromResultColumn(rows.get(), i));
+                }
+            }
         }
         catch (const std::exception& innerEx)
         {
@@ -525,19 +579,49 @@ bool DatabaseConnection::TryPrepareStatement(StatementName name, std::string& er
 
 bool DatabaseConnection::Ping()
 {
+    if (!connection_)
+        return false;
+
+    // isValid() is a protocol-level ping; no statement or result set round trip.
     try
     {
+        return connection_->isValid();
+    }
+    catch (const std::exception& ex)
+    {
+        LOG_WARNING(std::string("Database ping failed: ") + ex.what());
+        return false;
+    }
+}
+
+bool DatabaseConnection::SetStatementTimeout(std::chrono::milliseconds timeout)
+{
+    try
+    {
+        // max_statement_time is in seconds; 0 means unlimited. std::format ignores the
+        // global locale, std::to_string would write "1,500000" under de_DE.
         auto statement = CreateStatement();
-        statement->execute("SELECT 1");
+        statement->execute(std::format("SET SESSION max_statement_time = {:.3f}", timeout.count() / 1000.0));
         return true;
     }
     catch (const std::exception& ex)
     {
-        LOG_WARNING(std::string("Database ping failed: ") + ex.what());
+        LOG_ERROR(std::string("Failed to set max_statement_time, the query runs without a server-side deadline: ") + ex.what());
         return false;
     }
 }
 
+void DatabaseConnection::MarkIdle()
+{
+    idleSince_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+}
+
+std::chrono::steady_clock::duration DatabaseConnection::IdleTime() const
+{
+    const std::chrono::steady_clock::time_point since{std::chrono::steady_clock::duration(idleSince_.load(std::memory_order_relaxed))};
+    return std::chrono::steady_clock::now() - since;
+}
+
 std::uint64_t DatabaseConnection::GetLastInsertId()
 {
     if (!connection_)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <memory>
 #include <mutex>
@@ -8,6 +9,7 @@
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <mariadb/conncpp.hpp>
@@ -43,6 +45,7 @@ public:
     bool ExecuteDelete(const std::string& query);
 
     QueryResult ExecutePreparedSelect(PreparedStatement& statement);
+    std::unique_ptr<sql::ResultSet> ExecutePreparedSelectRaw(PreparedStatement& statement);
     QueryResult ExecuteAdhocPreparedSelect(const std::string& query, const std::vector<std::string>& params);
     bool ExecutePreparedInsert(PreparedStatement& statement);
     bool ExecutePreparedUpdate(PreparedStatement& statement);
@@ -84,7 +87,10 @@ public:
 
     sql::Connection* GetRawConnection() { return connection_.get(); }
 
-    bool TryPrepareStatement(StatementName name, std::string& error);
+    // Prepares the statement and EXPLAINs it with every placeholder as '1', which
+    // catches missing tables that prepare() alone lets through. With plan set,
+    // the EXPLAIN rows are handed back as well.
+    bool TryPrepareStatement(StatementName name, std::string& error, std::vector<std::vector<Field>>* plan = nullptr);
 
     bool Ping();
     std::uint64_t GetLastInsertId();
@@ -97,6 +103,24 @@ public:
     ConnectionType GetConnectionType() const { return type_; }
     bool IsReplica() const { return replica_; }
 
+    // Set by the pool whenever the connection goes back to the idle queue.
+    void MarkIdle();
+    std::chrono::steady_clock::duration IdleTime() const;
+
+    // True once if something was written since the last call; the pool uses it
+    // to keep this session's reads on the primary until replicas catch up.
+    bool TakeWriteMark() { return std::exchange(hasWritten_, false); }
+
+    // Server thread id (CONNECTION_ID()) of the current session, target of KILL QUERY. 0 if unknown.
+    std::uint64_t GetServerThreadId() const { return serverThreadId_.load(std::memory_order_relaxed); }
+
+    // Sets max_statement_time for the session; zero removes the limit.
+    bool SetStatementTimeout(std::chrono::milliseconds timeout);
+
+    // Priority of the current lease; set by the pool on Acquire.
+    LeasePriority GetLeasePriority() const { return leasePriority_; }
+    void SetLeasePriority(LeasePriority priority) { leasePriority_ = priority; }
+
 private:
     std::unique_ptr<sql::Statement> CreateStatement();
     StatementMetadata LookupMetadata(StatementName name);
@@ -111,6 +135,10 @@ private:
     std::unique_ptr<sql::Connection> connection_;
 
     std::uint64_t lastAffectedRows_ = 0;
+    std::atomic<std::chrono::steady_clock::rep> idleSince_;
+    bool hasWritten_ = false;
+    std::atomic<std::uint64_t> serverThreadId_{0};
+    LeasePriority leasePriority_ = LeasePriority::Interactive;
 
     mutable std::mutex preparedMutex_;
     std::unordered_map<StatementName, PreparedStatementSharedPtr> sharedByName_;
@@ -35,8 +35,14 @@ DiagnosticsSnapshot DatabaseManager::GetDiagnostics() const
     return pool_.GetDiagnostics();
 }
 
+void DatabaseManager::ResetWaitStats()
+{
+    pool_.ResetWaitStats();
+}
+
 void DatabaseManager::Shutdown()
 {
+    DeadlineTimer::Instance().Stop();
     pool_.Shutdown();
 }
 
@@ -2,11 +2,14 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 
 #include "ConnectionPool.h"
 #include "DatabaseConnection.h"
+#include "DeadlineTimer.h"
 #include "PreparedStatementRegistry.h"
+#include "QueryFuture.h"
 
 namespace database
 {
@@ -28,12 +31,80 @@ public:
     void ReturnConnection(const std::shared_ptr<DatabaseConnection>& connection);
     CancellationToken ExecuteAsync(ConnectionType type, std::function<void(std::shared_ptr<DatabaseConnection>)> task, bool preferReplica = false);
 
+    // Runs fn(DatabaseConnection&) on a pooled connection from a worker thread and
+    // returns a future of its result. Independent calls lease separate
+    // connections and run concurrently; join them with WhenAll().
+    template <typename Fn>
+    auto QueryAsync(ConnectionType type, Fn fn, AsyncQueryOptions options = {})
+        -> QueryFuture<std::invoke_result_t<Fn&, DatabaseConnection&>>
+    {
+        using Result = std::invoke_result_t<Fn&, DatabaseConnection&>;
+        static_assert(!std::is_void_v<Result>, "QueryAsync callbacks must return a value");
+
+        auto state = std::make_shared<detail::QueryState<Result>>(options.timeout);
+        auto guard = std::make_shared<detail::CompletionGuard<Result>>(state);
+
+        if (state->Deadline())
+        {
+            DeadlineTimer::Instance().Schedule(*state->Deadline(),
+                [weak = std::weak_ptr<detail::QueryState<Result>>(state)]()
+                {
+                    if (auto locked = weak.lock())
+                        locked->Expire();
+                });
+        }
+
+        pool_.SubmitAsync(
+            type,
+            [this, guard, fn = std::move(fn)](std::shared_ptr<DatabaseConnection> connection) mutable
+            { RunLeased(guard->State(), connection, fn); },
+            options.preferReplica && config_.useReplicaForReads, state->Token());
+
+        return QueryFuture<Result>(std::move(state));
+    }
+
     DiagnosticsSnapshot GetDiagnostics() const;
+    void ResetWaitStats();
     void Shutdown();
 
 private:
     DatabaseManager() = default;
 
+    // Runs fn on a leased connection with the query's deadline enforced by the
+    // server (max_statement_time) and Cancel() wired to KILL QUERY.
+    template <typename Result, typename Fn>
+    void RunLeased(const std::shared_ptr<detail::QueryState<Result>>& shared, const std::shared_ptr<DatabaseConnection>& connection, Fn& fn)
+    {
+        auto& state = *shared;
+        std::weak_ptr<detail::QueryState<Result>> weak = shared;
+
+        const auto remaining = state.Remaining();
+        const bool limited = remaining.count() > 0 && connection->SetStatementTimeout(remaining);
+        if (remaining.count() > 0 && !limited)
+            pool_.RecordUnboundedLease();
+
+        state.ArmInterrupt(
+            [this, weak, connection]()
+            {
+                pool_.SubmitControl(
+                    [this, weak, connection]()
+                    {
+                        if (auto locked = weak.lock())
+                            locked->RunIfArmed([&]() { pool_.KillQuery(*connection); });
+                    });
+            });
+
+        state.Run(fn, *connection);
+        state.DisarmInterrupt();
+
+        if (limited)
+            connection->SetStatementTimeout(std::chrono::milliseconds(0));
+
+        const auto status = state.Outcome().status;
+        if (status == QueryStatus::Cancelled || status == QueryStatus::TimedOut)
+            pool_.RecordInterruptedLease(status == QueryStatus::TimedOut);
+    }
+
     template <typename Tag>
     friend class detail::NamedDatabase;
 
@@ -0,0 +1,305 @@
+#include "DatabaseSelfCheck.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <format>
+#include <iomanip>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QByteArray>
+#include <QtGlobal>
+
+#include "ConnectionGuard.h"
+#include "ConnectionPool.h"
+#include "Field.h"
+
+namespace database
+{
+namespace
+{
+    constexpr std::size_t DateTimeSamples = 200'000;
+    constexpr std::uint32_t DateTimeSeed = 20261018;
+
+    struct DateTimeSample
+    {
+        std::tm civil{};
+        std::uint32_t microsecond = 0;
+    };
+
+    // The decoder before it was rewritten, except for tm_isdst: the old code passed
+    // 0 and put summer timestamps an hour off, which the rewrite fixed on purpose.
+    std::optional<SystemTimePoint> ParseWithIostreams(const std::string& value)
+    {
+        std::tm timeInfo{};
+        std::istringstream stream(value);
+        stream >> std::get_time(&timeInfo, "%Y-%m-%d %H:%M:%S");
+        if (stream.fail())
+            return std::nullopt;
+
+        timeInfo.tm_isdst = -1;
+        auto timestamp = std::mktime(&timeInfo);
+        if (timestamp == -1)
+            return std::nullopt;
+
+        return std::chrono::system_clock::from_time_t(timestamp);
+    }
+
+    std::string FormatText(const std::tm& civil)
+    {
+        return std::format("{:04}-{:02}-{:02} {:02}:{:02}:{:02}", civil.tm_year + 1900, civil.tm_mon + 1, civil.tm_mday, civil.tm_hour, civil.tm_min,
+                           civil.tm_sec);
+    }
+
+    // Length byte 7 (no fraction) or 11, as in DecodeBinary.
+    std::string PackBinary(const DateTimeSample& sample, bool withFraction)
+    {
+        const auto year = static_cast<unsigned>(sample.civil.tm_year + 1900);
+
+        std::string packed;
+        packed.push_back(static_cast<char>(withFraction ? 11 : 7));
+        packed.push_back(static_cast<char>(year & 0xFF));
+        packed.push_back(static_cast<char>(year >> 8));
+        packed.push_back(static_cast<char>(sample.civil.tm_mon + 1));
+        packed.push_back(static_cast<char>(sample.civil.tm_mday));
+        packed.push_back(static_cast<char>(sample.civil.tm_hour));
+        packed.push_back(static_cast<char>(sample.civil.tm_min));
+        packed.push_back(static_cast<char>(sample.civil.tm_sec));
+
+        if (withFraction)
+        {
+            for (int shift = 0; shift < 32; shift += 8)
+                packed.push_back(static_cast<char>((sample.microsecond >> shift) & 0xFF));
+        }
+
+        return packed;
+    }
+
+    std::vector<DateTimeSample> MakeDateTimeSamples()
+    {
+        std::mt19937 random(DateTimeSeed);
+        std::uniform_int_distribution<int> year(1971, 2037);
+        std::uniform_int_distribution<int> month(0, 11);
+        std::uniform_int_distribution<int> day(1, 28);
+        std::uniform_int_distribution<int> hour(0, 23);
+        std::uniform_int_distribution<int> minuteOrSecond(0, 59);
+        std::uniform_int_distribution<std::uint32_t> microsecond(0, 999'999);
+
+        std::vector<DateTimeSample> samples(DateTimeSamples);
+        for (auto& sample : samples)
+        {
+            sample.civil.tm_year = year(random) - 1900;
+            sample.civil.tm_mon = month(random);
+            sample.civil.tm_mday = day(random);
+            sample.civil.tm_hour = hour(random);
+            sample.civil.tm_min = minuteOrSecond(random);
+            sample.civil.tm_sec = minuteOrSecond(random);
+            sample.microsecond = microsecond(random);
+        }
+
+        return samples;
+    }
+
+    // More workers than PoolLimits::maxBackground and the pool size, so background
+    // waiters are always queued while the interactive leases are taken.
+    constexpr std::size_t BackgroundWorkers = 16;
+    constexpr auto LoadDuration = std::chrono::seconds(5);
+    constexpr auto InteractivePause = std::chrono::milliseconds(20);
+    constexpr double InteractiveP99BudgetMs = 50.0;
+
+    std::int64_t ElapsedMs(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    }
+} // namespace
+
+bool DatabaseSelfCheck::IsEnabled()
+{
+    const QByteArray value = qgetenv("AMS_SELF_CHECK").trimmed().toLower();
+    return value == "1" || value == "true" || value == "yes" || value == "on";
+}
+
+void DatabaseSelfCheck::RunAll()
+{
+    const bool dateTime = VerifyDateTimeDecoding();
+    const bool leases = VerifyInteractiveLeaseLatency();
+
+    if (dateTime && leases)
+        LOG_DEBUG("Database self check passed");
+    else
+        LOG_ERROR("Database self check failed, see the messages above");
+}
+
+bool DatabaseSelfCheck::VerifyDateTimeDecoding()
+{
+    const auto samples = MakeDateTimeSamples();
+
+    std::vector<std::string> text;
+    text.reserve(samples.size());
+    for (const auto& sample : samples)
+        text.push_back(FormatText(sample.civil));
+
+    std::size_t mismatches = 0;
+    auto expect = [&mismatches](const char* form, const std::string& input, const std::optional<SystemTimePoint>& actual,
+                                const std::optional<SystemTimePoint>& expected)
+    {
+        if (actual == expected)
+            return;
+
+        if (++mismatches <= 10)
+        {
+            LOG_ERROR("Datetime decoding differs for {} '{}': {} vs. {}", form, input,
+                      actual ? std::to_string(actual->time_since_epoch().count()) : std::string("none"),
+                      expected ? std::to_string(expected->time_since_epoch().count()) : std::string("none"));
+        }
+    };
+
+    for (std::size_t i = 0; i < samples.size(); ++i)
+    {
+        const auto expected = ParseWithIostreams(text[i]);
+        const auto fraction = std::chrono::microseconds{samples[i].microsecond};
+        const auto expectedWithFraction = expected ? std::optional<SystemTimePoint>(*expected + fraction) : std::nullopt;
+
+        expect("text", text[i], ParseDateTimeString(text[i]), expected);
+
+        const std::string fractional = std::format("{}.{:06}", text[i], samples[i].microsecond);
+        expect("text", fractional, ParseDateTimeString(fractional), expectedWithFraction);
+
+        expect("binary", text[i], ParseDateTimeString(PackBinary(samples[i], false)), expected);
+        expect("binary", fractional, ParseDateTimeString(PackBinary(samples[i], true)), expectedWithFraction);
+    }
+
+    // Values the decoder has to refuse, whatever the old path made of them.
+    for (const std::string rejected : {"0000-00-00 00:00:00", "2026-13-01 00:00:00", "2026-10-18 25:00:00", "2026-10-18 10:00", "18.10.2026", ""})
+        expect("text", rejected, ParseDateTimeString(rejected), std::nullopt);
+    expect("binary", "zero date", ParseDateTimeString(std::string(1, '\0')), std::nullopt);
+
+    // Same inputs for both; the checksum keeps the loops from being optimized away.
+    std::int64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& value : text)
+    {
+        if (auto parsed = ParseWithIostreams(value))
+            checksum += parsed->time_since_epoch().count();
+    }
+    const auto oldMs = ElapsedMs(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& value : text)
+    {
+        if (auto parsed = ParseDateTimeString(value))
+            checksum -= parsed->time_since_epoch().count();
+    }
+    const auto newMs = ElapsedMs(start);
+
+    LOG_DEBUG("Datetime decoding: {} values x 4 forms, {} mismatch(es) | {} text decodes: iostreams {} ms, decoder {} ms (checksum {})", samples.size(),
+              mismatches, samples.size(), oldMs, newMs, checksum);
+
+    return mismatches == 0 && checksum == 0;
+}
+
+bool DatabaseSelfCheck::VerifyInteractiveLeaseLatency()
+{
+    AMSDatabase::ResetWaitStats();
+
+    std::atomic_bool running{true};
+    std::atomic_uint64_t backgroundQueries{0};
+
+    std::vector<std::thread> workers;
+    workers.reserve(BackgroundWorkers);
+    for (std::size_t i = 0; i < BackgroundWorkers; ++i)
+    {
+        workers.emplace_back(
+            [&running, &backgroundQueries]
+            {
+                LeasePriorityScope background(LeasePriority::Background);
+                while (running.load())
+                {
+                    try
+                    {
+                        ConnectionGuardAMS conn(ConnectionType::Sync, /*preferReplica*/ false, "SelfCheckBackground", std::chrono::seconds(10));
+                        if (!conn)
+                            continue;
+
+                        conn->ExecuteAdhocPreparedSelect("SELECT SLEEP(0.05)", {});
+                        backgroundQueries.fetch_add(1, std::memory_order_relaxed);
+                    }
+                    catch (const std::exception& ex)
+                    {
+                        LOG_WARNING("Background load query failed: {}", ex.what());
+                    }
+                }
+            });
+    }
+
+    std::size_t interactiveQueries = 0;
+    std::size_t interactiveFailures = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (std::chrono::steady_clock::now() - start < LoadDuration)
+    {
+        std::this_thread::sleep_for(InteractivePause);
+
+        try
+        {
+            ConnectionGuardAMS conn(ConnectionType::Sync, /*preferReplica*/ false, "SelfCheckInteractive");
+            if (!conn)
+            {
+                ++interactiveFailures;
+                continue;
+            }
+
+            conn->ExecuteAdhocPreparedSelect("SELECT 1", {});
+            ++interactiveQueries;
+        }
+        catch (const std::exception& ex)
+        {
+            ++interactiveFailures;
+            LOG_WARNING("Interactive query under background load failed: {}", ex.what());
+        }
+    }
+
+    const auto diagnostics = AMSDatabase::GetDiagnostics();
+
+    running.store(false);
+    for (auto& worker : workers)
+        worker.join();
+
+    const auto& interactive = diagnostics.interactiveWait;
+    const auto& background = diagnostics.backgroundWait;
+
+    LOG_DEBUG("Lease waits under {} background workers ({} queries, {} leased at the end): interactive {} leases p50 {} ms p99 {} ms max {} ms | "
+              "background {} leases p50 {} ms p99 {} ms max {} ms",
+              BackgroundWorkers, backgroundQueries.load(), diagnostics.backgroundLeased, interactive.leases, interactive.p50Ms, interactive.p99Ms,
+              interactive.maxMs, background.leases, background.p50Ms, background.p99Ms, background.maxMs);
+
+    bool ok = true;
+    if (interactiveFailures > 0 || interactive.leases < interactiveQueries)
+    {
+        LOG_ERROR("{} interactive lease(s) failed under background load, {} recorded for {} queries", interactiveFailures, interactive.leases,
+                  interactiveQueries);
+        ok = false;
+    }
+
+    if (backgroundQueries.load() == 0 || diagnostics.backgroundLeased == 0)
+    {
+        LOG_ERROR("Background load did not reach the pool; the interactive wait was not measured under load");
+        ok = false;
+    }
+
+    if (interactive.p99Ms > InteractiveP99BudgetMs)
+    {
+        LOG_ERROR("Interactive p99 lease wait {} ms exceeds {} ms under background load", interactive.p99Ms, InteractiveP99BudgetMs);
+        ok = false;
+    }
+
+    return ok;
+}
+
+} // namespace database
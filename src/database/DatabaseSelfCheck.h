@@ -0,0 +1,24 @@
+#pragma once
+
+namespace database
+{
+    class DatabaseSelfCheck
+    {
+       public:
+        // Debug builds run these after statement validation when AMS_SELF_CHECK is
+        // set; the results and timings go to the log.
+        static bool IsEnabled();
+        static void RunAll();
+
+        // Decodes fixed pseudo-random DATETIME values as text and as packed binary
+        // with ParseDateTimeString and compares each against the istringstream,
+        // get_time and mktime path it replaced, then times both on the text inputs.
+        static bool VerifyDateTimeDecoding();
+
+        // Keeps more background workers than the AMS sync pool admits busy with
+        // short queries while this thread takes interactive leases, then checks the
+        // interactive p99 acquire wait from GetDiagnostics() against a budget.
+        // Resets the pool's wait statistics first.
+        static bool VerifyInteractiveLeaseLatency();
+    };
+}  // namespace database
@@ -17,6 +17,14 @@ enum class ConnectionType
     Async
 };
 
+// Who is waiting for a pooled connection. Interactive leases (the GUI thread,
+// user actions) are served before background work such as timer refreshes.
+enum class LeasePriority : std::uint8_t
+{
+    Interactive,
+    Background
+};
+
 enum class StatementConnectionType
 {
     Sync,
@@ -37,11 +37,22 @@ namespace detail
             return Instance().ExecuteAsync(type, std::move(task), preferReplica);
         }
 
+        template <typename Fn>
+        static auto QueryAsync(ConnectionType type, Fn fn, AsyncQueryOptions options = {})
+        {
+            return Instance().QueryAsync(type, std::move(fn), options);
+        }
+
         static DiagnosticsSnapshot GetDiagnostics()
         {
             return Instance().GetDiagnostics();
         }
 
+        static void ResetWaitStats()
+        {
+            Instance().ResetWaitStats();
+        }
+
         static void Shutdown()
         {
             Instance().Shutdown();
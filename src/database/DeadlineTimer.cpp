@@ -0,0 +1,86 @@
+#include "DeadlineTimer.h"
+
+#include <exception>
+#include <string>
+
+#include "Logger.h"
+
+namespace database
+{
+
+DeadlineTimer& DeadlineTimer::Instance()
+{
+    static DeadlineTimer instance;
+    return instance;
+}
+
+DeadlineTimer::~DeadlineTimer()
+{
+    Stop();
+}
+
+void DeadlineTimer::Schedule(Clock::time_point when, std::function<void()> fn)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (stopping_)
+        return;
+
+    // Started on first use, most sessions never set a timeout.
+    if (!thread_.joinable())
+        thread_ = std::thread(&DeadlineTimer::Run, this);
+
+    const bool earliest = entries_.empty() || when < entries_.top().when;
+    entries_.push({when, std::move(fn)});
+
+    if (earliest)
+        cv_.notify_one();
+}
+
+void DeadlineTimer::Stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        entries_ = {};
+    }
+
+    cv_.notify_all();
+    if (thread_.joinable())
+        thread_.join();
+}
+
+void DeadlineTimer::Run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stopping_)
+    {
+        if (entries_.empty())
+        {
+            cv_.wait(lock);
+            continue;
+        }
+
+        const auto when = entries_.top().when;
+        if (Clock::now() < when)
+        {
+            cv_.wait_until(lock, when);
+            continue;
+        }
+
+        auto fn = std::move(const_cast<Entry&>(entries_.top()).fn);
+        entries_.pop();
+
+        lock.unlock();
+        try
+        {
+            fn();
+        }
+        catch (const std::exception& ex)
+        {
+            LOG_ERROR(std::string("DeadlineTimer callback failed: ") + ex.what());
+        }
+        lock.lock();
+    }
+}
+
+} // namespace database
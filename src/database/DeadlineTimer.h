@@ -0,0 +1,54 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace database
+{
+
+// Fires callbacks at their deadline from one background thread. QueryAsync
+// uses it to resolve a query as TimedOut (and kill it on the server) while it
+// is still running, instead of only noticing the deadline when it returns.
+class DeadlineTimer
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static DeadlineTimer& Instance();
+
+    ~DeadlineTimer();
+
+    DeadlineTimer(const DeadlineTimer&) = delete;
+    DeadlineTimer& operator=(const DeadlineTimer&) = delete;
+
+    // fn runs on the timer thread and must not block; it should hold only weak
+    // references, entries are not removed before they are due.
+    void Schedule(Clock::time_point when, std::function<void()> fn);
+    void Stop();
+
+private:
+    DeadlineTimer() = default;
+
+    void Run();
+
+    struct Entry
+    {
+        Clock::time_point when;
+        std::function<void()> fn;
+
+        bool operator>(const Entry& other) const { return when > other.when; }
+    };
+
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> entries_;
+    std::thread thread_;
+    bool stopping_ = false;
+};
+
+} // namespace database
@@ -1,5 +1,7 @@
 #include "Field.h"
 
+#include "BlobStream.h"
+
 #include <limits>
 #include <iterator>
 #include <memory>
@@ -9,8 +11,8 @@
 #include <utility>
 #include <variant>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <array>
+#include <ctime>
 #include <vector>
 #include <cstring>
 
@@ -29,26 +31,10 @@ std::string SqlStringToStdString(const sql::SQLString& sqlString)
 
 std::string ReadStream(std::unique_ptr<std::istream> stream)
 {
-    if (!stream)
-        return {};
-
-    return std::string(std::istreambuf_iterator<char>(*stream), std::istreambuf_iterator<char>());
-}
-
-std::optional<SystemTimePoint> ParseDateTimeString(const std::string& value)
-{
-    std::tm timeInfo{};
-    std::istringstream stream(value);
-    stream >> std::get_time(&timeInfo, "%Y-%m-%d %H:%M:%S");
-
-    if (stream.fail())
-        return std::nullopt;
-
-    auto timestamp = std::mktime(&timeInfo);
-    if (timestamp == -1)
-        return std::nullopt;
-
-    return std::chrono::system_clock::from_time_t(timestamp);
+    std::string value;
+    if (stream)
+        ReadBlobStream(*stream, value);
+    return value;
 }
 
 template <typename T>
@@ -374,6 +360,15 @@ const std::string& Field::GetBinary() const
     return GetString();
 }
 
+std::span<const std::uint8_t> Field::GetBinaryView() const
+{
+    if (IsNull())
+        return {};
+
+    const std::string& data = GetBinary();
+    return {reinterpret_cast<const std::uint8_t*>(data.data()), data.size()};
+}
+
 SystemTimePoint Field::GetDateTime() const
 {
     return std::visit(
@@ -468,6 +463,210 @@ QString Field::GetQString() const
     return QString::fromStdString(std::get<std::string>(value_));
 }
 
+namespace
+{
+
+struct CivilDateTime
+{
+    int year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    unsigned hour = 0;
+    unsigned minute = 0;
+    unsigned second = 0;
+    std::uint32_t microsecond = 0;
+};
+
+bool ReadDigits(std::string_view text, std::size_t pos, std::size_t count, unsigned& out)
+{
+    if (pos + count > text.size())
+        return false;
+
+    unsigned value = 0;
+    for (std::size_t i = pos; i < pos + count; ++i)
+    {
+        const unsigned digit = static_cast<unsigned char>(text[i]) - '0';
+        if (digit > 9)
+            return false;
+        value = value * 10 + digit;
+    }
+
+    out = value;
+    return true;
+}
+
+// "YYYY-MM-DD", "YYYY-MM-DD HH:MM:SS" or "YYYY-MM-DD HH:MM:SS.ffffff", as
+// the server sends DATE, DATETIME and TIMESTAMP columns in the text protocol.
+bool DecodeText(std::string_view text, CivilDateTime& out)
+{
+    unsigned year = 0;
+    if (!ReadDigits(text, 0, 4, year) || text.size() < 10 || text[4] != '-' || text[7] != '-' || !ReadDigits(text, 5, 2, out.month) ||
+        !ReadDigits(text, 8, 2, out.day))
+        return false;
+
+    out.year = static_cast<int>(year);
+
+    if (text.size() == 10)
+        return true;
+
+    if (text.size() < 19 || (text[10] != ' ' && text[10] != 'T') || text[13] != ':' || text[16] != ':' || !ReadDigits(text, 11, 2, out.hour) ||
+        !ReadDigits(text, 14, 2, out.minute) || !ReadDigits(text, 17, 2, out.second))
+        return false;
+
+    if (text.size() == 19)
+        return true;
+
+    // Fraction of up to six digits, scaled to microseconds.
+    const std::size_t digits = text.size() - 20;
+    if (text[19] != '.' || digits == 0 || digits > 6)
+        return false;
+
+    unsigned fraction = 0;
+    if (!ReadDigits(text, 20, digits, fraction))
+        return false;
+
+    for (std::size_t i = digits; i < 6; ++i)
+        fraction *= 10;
+
+    out.microsecond = fraction;
+    return true;
+}
+
+// MYSQL_TIME as packed by the binary protocol: a length byte (0, 4, 7 or 11)
+// followed by year (2 bytes, little endian), month, day, hour, minute, second
+// and microseconds (4 bytes, little endian), trailing zero parts omitted.
+bool DecodeBinary(std::string_view data, CivilDateTime& out)
+{
+    if (data.empty())
+        return false;
+
+    const auto byte = [&data](std::size_t i) { return static_cast<unsigned>(static_cast<unsigned char>(data[i])); };
+
+    const std::size_t length = byte(0);
+    if (data.size() != length + 1 || (length != 0 && length != 4 && length != 7 && length != 11))
+        return false;
+
+    if (length == 0)
+        return false;  // zero date
+
+    out.year = static_cast<int>(byte(1) | (byte(2) << 8));
+    out.month = byte(3);
+    out.day = byte(4);
+
+    if (length >= 7)
+    {
+        out.hour = byte(5);
+        out.minute = byte(6);
+        out.second = byte(7);
+    }
+
+    if (length == 11)
+        out.microsecond = byte(8) | (byte(9) << 8) | (byte(10) << 16) | (byte(11) << 24);
+
+    return true;
+}
+
+bool IsValid(const CivilDateTime& value)
+{
+    // Rejects the zero date MariaDB uses for "no value", like the old mktime path did.
+    return value.year > 0 && value.month >= 1 && value.month <= 12 && value.day >= 1 && value.day <= 31 && value.hour < 24 && value.minute < 60 &&
+           value.second < 61 && value.microsecond < 1'000'000;
+}
+
+// Days since 1970-01-01 in the proleptic Gregorian calendar (H. Hinnant's days_from_civil).
+std::int64_t DaysFromCivil(int year, unsigned month, unsigned day)
+{
+    year -= month <= 2 ? 1 : 0;
+    const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+    const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+}
+
+// Offset between local wall clock and UTC for the local hour containing
+// localSeconds. mktime does a timezone lookup per call, so results are kept
+// per hour in a small per-thread table; a refresh decodes many timestamps
+// from the same few hours and days.
+std::optional<std::int64_t> LocalOffsetSeconds(std::int64_t localSeconds)
+{
+    struct Slot
+    {
+        std::int64_t hour = std::numeric_limits<std::int64_t>::min();
+        std::int64_t offset = 0;
+    };
+
+    constexpr std::size_t SlotCount = 256;
+    thread_local std::array<Slot, SlotCount> slots{};
+
+    const std::int64_t hour = localSeconds >= 0 ? localSeconds / 3600 : (localSeconds - 3599) / 3600;
+    Slot& slot = slots[static_cast<std::size_t>(hour) % SlotCount];
+    if (slot.hour == hour)
+        return slot.offset;
+
+    const std::int64_t hourStart = hour * 3600;
+    std::int64_t days = hourStart >= 0 ? hourStart / 86400 : (hourStart - 86399) / 86400;
+    const auto secondOfDay = static_cast<int>(hourStart - days * 86400);
+
+    // civil_from_days, to hand mktime the local hour it has to resolve
+    days += 719468;
+    const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+    const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const unsigned mp = (5 * dayOfYear + 2) / 153;
+    const unsigned day = dayOfYear - (153 * mp + 2) / 5 + 1;
+    const unsigned month = mp < 10 ? mp + 3 : mp - 9;
+    const auto year = static_cast<std::int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+
+    std::tm timeInfo{};
+    timeInfo.tm_year = static_cast<int>(year - 1900);
+    timeInfo.tm_mon = static_cast<int>(month - 1);
+    timeInfo.tm_mday = static_cast<int>(day);
+    timeInfo.tm_hour = secondOfDay / 3600;
+    timeInfo.tm_isdst = -1;
+
+    const std::time_t utc = std::mktime(&timeInfo);
+    if (utc == static_cast<std::time_t>(-1))
+        return std::nullopt;
+
+    slot.hour = hour;
+    slot.offset = hourStart - static_cast<std::int64_t>(utc);
+    return slot.offset;
+}
+
+} // namespace
+
+std::optional<SystemTimePoint> ReadDateTimeColumn(sql::ResultSet& result, std::int32_t column)
+{
+    if (result.isNull(column))
+        return std::nullopt;
+
+    const sql::SQLString value = result.getString(column);
+    auto parsed = ParseDateTimeString(std::string_view(value.c_str(), value.length()));
+    if (!parsed)
+        LOG_WARNING("Column {} does not contain a parseable datetime value: '{}'", column, std::string(value.c_str(), value.length()));
+
+    return parsed;
+}
+
+std::optional<SystemTimePoint> ParseDateTimeString(std::string_view value)
+{
+    CivilDateTime civil;
+    const bool decoded = !value.empty() && static_cast<unsigned char>(value.front()) <= 11 ? DecodeBinary(value, civil) : DecodeText(value, civil);
+    if (!decoded || !IsValid(civil))
+        return std::nullopt;
+
+    const std::int64_t localSeconds = DaysFromCivil(civil.year, civil.month, civil.day) * 86400 + civil.hour * 3600 + civil.minute * 60 + civil.second;
+
+    const auto offset = LocalOffsetSeconds(localSeconds);
+    if (!offset)
+        return std::nullopt;
+
+    return SystemTimePoint{std::chrono::duration_cast<SystemTimePoint::duration>(std::chrono::seconds{localSeconds - *offset} +
+                                                                                 std::chrono::microseconds{civil.microsecond})};
+}
+
 Field FromResultColumn(sql::ResultSet* result, std::size_t index)
 {
     if (!result)
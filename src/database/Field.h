@@ -3,7 +3,9 @@
 #include <cstdint>
 #include <mariadb/conncpp.hpp>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
 
@@ -56,6 +58,8 @@ public:
     const std::string& GetString() const;
     const std::string& GetBlob() const;
     const std::string& GetBinary() const;
+    // View of the stored bytes; valid as long as this Field is.
+    std::span<const std::uint8_t> GetBinaryView() const;
 
     std::vector<std::uint8_t> GetBinaryVectorUInt8() const;
     std::vector<std::uint16_t> GetBinaryVectorUInt16() const;
@@ -76,5 +80,14 @@ private:
 
 Field FromResultColumn(sql::ResultSet* result, std::size_t index);
 
+// Parses a DATE/DATETIME column value as local time. Accepts the text form
+// ("YYYY-MM-DD[ HH:MM:SS[.ffffff]]") and the packed binary-protocol form.
+// Does not allocate; returns nullopt for the zero date and malformed input.
+std::optional<SystemTimePoint> ParseDateTimeString(std::string_view value);
+
+// Reads a DATE/DATETIME column of a result set. NULL yields nullopt; a value
+// that does not parse is logged with its column and also yields nullopt.
+std::optional<SystemTimePoint> ReadDateTimeColumn(sql::ResultSet& result, std::int32_t column);
+
 } // namespace database
 
@@ -18,7 +18,7 @@ void RegisterAMSPreparedStatements()
     CONNECTION_SYNC);
 
     PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_SELECT_ALL_TICKETS, "SELECT creator_user_id, created_at, current_status, cost_unit_id, area, reporter_id, entity_id, "
-    "title, description, priority, updated_at, closed_at, last_status_change_at FROM tickets WHERE ID = ?", CONNECTION_SYNC);
+    "title, description, priority, updated_at, closed_at, last_status_change_at, row_version FROM tickets WHERE ID = ?", CONNECTION_SYNC);
 
 PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT,
           "SELECT "
@@ -36,33 +36,14 @@ PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT,
           "ep.firstName     AS employee_first_name, "
           "ep.lastName      AS employee_last_name, "
           "ep.phone         AS employee_phone, "
-          "tc_latest.message AS latest_comment_message "
+          "s.latest_comment_message AS latest_comment_message "
           "FROM tickets t "
           "LEFT JOIN caller_information ci ON ci.ID = t.reporter_id "
           "LEFT JOIN machine_list ml       ON ml.ID = t.entity_id "
           "LEFT JOIN ticket_assignment ta  ON ta.ticket_id = t.ID AND ta.is_current = 1 "
           "LEFT JOIN employees ep          ON ep.ID = ta.employee_id "
-          "LEFT JOIN ("
-          "SELECT tc.ticket_id, tc.message "
-          "FROM ticket_comments tc "
-          "INNER JOIN ("
-          "SELECT ticket_id, MAX(COALESCE(updated_at, created_at)) AS max_last_at "
-          "FROM ticket_comments "
-          "WHERE is_deleted = 0 "
-          "GROUP BY ticket_id"
-          ") x ON x.ticket_id = tc.ticket_id "
-          "AND x.max_last_at = COALESCE(tc.updated_at, tc.created_at) "
-          "INNER JOIN ("
-          "SELECT ticket_id, COALESCE(updated_at, created_at) AS last_at, MAX(id) AS max_id "
-          "FROM ticket_comments "
-          "WHERE is_deleted = 0 "
-          "GROUP BY ticket_id, COALESCE(updated_at, created_at)"
-          ") y ON y.ticket_id = tc.ticket_id "
-          "AND y.last_at = COALESCE(tc.updated_at, tc.created_at) "
-          "AND y.max_id = tc.id "
-          "WHERE tc.is_deleted = 0"
-          ") tc_latest ON tc_latest.ticket_id = t.ID "
-          "WHERE t.is_deleted = 0 AND t.current_status != 7; ", CONNECTION_SYNC);
+          "LEFT JOIN ticket_overview_summary s ON s.ticket_id = t.ID "
+          "WHERE t.is_deleted = 0 AND t.current_status NOT IN (?, ?); ", CONNECTION_SYNC);
 
 
     PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT_SINCE,
@@ -80,14 +61,20 @@ PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT,
           "ml.MachineName   AS machine_name, "
           "ep.firstName     AS employee_first_name, "
           "ep.lastName      AS employee_last_name, "
-          "ep.phone         AS employee_phone "
-          "FROM tickets t "
+          "ep.phone         AS employee_phone, "
+          "s.latest_comment_message AS latest_comment_message "
+          "FROM ("
+          "SELECT ID FROM tickets WHERE updated_at > ? "
+          "UNION "
+          "SELECT ticket_id FROM ticket_overview_summary WHERE last_activity_at > ?"
+          ") changed "
+          "INNER JOIN tickets t            ON t.ID = changed.ID "
           "LEFT JOIN caller_information ci ON ci.ID = t.reporter_id "
           "LEFT JOIN machine_list ml       ON ml.ID = t.entity_id "
           "LEFT JOIN ticket_assignment ta  ON ta.ticket_id = t.ID AND ta.is_current = 1 "
           "LEFT JOIN employees ep          ON ep.ID = ta.employee_id "
-          "WHERE t.is_deleted = 0 "
-          "AND t.updated_at > ?; ",
+          "LEFT JOIN ticket_overview_summary s ON s.ticket_id = t.ID "
+          "WHERE t.is_deleted = 0; ",
           CONNECTION_SYNC);
 
     PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT_REMOVED_SINCE,
@@ -101,11 +88,49 @@ PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT,
     PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT_LAST_COMMENT_BY_ID, "SELECT message FROM ticket_comments WHERE ticket_id = ? AND is_deleted = 0 "
     "ORDER BY COALESCE(updated_at, created_at) DESC, id DESC LIMIT 1", CONNECTION_SYNC);
 
-    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_STATUS_BY_ID, "UPDATE tickets SET current_status = ? WHERE ID = ?", CONNECTION_ASYNC);
-    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_PRIORITY_BY_ID, "UPDATE tickets SET priority = ? WHERE ID = ?", CONNECTION_ASYNC);
-    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_TITLE_BY_ID, "UPDATE tickets SET title = ? WHERE ID = ?", CONNECTION_ASYNC);
-    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_DESCRIPTION_BY_ID, "UPDATE tickets SET description = ? WHERE ID = ?", CONNECTION_ASYNC);
-    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_TO_CLOSED_BY_ID, "UPDATE tickets Set current_status = ?, closed_at = ? WHERE ID = ?", CONNECTION_ASYNC);
+    // ticket_overview_summary consistency check: open tickets whose summary row is
+    // missing or disagrees with their comments, repaired through the same procedure
+    // the ticket_comments triggers call.
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_SUMMARY_SELECT_DRIFT,
+          "SELECT t.ID "
+          "FROM tickets t "
+          "LEFT JOIN ticket_overview_summary s ON s.ticket_id = t.ID "
+          "LEFT JOIN ticket_comments lc ON lc.id = s.latest_comment_id "
+          "WHERE t.is_deleted = 0 AND t.current_status NOT IN (?, ?) "
+          "AND (COALESCE(s.comment_count, 0) <> "
+          "(SELECT COUNT(*) FROM ticket_comments c WHERE c.ticket_id = t.ID AND c.is_deleted = 0) "
+          "OR NOT (s.latest_comment_id <=> "
+          "(SELECT c.id FROM ticket_comments c WHERE c.ticket_id = t.ID AND c.is_deleted = 0 "
+          "ORDER BY COALESCE(c.updated_at, c.created_at) DESC, c.id DESC LIMIT 1)) "
+          "OR NOT (s.latest_comment_message <=> lc.message)) "
+          "LIMIT 500",
+          CONNECTION_SYNC);
+
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_SUMMARY_REFRESH, "CALL ams_refresh_ticket_summary(?)", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_SUMMARY_CLAIM_REPAIR_RUN, "UPDATE ams_maintenance_jobs SET last_run = NOW() WHERE job = 'overview_summary_repair' AND last_run < NOW() - INTERVAL 1 DAY", CONNECTION_SYNC);
+
+    // Cheap change probe for the ticket detail cache. Child rows do not touch tickets.updated_at,
+    // so their counts and latest change are folded into the fingerprint as well. Attachments
+    // have no change timestamp; a checksum over the shown columns catches description edits.
+    // Caller, employee and machine rows are shared between tickets and come in through their
+    // ams_table_version counters (any edit there reloads cached details once).
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_SELECT_DETAIL_VERSION,
+          "SELECT CONCAT_WS('|', t.updated_at, t.row_version, t.current_status, "
+          "(SELECT CONCAT(COUNT(*), '/', COALESCE(MAX(unassigned_at), '')) FROM ticket_assignment WHERE ticket_id = t.ID), "
+          "(SELECT CONCAT(COUNT(*), '/', COALESCE(SUM(is_deleted), 0), '/', "
+          "COALESCE(SUM(CRC32(CONCAT_WS('|', description, original_filename, stored_filename, mime_type))), 0)) "
+          "FROM ticket_attachments WHERE ticket_id = t.ID), "
+          "(SELECT CONCAT(COUNT(*), '/', COALESCE(SUM(is_deleted), 0), '/', COALESCE(MAX(updated_at), '')) FROM ticket_comments WHERE ticket_id = t.ID), "
+          "(SELECT COUNT(*) FROM ticket_status_history WHERE ticket_id = t.ID), "
+          "(SELECT CONCAT(COUNT(*), '/', COALESCE(SUM(is_deleted), 0)) FROM ticket_spare_part_used WHERE ticket_id = t.ID), "
+          "(SELECT GROUP_CONCAT(version ORDER BY table_name SEPARATOR '/') FROM ams_table_version "
+          "WHERE table_name IN ('caller_information', 'employees', 'machine_list'))) "
+          "FROM tickets t WHERE t.ID = ?", CONNECTION_SYNC);
+
+    // Field edits from the detail view are built from the ChangeTracker (ShowTicketDetailManager::BuildTicketUpdateSql).
+    // Bumping row_version makes trg_tickets_change_history_au write the history entry.
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_TO_CLOSED_BY_ID,
+          "UPDATE tickets SET current_status = ?, closed_at = ?, updated_by_user = ?, row_version = row_version + 1 WHERE ID = ?", CONNECTION_ASYNC);
 
     // CI - caller_information
     PREPARE_STATEMENT(AMSPreparedStatement::DB_CI_SELECT_ALL_CALLERS,
@@ -200,6 +225,22 @@ PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT,
         "FROM ticket_attachments WHERE ticket_id = ?", CONNECTION_SYNC);
     PREPARE_STATEMENT(AMSPreparedStatement::DB_TATT_SELECT_BY_ID, "SELECT id, ticket_id, uploaded_by_user, uploaded_at, original_filename, stored_filename, file_path, mime_type, file_size, description, "
     "encrypted_size, sha256_original, sha256_encrypted, is_deleted FROM ticket_attachments WHERE id = ? LIMIT 1", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TATT_INSERT_WITH_BLOB, "INSERT INTO ticket_attachments (ticket_id, uploaded_by_user, uploaded_at, original_filename, description, file_size, sha256_original, stored_filename, "
+    "file_path, mime_type, encrypted_size, sha256_encrypted, is_deleted) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, 0)", CONNECTION_SYNC);
+
+    // ticket_attachment_blobs table
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TAB_SELECT_BY_CONTENT, "SELECT id, stored_filename, file_path, encrypted_size, sha256_encrypted FROM ticket_attachment_blobs "
+    "WHERE sha256_original = ? AND file_size = ? LIMIT 1", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TAB_ADD_REF, "UPDATE ticket_attachment_blobs SET ref_count = ref_count + 1, released_at = NULL WHERE id = ?", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TAB_INSERT, "INSERT INTO ticket_attachment_blobs (sha256_original, file_size, stored_filename, file_path, encrypted_size, sha256_encrypted, "
+    "ref_count, created_at) VALUES (?, ?, ?, ?, ?, ?, 1, ?) ON DUPLICATE KEY UPDATE ref_count = ref_count + 1, released_at = NULL", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TAB_RECOUNT_REFS, "UPDATE ticket_attachment_blobs b SET b.ref_count = (SELECT COUNT(*) FROM ticket_attachments a "
+    "WHERE a.file_path = b.file_path AND a.stored_filename = b.stored_filename)", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TAB_MARK_RELEASED, "UPDATE ticket_attachment_blobs SET released_at = NOW() WHERE ref_count = 0 AND released_at IS NULL", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TAB_SELECT_COLLECTABLE, "SELECT id, stored_filename, file_path, sha256_original FROM ticket_attachment_blobs "
+    "WHERE ref_count = 0 AND released_at < NOW() - INTERVAL 1 DAY LIMIT 200", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TAB_DELETE_COLLECTABLE, "DELETE FROM ticket_attachment_blobs WHERE id = ? AND ref_count = 0 AND released_at < NOW() - INTERVAL 1 DAY", CONNECTION_SYNC);
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TAB_CLAIM_GC_RUN, "UPDATE ams_maintenance_jobs SET last_run = NOW() WHERE job = 'attachment_gc' AND last_run < NOW() - INTERVAL 1 DAY", CONNECTION_SYNC);
 
     // ticket_comment table
     PREPARE_STATEMENT(AMSPreparedStatement::DB_TC_INSERT_NEW_TICKET_COMMENT, "INSERT INTO ticket_comments (ticket_id, author_user_id, created_at, is_internal, message) VALUES "
@@ -320,6 +361,9 @@ PREPARE_STATEMENT(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT,
 
     // contractor_visit_status CVS
     PREPARE_STATEMENT(AMSPreparedStatement::DB_CVS_SELECT_ALL_STATUS, "SELECT id, status_name, description FROM contractor_visit_status", CONNECTION_SYNC);
+
+    // ams_table_version TV - change probe, see database::ChangeProbe
+    PREPARE_STATEMENT(AMSPreparedStatement::DB_TV_SELECT_VERSION, "SELECT version FROM ams_table_version WHERE table_name = ?", CONNECTION_SYNC);
 }
 
 } // namespace database::Implementation
@@ -20,10 +20,10 @@ enum class AMSPreparedStatement : std::uint32_t
     DB_TICKET_OVERVIEW_SELECT_SINCE,
     DB_TICKET_OVERVIEW_SELECT_REMOVED_SINCE,
     DB_TICKET_OVERVIEW_SELECT_LAST_COMMENT_BY_ID,
-    DB_TICKET_UPDATE_TICKET_STATUS_BY_ID,
-    DB_TICKET_UPDATE_TICKET_PRIORITY_BY_ID,
-    DB_TICKET_UPDATE_TICKET_TITLE_BY_ID,
-    DB_TICKET_UPDATE_TICKET_DESCRIPTION_BY_ID,
+    DB_TICKET_SUMMARY_SELECT_DRIFT,
+    DB_TICKET_SUMMARY_REFRESH,
+    DB_TICKET_SUMMARY_CLAIM_REPAIR_RUN,
+    DB_TICKET_SELECT_DETAIL_VERSION,
     DB_TICKET_UPDATE_TICKET_TO_CLOSED_BY_ID,
 
     // ticket_assignment table
@@ -39,6 +39,17 @@ enum class AMSPreparedStatement : std::uint32_t
     DB_TATT_UPDATE_META,
     DB_TATT_SELECT_TICKET_ATTACHMENTS_BY_TICKET_ID,
     DB_TATT_SELECT_BY_ID,
+    DB_TATT_INSERT_WITH_BLOB,
+
+    // ticket_attachment_blobs table
+    DB_TAB_SELECT_BY_CONTENT,
+    DB_TAB_ADD_REF,
+    DB_TAB_INSERT,
+    DB_TAB_RECOUNT_REFS,
+    DB_TAB_MARK_RELEASED,
+    DB_TAB_SELECT_COLLECTABLE,
+    DB_TAB_DELETE_COLLECTABLE,
+    DB_TAB_CLAIM_GC_RUN,
 
     // ticket_comment table
     DB_TC_INSERT_NEW_TICKET_COMMENT,
@@ -155,6 +166,8 @@ enum class AMSPreparedStatement : std::uint32_t
     // contractor_visit_status CVS
     DB_CVS_SELECT_ALL_STATUS,
 
+    // ams_table_version TV
+    DB_TV_SELECT_VERSION,
 
     MAX_VALUE
 };
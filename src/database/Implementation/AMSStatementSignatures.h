@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstdint>
+
+#include "DatabaseDefines.h"
+#include "Implementation/AMSDatabase.h"
+#include "TypedStatement.h"
+
+// Typed signatures for AMS statements, see TypedStatement.h.
+// Column order must match the SELECT list in AMSDatabase.cpp.
+
+namespace database
+{
+
+template <>
+struct StatementSignature<Implementation::AMSPreparedStatement::DB_TA_SELECT_TICKET_ASSIGNMENTS_BY_TICKET_ID>
+{
+    using Params = ParamList<std::uint64_t>;
+    using Row = TicketAssignmentInformation;
+    using Columns = ColumnList<&Row::ticketID, &Row::employeeID, &Row::assignedAt, &Row::unassignedAt, &Row::isCurrent,
+                               &Row::commentAssigned, &Row::commentUnassigned, &Row::assignedByUserID,
+                               &Row::unassignedByUserID>;
+};
+
+template <>
+struct StatementSignature<Implementation::AMSPreparedStatement::DB_TATT_SELECT_TICKET_ATTACHMENTS_BY_TICKET_ID>
+{
+    using Params = ParamList<std::uint64_t>;
+    using Row = TicketAttachmentInformation;
+    using Columns = ColumnList<&Row::id, &Row::ticketID, &Row::uploaderUserID, &Row::uploadedAt, &Row::originalFilename,
+                               &Row::storedFileName, &Row::filePath, &Row::mimeType, &Row::fileSize, &Row::description,
+                               &Row::isDeleted>;
+};
+
+template <>
+struct StatementSignature<Implementation::AMSPreparedStatement::DB_TC_SELECT_TICKET_COMMENTS_BY_TICKET_ID>
+{
+    using Params = ParamList<std::uint64_t>;
+    using Row = TicketCommentInformation;
+    using Columns = ColumnList<&Row::id, &Row::ticketID, &Row::authorUserID, &Row::createdAt, &Row::updatedAt,
+                               &Row::isInternal, &Row::isDeleted, &Row::message, &Row::deleterUserID, &Row::deleteAt>;
+};
+
+template <>
+struct StatementSignature<Implementation::AMSPreparedStatement::DB_TSH_SELECT_TICKET_STATUS_HISTORY_BY_TICKET_ID>
+{
+    using Params = ParamList<std::uint64_t>;
+    using Row = TicketStatusHistoryInformation;
+    using Columns = ColumnList<&Row::id, &Row::ticketID, &Row::oldStatus, &Row::newStatus, &Row::changedAt,
+                               &Row::changedByUserID, &Row::comment>;
+};
+
+template <>
+struct StatementSignature<Implementation::AMSPreparedStatement::DB_TC_UPDATE_COMMENT_MARK_AS_DELETED>
+{
+    using Params = ParamList<std::uint32_t, SystemTimePoint, std::uint64_t>;
+};
+
+} // namespace database
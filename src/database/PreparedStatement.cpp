@@ -76,12 +76,12 @@ void PreparedStatement::SetDouble(std::size_t index, double value)
 
 void PreparedStatement::SetBinary(std::size_t index, const std::string& value)
 {
-    if (binaryStreams_.size() <= index)
-        binaryStreams_.resize(index + 1);
+    BindBlob(index, std::make_unique<BlobInputStream>(value));
+}
 
-    auto stream = std::make_unique<std::istringstream>(value, std::ios::binary);
-    statement_->setBlob(index + 1, stream.get());
-    binaryStreams_[index] = std::move(stream);
+void PreparedStatement::SetBinary(std::size_t index, std::string&& value)
+{
+    BindBlob(index, std::make_unique<BlobInputStream>(std::move(value)));
 }
 
 void PreparedStatement::SetBinary(std::size_t index, const void* data, std::size_t byteCount)
@@ -96,6 +96,21 @@ void PreparedStatement::SetBinary(std::size_t index, const void* data, std::size
     SetBinary(index, std::string(bytes, bytes + byteCount));
 }
 
+void PreparedStatement::SetBinaryView(std::size_t index, std::span<const std::uint8_t> value)
+{
+    BindBlob(index, std::make_unique<BlobInputStream>(value));
+}
+
+void PreparedStatement::BindBlob(std::size_t index, std::unique_ptr<BlobInputStream> stream)
+{
+    if (binaryStreams_.size() <= index)
+        binaryStreams_.resize(index + 1);
+
+    // The connector reads the stream on execute, so it is kept until rebound.
+    statement_->setBlob(index + 1, stream.get());
+    binaryStreams_[index] = std::move(stream);
+}
+
 void PreparedStatement::SetString(std::size_t index, const std::string& value)
 {
     statement_->setString(index + 1, sql::SQLString(value));
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
 #include <type_traits>
 #include <vector>
@@ -15,6 +16,7 @@
 
 #include <mariadb/conncpp.hpp>
 
+#include "BlobStream.h"
 #include "DatabaseTypes.h"
 #include "Duration.h"
 
@@ -44,7 +46,10 @@ public:
     void SetUInt64(std::size_t index, std::uint64_t value);
     void SetDouble(std::size_t index, double value);
     void SetBinary(std::size_t index, const std::string& value);
+    void SetBinary(std::size_t index, std::string&& value);
     void SetBinary(std::size_t index, const void* data, std::size_t byteCount);
+    // Binds without copying; the bytes must stay alive until the statement has executed.
+    void SetBinaryView(std::size_t index, std::span<const std::uint8_t> value);
 
     template <typename Integral>
     void SetBinary(std::size_t index, const std::vector<Integral>& value)
@@ -62,10 +67,12 @@ public:
     void SetSystemPointTime(std::size_t index, const SystemTimePoint& value);
 
 private:
+    void BindBlob(std::size_t index, std::unique_ptr<BlobInputStream> stream);
+
     sql::Connection* connection_;
     StatementMetadata metadata_;
     std::unique_ptr<sql::PreparedStatement> statement_;
-    std::vector<std::unique_ptr<std::istringstream>> binaryStreams_;
+    std::vector<std::unique_ptr<BlobInputStream>> binaryStreams_;
 };
 
 PreparedStatementPtr MakePreparedStatement(sql::Connection* connection, const StatementMetadata& metadata);
@@ -0,0 +1,466 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <QMetaObject>
+#include <QObject>
+#include <QPointer>
+
+#include "AsyncExecutor.h"
+
+namespace database
+{
+
+enum class QueryStatus
+{
+    Pending,
+    Ready,
+    Failed,
+    Cancelled,
+    TimedOut
+};
+
+template <typename T>
+struct QueryOutcome
+{
+    QueryStatus status = QueryStatus::Pending;
+    std::optional<T> value;
+    std::string error;
+
+    bool Ok() const { return status == QueryStatus::Ready && value.has_value(); }
+};
+
+struct AsyncQueryOptions
+{
+    bool preferReplica = false;
+    // Zero means no deadline. Measured from submission; a query that has not
+    // finished by then is reported as TimedOut at that moment, even while it
+    // is still running. The server stops it (max_statement_time, and KILL
+    // QUERY from the deadline timer), so the connection is not held any longer.
+    std::chrono::milliseconds timeout{0};
+};
+
+namespace detail
+{
+
+template <typename T>
+class QueryState
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit QueryState(std::chrono::milliseconds timeout)
+    {
+        if (timeout.count() > 0)
+            deadline_ = Clock::now() + timeout;
+    }
+
+    const CancellationToken& Token() const { return token_; }
+
+    bool IsExpired() const { return deadline_ && Clock::now() > *deadline_; }
+    const std::optional<Clock::time_point>& Deadline() const { return deadline_; }
+
+    // Called by DeadlineTimer when the deadline passes: resolves the future as
+    // TimedOut and stops the statement if one is running.
+    void Expire()
+    {
+        CompleteStatus(QueryStatus::TimedOut, "Deadline expired");
+        RequestInterrupt();
+    }
+
+    // Time left until the deadline, at least 1 ms; zero when there is none.
+    std::chrono::milliseconds Remaining() const
+    {
+        if (!deadline_)
+            return std::chrono::milliseconds(0);
+
+        const auto left = std::chrono::duration_cast<std::chrono::milliseconds>(*deadline_ - Clock::now());
+        return std::max(left, std::chrono::milliseconds(1));
+    }
+
+    // Armed while the query holds a connection. request is called by Cancel()
+    // and must not block; it schedules a RunIfArmed() that stops the server-side
+    // work.
+    void ArmInterrupt(std::function<void()> request)
+    {
+        {
+            std::lock_guard<std::mutex> lock(requestMutex_);
+            interruptRequest_ = std::move(request);
+        }
+
+        std::lock_guard<std::mutex> lock(interruptMutex_);
+        armed_ = true;
+    }
+
+    // Called before the connection goes back to the pool. Waits for an
+    // interrupt in progress, so none reaches the connection's next borrower.
+    void DisarmInterrupt()
+    {
+        {
+            std::lock_guard<std::mutex> lock(requestMutex_);
+            interruptRequest_ = nullptr;
+        }
+
+        std::lock_guard<std::mutex> lock(interruptMutex_);
+        armed_ = false;
+    }
+
+    void RequestInterrupt()
+    {
+        std::function<void()> request;
+        {
+            std::lock_guard<std::mutex> lock(requestMutex_);
+            request = interruptRequest_;
+        }
+
+        if (request)
+            request();
+    }
+
+    template <typename Fn>
+    bool RunIfArmed(Fn&& interrupt)
+    {
+        std::lock_guard<std::mutex> lock(interruptMutex_);
+        if (!armed_)
+            return false;
+
+        interrupt();
+        return true;
+    }
+
+    bool IsDone() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return done_;
+    }
+
+    void Complete(QueryOutcome<T> outcome)
+    {
+        std::vector<std::function<void()>> continuations;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (done_)
+                return;
+
+            outcome_ = std::move(outcome);
+            done_ = true;
+            continuations.swap(continuations_);
+        }
+
+        cv_.notify_all();
+
+        for (auto& continuation : continuations)
+            continuation();
+    }
+
+    void CompleteValue(T value)
+    {
+        QueryOutcome<T> outcome;
+        if (token_.IsCancelled())
+            outcome.status = QueryStatus::Cancelled;
+        else if (IsExpired())
+            outcome.status = QueryStatus::TimedOut;
+        else
+        {
+            outcome.status = QueryStatus::Ready;
+            outcome.value = std::move(value);
+        }
+
+        Complete(std::move(outcome));
+    }
+
+    void CompleteStatus(QueryStatus status, std::string error = {})
+    {
+        QueryOutcome<T> outcome;
+        outcome.status = status;
+        outcome.error = std::move(error);
+        Complete(std::move(outcome));
+    }
+
+    // Runs on the thread that completes the query (or immediately if it already has).
+    void OnComplete(std::function<void()> continuation)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!done_)
+            {
+                continuations_.push_back(std::move(continuation));
+                return;
+            }
+        }
+
+        continuation();
+    }
+
+    const QueryOutcome<T>& Wait()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        cv_.wait(lock, [this]() { return done_; });
+        return outcome_;
+    }
+
+    // Only valid once IsDone() returned true.
+    const QueryOutcome<T>& Outcome() const { return outcome_; }
+    QueryOutcome<T>& Outcome() { return outcome_; }
+
+    template <typename Fn, typename... Args>
+    void Run(Fn& fn, Args&&... args)
+    {
+        if (token_.IsCancelled())
+        {
+            CompleteStatus(QueryStatus::Cancelled);
+            return;
+        }
+
+        if (IsExpired())
+        {
+            CompleteStatus(QueryStatus::TimedOut, "Deadline expired before the query started");
+            return;
+        }
+
+        try
+        {
+            CompleteValue(fn(std::forward<Args>(args)...));
+        }
+        catch (const std::exception& ex)
+        {
+            CompleteStatus(FailureStatus(), ex.what());
+        }
+        catch (...)
+        {
+            CompleteStatus(FailureStatus(), "Unknown error");
+        }
+    }
+
+private:
+    // A statement killed by Cancel() or stopped by max_statement_time fails with
+    // a server error; report why it was stopped instead.
+    QueryStatus FailureStatus() const
+    {
+        if (token_.IsCancelled())
+            return QueryStatus::Cancelled;
+        if (IsExpired())
+            return QueryStatus::TimedOut;
+        return QueryStatus::Failed;
+    }
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool done_ = false;
+    QueryOutcome<T> outcome_;
+    std::vector<std::function<void()>> continuations_;
+    CancellationToken token_;
+    std::optional<Clock::time_point> deadline_;
+
+    std::mutex requestMutex_;
+    std::function<void()> interruptRequest_;
+    std::mutex interruptMutex_;
+    bool armed_ = false;
+};
+
+// Captured by the submitted task. If the executor drops the task without running
+// it (stopped, cancelled while queued, no connection available) the future is
+// still resolved instead of hanging forever.
+template <typename T>
+class CompletionGuard
+{
+public:
+    explicit CompletionGuard(std::shared_ptr<QueryState<T>> state) : state_(std::move(state)) {}
+
+    ~CompletionGuard()
+    {
+        if (state_ && !state_->IsDone())
+        {
+            if (state_->Token().IsCancelled())
+                state_->CompleteStatus(QueryStatus::Cancelled);
+            else
+                state_->CompleteStatus(QueryStatus::Failed, "Query was dropped before execution");
+        }
+    }
+
+    CompletionGuard(const CompletionGuard&) = delete;
+    CompletionGuard& operator=(const CompletionGuard&) = delete;
+
+    const std::shared_ptr<QueryState<T>>& State() const { return state_; }
+
+private:
+    std::shared_ptr<QueryState<T>> state_;
+};
+
+} // namespace detail
+
+// Result handle of DatabaseManager::QueryAsync. A future has a single consumer:
+// attach either one Then() or one Map(), the outcome is moved into it.
+template <typename T>
+class QueryFuture
+{
+public:
+    using ValueType = T;
+
+    QueryFuture() = default;
+    explicit QueryFuture(std::shared_ptr<detail::QueryState<T>> state) : state_(std::move(state)) {}
+
+    bool IsValid() const { return static_cast<bool>(state_); }
+    bool IsReady() const { return state_ && state_->IsDone(); }
+
+    // Resolves the future as Cancelled right away. A query that is already
+    // running on a pooled connection is killed on the server (KILL QUERY from a
+    // side connection), so its connection goes back to the pool right away.
+    void Cancel()
+    {
+        if (!state_)
+            return;
+
+        state_->Token().Cancel();
+        state_->CompleteStatus(QueryStatus::Cancelled);
+        state_->RequestInterrupt();
+    }
+
+    // Blocks the calling thread. Never call this from the GUI thread.
+    const QueryOutcome<T>& Wait() const { return state_->Wait(); }
+
+    // Invokes callback(QueryOutcome<T>) on the thread of context. The callback is
+    // dropped if context has been destroyed by the time the result arrives.
+    template <typename Callback>
+    const QueryFuture& Then(QObject* context, Callback callback) const
+    {
+        if (!state_)
+            return *this;
+
+        QPointer<QObject> guard(context);
+        auto state = state_;
+        state_->OnComplete(
+            [guard, state, callback = std::move(callback)]() mutable
+            {
+                if (!guard)
+                    return;
+
+                QMetaObject::invokeMethod(
+                    guard.data(),
+                    [guard, state, callback = std::move(callback)]() mutable
+                    {
+                        if (!guard)
+                            return;
+
+                        callback(std::move(state->Outcome()));
+                    },
+                    Qt::QueuedConnection);
+            });
+
+        return *this;
+    }
+
+    // Transforms the value on the completing worker thread. Errors, cancellation
+    // and timeouts propagate unchanged; fn is only called for Ready results.
+    template <typename Fn>
+    auto Map(Fn fn) const -> QueryFuture<std::invoke_result_t<Fn, T&&>>
+    {
+        using U = std::invoke_result_t<Fn, T&&>;
+        auto mapped = std::make_shared<detail::QueryState<U>>(std::chrono::milliseconds(0));
+        auto source = state_;
+
+        source->OnComplete(
+            [source, mapped, fn = std::move(fn)]() mutable
+            {
+                auto& outcome = source->Outcome();
+                if (!outcome.Ok())
+                {
+                    mapped->CompleteStatus(outcome.status, outcome.error);
+                    return;
+                }
+
+                try
+                {
+                    mapped->CompleteValue(fn(std::move(*outcome.value)));
+                }
+                catch (const std::exception& ex)
+                {
+                    mapped->CompleteStatus(QueryStatus::Failed, ex.what());
+                }
+            });
+
+        return QueryFuture<U>(mapped);
+    }
+
+    const std::shared_ptr<detail::QueryState<T>>& State() const { return state_; }
+
+private:
+    std::shared_ptr<detail::QueryState<T>> state_;
+};
+
+// Joins independent queries. Resolves once every input has completed; the
+// first failing, cancelled or timed out input determines the joined status.
+// Without inputs it is Ready right away.
+template <typename... Ts>
+QueryFuture<std::tuple<Ts...>> WhenAll(const QueryFuture<Ts>&... futures)
+{
+    using Joined = std::tuple<Ts...>;
+    auto joined = std::make_shared<detail::QueryState<Joined>>(std::chrono::milliseconds(0));
+
+    if constexpr (sizeof...(Ts) == 0)
+    {
+        joined->CompleteValue(Joined{});
+        return QueryFuture<Joined>(joined);
+    }
+    auto remaining = std::make_shared<std::atomic<std::size_t>>(sizeof...(Ts));
+    auto states = std::make_tuple(futures.State()...);
+
+    auto finish = [joined, states]()
+    {
+        QueryStatus status = QueryStatus::Ready;
+        std::string error;
+
+        std::apply(
+            [&](const auto&... state)
+            {
+                auto inspect = [&](const auto& s)
+                {
+                    if (status == QueryStatus::Ready && !s->Outcome().Ok())
+                    {
+                        status = s->Outcome().status;
+                        error = s->Outcome().error;
+                    }
+                };
+                (inspect(state), ...);
+            },
+            states);
+
+        if (status != QueryStatus::Ready)
+        {
+            joined->CompleteStatus(status, std::move(error));
+            return;
+        }
+
+        joined->CompleteValue(std::apply([](const auto&... state) { return Joined(std::move(*state->Outcome().value)...); }, states));
+    };
+
+    std::apply(
+        [&](const auto&... state)
+        {
+            (state->OnComplete(
+                 [remaining, finish]()
+                 {
+                     if (remaining->fetch_sub(1) == 1)
+                         finish();
+                 }),
+             ...);
+        },
+        states);
+
+    return QueryFuture<Joined>(joined);
+}
+
+} // namespace database
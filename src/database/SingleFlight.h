@@ -0,0 +1,207 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#include <QString>
+
+#include "Duration.h"
+
+namespace database
+{
+
+// Identifies a read by statement and bound parameters.
+struct ReadKey
+{
+    std::uint32_t statement = 0;
+    std::string params;
+
+    bool operator==(const ReadKey& other) const = default;
+};
+
+struct ReadKeyHash
+{
+    std::size_t operator()(const ReadKey& key) const noexcept
+    {
+        return std::hash<std::string>{}(key.params) ^ (static_cast<std::size_t>(key.statement) * 0x9E3779B97F4A7C15ull);
+    }
+};
+
+namespace detail
+{
+
+template <typename T>
+void AppendKeyPart(std::string& out, const T& value)
+{
+    if constexpr (std::is_same_v<T, std::string>)
+    {
+        out += std::to_string(value.size());
+        out.push_back(':');
+        out += value;
+    }
+    else if constexpr (std::is_same_v<T, QString>)
+    {
+        AppendKeyPart(out, value.toStdString());
+    }
+    else if constexpr (std::is_same_v<T, SystemTimePoint>)
+    {
+        out += std::to_string(value.time_since_epoch().count());
+    }
+    else if constexpr (std::is_enum_v<T>)
+    {
+        out += std::to_string(static_cast<std::underlying_type_t<T>>(value));
+    }
+    else
+    {
+        static_assert(std::is_arithmetic_v<T>, "Unsupported read key parameter type");
+        out += std::to_string(value);
+    }
+
+    out.push_back('|');
+}
+
+template <typename T>
+void AppendKeyPart(std::string& out, const std::optional<T>& value)
+{
+    if (value)
+        AppendKeyPart(out, *value);
+    else
+        out += "N|";
+}
+
+} // namespace detail
+
+template <typename Statement, typename... Args>
+ReadKey MakeReadKey(Statement statement, const Args&... args)
+{
+    ReadKey key;
+    key.statement = static_cast<std::uint32_t>(statement);
+    (detail::AppendKeyPart(key.params, args), ...);
+    return key;
+}
+
+// Collapses concurrent identical reads into one execution.
+//
+// The first caller for a key runs the loader; callers arriving while it is in
+// flight block until it finishes and receive the same immutable result. With a
+// non-zero ttl the result is additionally kept for that long and handed out
+// without touching the database. Loader exceptions are rethrown to every
+// waiter and are never cached. After Invalidate or Clear, a load that was
+// already running still reaches its own waiters but is not cached, since it may
+// have read the data from before the write that caused the invalidation; later
+// callers start a fresh load instead of joining it.
+template <typename T>
+class SingleFlightGroup
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using ResultPtr = std::shared_ptr<const T>;
+
+    template <typename Loader>
+    ResultPtr Do(const ReadKey& key, Loader&& loader, std::chrono::milliseconds ttl = std::chrono::milliseconds(0))
+    {
+        std::promise<ResultPtr> promise;
+        std::uint64_t generation = 0;
+
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+
+            auto cached = cache_.find(key);
+            if (cached != cache_.end())
+            {
+                if (Clock::now() < cached->second.expiresAt)
+                    return cached->second.value;
+
+                cache_.erase(cached);
+            }
+
+            auto running = inFlight_.find(key);
+            if (running != inFlight_.end())
+            {
+                auto shared = running->second.result;
+                lock.unlock();
+                return shared.get();
+            }
+
+            generation = generation_;
+            inFlight_.emplace(key, InFlight{promise.get_future().share(), generation});
+        }
+
+        ResultPtr result;
+        std::exception_ptr error;
+        try
+        {
+            result = std::make_shared<const T>(loader());
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            // Invalidate may have handed the key to a newer load already.
+            auto running = inFlight_.find(key);
+            if (running != inFlight_.end() && running->second.generation == generation)
+                inFlight_.erase(running);
+
+            if (!error && ttl.count() > 0 && generation == generation_)
+                cache_[key] = CacheEntry{result, Clock::now() + ttl};
+        }
+
+        if (error)
+        {
+            promise.set_exception(error);
+            std::rethrow_exception(error);
+        }
+
+        promise.set_value(result);
+        return result;
+    }
+
+    void Invalidate(const ReadKey& key)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.erase(key);
+        inFlight_.erase(key);
+        ++generation_;
+    }
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cache_.clear();
+        inFlight_.clear();
+        ++generation_;
+    }
+
+private:
+    struct InFlight
+    {
+        std::shared_future<ResultPtr> result;
+        std::uint64_t generation = 0;
+    };
+
+    struct CacheEntry
+    {
+        ResultPtr value;
+        Clock::time_point expiresAt;
+    };
+
+    std::mutex mutex_;
+    std::unordered_map<ReadKey, InFlight, ReadKeyHash> inFlight_;
+    std::unordered_map<ReadKey, CacheEntry, ReadKeyHash> cache_;
+    std::uint64_t generation_ = 0;
+};
+
+} // namespace database
@@ -1,9 +1,22 @@
 #include "SqlValidator.h"
 
+#include <algorithm>
+#include <atomic>
+#include <cctype>
 #include <chrono>
 #include <cstdint>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <ranges>
+#include <sstream>
 #include <string>
 #include <string_view>
+#include <thread>
+#include <unordered_set>
+#include <vector>
 
 #include "ConnectionGuard.h"
 #include "DatabaseConnection.h"
@@ -59,61 +72,535 @@ namespace
         return std::to_string(static_cast<std::uint32_t>(metadata.name));
     }
 
-    template <typename Guard>
-    void ValidateForConnectionType(DatabaseKind kind, std::string_view dbName, ConnectionType connectionType)
+    // One row of EXPLAIN output, reduced to what tells a good plan from a bad one.
+    struct PlanStep
     {
-        const auto start = std::chrono::steady_clock::now();
-        Guard guard(connectionType);
-        auto connection = guard.Get();
+        std::string id;
+        std::string table;
+        std::string accessType;  // ALL = full table scan, index = full index scan
+        std::string key;
+        std::uint64_t rows = 0;
+        bool filesort = false;
+        bool temporary = false;
+    };
+
+    using PlanMap = std::map<std::string, std::vector<PlanStep>>;  // statement label -> steps
+
+    bool IsFullScan(const std::string& accessType) { return accessType == "ALL" || accessType == "index"; }
+
+    bool IsExplainable(std::string_view query)
+    {
+        while (!query.empty() && std::isspace(static_cast<unsigned char>(query.front())))
+            query.remove_prefix(1);
 
-        if (!connection)
+        auto startsWith = [query](std::string_view keyword)
         {
-            LOG_DEBUG("No {} {} connection available for validation", dbName, connectionType == ConnectionType::Sync ? "sync" : "async");
-            return;
+            if (query.size() < keyword.size())
+                return false;
+            for (std::size_t i = 0; i < keyword.size(); ++i)
+            {
+                if (std::toupper(static_cast<unsigned char>(query[i])) != keyword[i])
+                    return false;
+            }
+            return true;
+        };
+
+        return startsWith("SELECT") || startsWith("UPDATE") || startsWith("DELETE");
+    }
+
+    std::uint64_t ParseRows(const std::string& value)
+    {
+        std::uint64_t rows = 0;
+        for (const char c : value)
+        {
+            if (c < '0' || c > '9')
+                break;
+            rows = rows * 10 + static_cast<std::uint64_t>(c - '0');
         }
+        return rows;
+    }
 
-        const auto allStatements = PreparedStatementRegistry::Instance().GetAll();
-        int successCount = 0;
-        int failCount = 0;
+    // One EXPLAIN row from TryPrepareStatement, which binds every placeholder as '1'.
+    // The plans are estimates for that value, but the same one every run, so runs
+    // compare against each other.
+    // id, select_type, table, type, possible_keys, key, key_len, ref, rows, Extra
+    PlanStep PlanStepFromRow(const std::vector<Field>& row)
+    {
+        auto column = [&row](std::size_t index) { return index < row.size() && !row[index].IsNull() ? row[index].ToString() : std::string{}; };
+
+        PlanStep step;
+        step.id = column(0);
+        step.table = column(2);
+        step.accessType = column(3);
+        step.key = column(5);
+        step.rows = ParseRows(column(8));
+
+        const std::string extra = column(9);
+        step.filesort = extra.find("Using filesort") != std::string::npos;
+        step.temporary = extra.find("Using temporary") != std::string::npos;
+
+        return step;
+    }
+
+    // Tab separated: label, id, table, type, key, rows, flags (F = filesort, T = temporary)
+    PlanMap LoadBaseline(const std::filesystem::path& path)
+    {
+        PlanMap plans;
+        std::ifstream in(path);
+        std::string line;
 
-        for (const auto& metadata : allStatements)
+        while (std::getline(in, line))
         {
-            if (!IsStatementForDatabase(metadata.name, kind))
-                continue;
-            if (!SupportsConnectionType(metadata, connectionType))
+            std::vector<std::string> columns;
+            std::istringstream fields(line);
+            for (std::string column; std::getline(fields, column, '\t');)
+                columns.push_back(std::move(column));
+
+            if (columns.size() < 6)
                 continue;
 
-            std::string error;
-            if (!connection->TryPrepareStatement(metadata.name, error))
+            PlanStep step;
+            step.id = columns[1];
+            step.table = columns[2];
+            step.accessType = columns[3];
+            step.key = columns[4];
+            step.rows = ParseRows(columns[5]);
+            if (columns.size() > 6)
+            {
+                step.filesort = columns[6].find('F') != std::string::npos;
+                step.temporary = columns[6].find('T') != std::string::npos;
+            }
+
+            plans[columns[0]].push_back(std::move(step));
+        }
+
+        return plans;
+    }
+
+    bool SaveBaseline(const std::filesystem::path& path, const PlanMap& plans)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+            return false;
+
+        for (const auto& [label, steps] : plans)
+        {
+            for (const auto& step : steps)
             {
-                LOG_DEBUG("❌ [{} {}] Statement {} failed:\n{}", dbName, connectionType == ConnectionType::Sync ? "sync" : "async", StatementLabel(metadata), error);
-                ++failCount;
+                out << label << '\t' << step.id << '\t' << step.table << '\t' << step.accessType << '\t' << step.key << '\t' << step.rows << '\t'
+                    << (step.filesort ? "F" : "") << (step.temporary ? "T" : "") << '\n';
             }
+        }
+
+        return static_cast<bool>(out);
+    }
+
+    std::string DescribeStep(const PlanStep& step)
+    {
+        std::string text = step.table.empty() ? std::string("<no table>") : step.table;
+        text += " type=" + (step.accessType.empty() ? std::string("-") : step.accessType);
+        text += " key=" + (step.key.empty() ? std::string("-") : step.key);
+        text += " rows=" + std::to_string(step.rows);
+        if (step.filesort)
+            text += " filesort";
+        if (step.temporary)
+            text += " temporary";
+        return text;
+    }
+
+    // Regressions: a step that used an index now scans the table or the whole index.
+    // Notices: new filesort/temporary use, or a row estimate that grew tenfold.
+    void CompareStatement(const std::string& label, const std::vector<PlanStep>& baseline, const std::vector<PlanStep>& current,
+                          std::vector<std::string>& regressions, std::vector<std::string>& notices)
+    {
+        for (const auto& step : current)
+        {
+            auto it = std::ranges::find_if(baseline, [&step](const PlanStep& b) { return b.id == step.id && b.table == step.table; });
+            if (it == baseline.end())
+                continue;
+
+            const std::string change = label + ": " + DescribeStep(*it) + "  ->  " + DescribeStep(step);
+
+            if (IsFullScan(step.accessType) && !IsFullScan(it->accessType))
+                regressions.push_back(change);
+            else if (step.accessType == "ALL" && it->accessType == "index")
+                regressions.push_back(change);
+            else if ((step.filesort && !it->filesort) || (step.temporary && !it->temporary))
+                notices.push_back(change);
+            else if (step.rows > 1000 && step.rows > it->rows * 10)
+                notices.push_back(change);
+        }
+    }
+
+    // current holds the plans explained in this run; unchanged lists statements
+    // taken from the validation cache, whose baseline plans are carried over.
+    void CapturePlans(std::string_view dbName, PlanMap current, const std::vector<std::string>& unchanged)
+    {
+        const std::filesystem::path dir = sLog->ensurePath(GetSettings().getLogPath());
+        if (dir.empty())
+            return;
+
+        const std::string prefix = "sql_plans_" + std::string(dbName);
+        const auto baselinePath = dir / (prefix + "_baseline.tsv");
+        const auto reportPath = dir / (prefix + "_report.txt");
+
+        const bool hasBaseline = std::filesystem::exists(baselinePath);
+        const PlanMap baseline = hasBaseline ? LoadBaseline(baselinePath) : PlanMap{};
+
+        std::vector<std::string> regressions;
+        std::vector<std::string> notices;
+        std::size_t added = 0;
+
+        const std::size_t explained = current.size();
+
+        for (const auto& [label, steps] : current)
+        {
+            auto it = baseline.find(label);
+            if (it == baseline.end())
+                ++added;
             else
+                CompareStatement(label, it->second, steps, regressions, notices);
+        }
+
+        std::size_t reused = 0;
+        for (const auto& label : unchanged)
+        {
+            auto it = baseline.find(label);
+            if (it != baseline.end() && current.emplace(label, it->second).second)
+                ++reused;
+        }
+
+        std::size_t fullScans = 0;
+        for (const auto& steps : current | std::views::values)
+            fullScans += std::ranges::count_if(steps, [](const PlanStep& step) { return step.accessType == "ALL"; });
+
+        std::ofstream report(reportPath, std::ios::trunc);
+        if (report)
+        {
+            const std::time_t now = std::time(nullptr);
+            std::tm localTime{};
+#ifdef _WIN32
+            localtime_s(&localTime, &now);
+#else
+            localtime_r(&now, &localTime);
+#endif
+            report << "Query plan report " << dbName << " - " << std::put_time(&localTime, "%Y-%m-%d %H:%M:%S") << "\n";
+            report << "Statements explained: " << explained << ", from baseline: " << reused << ", new: " << added
+                   << ", full table scans: " << fullScans << "\n";
+            report << "Baseline: " << (hasBaseline ? baselinePath.string() : std::string("none, created now")) << "\n\n";
+
+            report << "Regressed to full scans (" << regressions.size() << "):\n";
+            for (const auto& line : regressions)
+                report << "  " << line << "\n";
+
+            report << "\nOther plan changes (" << notices.size() << "):\n";
+            for (const auto& line : notices)
+                report << "  " << line << "\n";
+
+            report << "\nCurrent plans:\n";
+            for (const auto& [label, steps] : current)
             {
-                LOG_DEBUG("✅ [{} {}] Statement {} OK", dbName, connectionType == ConnectionType::Sync ? "sync" : "async", StatementLabel(metadata));
-                ++successCount;
+                report << "  " << label << "\n";
+                for (const auto& step : steps)
+                    report << "    [" << step.id << "] " << DescribeStep(step) << "\n";
             }
         }
 
-        const auto end = std::chrono::steady_clock::now();
-        const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(end - start).count();
-        LOG_DEBUG("🧾 [{} {}] Validation complete. Success: {}, Failed: {} | Duration: {} ms", dbName, connectionType == ConnectionType::Sync ? "sync" : "async", successCount, failCount, duration);
+        for (const auto& line : regressions)
+            LOG_WARNING("[{}] Query plan regressed: {}", dbName, line);
+
+        // A regressed baseline is kept, so the warning repeats until the plan is fixed;
+        // delete the baseline file to accept the current plans instead.
+        if (regressions.empty())
+        {
+            if (!SaveBaseline(baselinePath, current))
+                LOG_WARNING("[{}] Could not write query plan baseline {}", dbName, baselinePath.string());
+        }
+
+        LOG_DEBUG("[{}] Query plans: {} explained, {} from baseline, {} regressed, {} other change(s), {} new | report: {}", dbName, explained, reused,
+                  regressions.size(), notices.size(), added, reportPath.string());
+    }
+
+    // FNV-1a: stable across runs and builds, unlike std::hash.
+    std::uint64_t HashText(std::string_view text)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (const char c : text)
+        {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    std::string CacheKey(const StatementMetadata& metadata, ConnectionType connectionType)
+    {
+        return std::string(connectionType == ConnectionType::Sync ? "S" : "A") + std::to_string(HashText(metadata.query));
+    }
+
+    // Everything a statement can fail to prepare against: server version, tables
+    // and columns, indexes (they also decide the plans), routines and views.
+    constexpr std::string_view SchemaFingerprintQuery =
+        "SELECT CONCAT_WS('/', VERSION(), DATABASE(), "
+        "(SELECT CONCAT(COUNT(*), ':', COALESCE(BIT_XOR(CRC32(CONCAT_WS('|', TABLE_NAME, COLUMN_NAME, ORDINAL_POSITION, COLUMN_TYPE, IS_NULLABLE))), 0)) "
+        "FROM information_schema.COLUMNS WHERE TABLE_SCHEMA = DATABASE()), "
+        "(SELECT CONCAT(COUNT(*), ':', COALESCE(BIT_XOR(CRC32(CONCAT_WS('|', TABLE_NAME, INDEX_NAME, SEQ_IN_INDEX, COLUMN_NAME, NON_UNIQUE))), 0)) "
+        "FROM information_schema.STATISTICS WHERE TABLE_SCHEMA = DATABASE()), "
+        "(SELECT CONCAT(COUNT(*), ':', COALESCE(BIT_XOR(CRC32(CONCAT_WS('|', ROUTINE_NAME, ROUTINE_TYPE, LAST_ALTERED))), 0)) "
+        "FROM information_schema.ROUTINES WHERE ROUTINE_SCHEMA = DATABASE()), "
+        "(SELECT CONCAT(COUNT(*), ':', COALESCE(BIT_XOR(CRC32(CONCAT_WS('|', TABLE_NAME, VIEW_DEFINITION))), 0)) "
+        "FROM information_schema.VIEWS WHERE TABLE_SCHEMA = DATABASE()))";
+
+    std::string QuerySchemaFingerprint(DatabaseConnection& connection)
+    {
+        auto result = connection.ExecuteAdhocPreparedSelect(std::string(SchemaFingerprintQuery), {});
+        if (!result.IsValid() || !result.Next())
+            return {};
+
+        Field* f = result.Fetch();
+        return f[0].IsNull() ? std::string{} : f[0].ToString();
+    }
+
+    // Statements that prepared fine against a schema with this fingerprint.
+    struct ValidationCache
+    {
+        std::string fingerprint;
+        std::int64_t lastServerMs = 0;  // last validation that covered every statement
+        std::unordered_set<std::string> validated;
+    };
+
+    ValidationCache LoadValidationCache(const std::filesystem::path& path)
+    {
+        ValidationCache cache;
+        std::ifstream in(path);
+        std::string line;
+
+        while (std::getline(in, line))
+        {
+            const auto tab = line.find('\t');
+            if (tab == std::string::npos)
+                continue;
+
+            const std::string_view tag(line.data(), tab);
+            std::string value = line.substr(tab + 1);
+
+            if (tag == "fingerprint")
+                cache.fingerprint = std::move(value);
+            else if (tag == "duration")
+                cache.lastServerMs = static_cast<std::int64_t>(ParseRows(value));
+            else if (tag == "ok")
+                cache.validated.insert(std::move(value));
+        }
+
+        return cache;
+    }
+
+    void SaveValidationCache(const std::filesystem::path& path, const ValidationCache& cache)
+    {
+        std::ofstream out(path, std::ios::trunc);
+        if (!out)
+            return;
+
+        out << "fingerprint\t" << cache.fingerprint << '\n';
+        out << "duration\t" << cache.lastServerMs << '\n';
+        for (const auto& key : cache.validated)
+            out << "ok\t" << key << '\n';
+    }
+
+    enum class ValidationState : std::uint8_t
+    {
+        NotRun,
+        Ok,
+        Failed
+    };
+
+    constexpr std::size_t MaxValidationWorkers = 4;
+
+    // Spreads the statements over several pooled connections. Leaves one idle
+    // connection to the application, which is starting up at the same time.
+    // With plans set, the EXPLAIN rows of the explainable statements are kept there.
+    template <typename Database>
+    std::vector<ValidationState> ValidateParallel(std::string_view dbName, ConnectionType connectionType, const std::vector<StatementMetadata>& statements,
+                                                  std::vector<std::vector<PlanStep>>* plans = nullptr)
+    {
+        std::vector<ValidationState> states(statements.size(), ValidationState::NotRun);
+        if (statements.empty())
+            return states;
+
+        if (plans)
+            plans->assign(statements.size(), {});
+
+        const auto diagnostics = Database::GetDiagnostics();
+        const std::size_t available = connectionType == ConnectionType::Sync ? diagnostics.syncAvailable : diagnostics.asyncAvailable;
+        const std::size_t workers =
+            std::clamp<std::size_t>(available > 1 ? available - 1 : 1, 1, std::min(MaxValidationWorkers, statements.size()));
+
+        const char* typeName = connectionType == ConnectionType::Sync ? "sync" : "async";
+        std::atomic_size_t next{0};
+
+        auto work = [&]()
+        {
+            detail::ConnectionGuard<Database> guard(connectionType, /*preferReplica*/ false, "SqlValidator", std::chrono::minutes(1));
+            if (!guard)
+                return;
+
+            for (std::size_t i = next++; i < statements.size(); i = next++)
+            {
+                std::string error;
+                std::vector<std::vector<Field>> rows;
+                const bool keepPlan = plans && IsExplainable(statements[i].query);
+                if (guard->TryPrepareStatement(statements[i].name, error, keepPlan ? &rows : nullptr))
+                {
+                    for (const auto& row : rows)
+                        (*plans)[i].push_back(PlanStepFromRow(row));
+
+                    LOG_DEBUG("✅ [{} {}] Statement {} OK", dbName, typeName, StatementLabel(statements[i]));
+                    states[i] = ValidationState::Ok;
+                }
+                else
+                {
+                    LOG_DEBUG("❌ [{} {}] Statement {} failed:\n{}", dbName, typeName, StatementLabel(statements[i]), error);
+                    states[i] = ValidationState::Failed;
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        threads.reserve(workers - 1);
+        for (std::size_t i = 1; i < workers; ++i)
+            threads.emplace_back(work);
+
+        work();
+
+        for (auto& thread : threads)
+            thread.join();
+
+        return states;
     }
 
-    template <typename Guard>
+    template <typename Database>
     void ValidateDatabaseStatements(DatabaseKind kind, std::string_view dbName)
     {
         LOG_DEBUG("Validating prepared SQL statements for {}...", dbName);
-        ValidateForConnectionType<Guard>(kind, dbName, ConnectionType::Sync);
-        ValidateForConnectionType<Guard>(kind, dbName, ConnectionType::Async);
+
+        const auto start = std::chrono::steady_clock::now();
+
+        std::string fingerprint;
+        {
+            detail::ConnectionGuard<Database> guard(ConnectionType::Sync, /*preferReplica*/ false, "SqlValidator");
+            if (!guard)
+            {
+                LOG_DEBUG("No {} sync connection available for validation", dbName);
+                return;
+            }
+            fingerprint = QuerySchemaFingerprint(*guard);
+        }
+
+        const std::filesystem::path dir = sLog->ensurePath(GetSettings().getLogPath());
+        const std::filesystem::path cachePath = dir.empty() ? std::filesystem::path{} : dir / ("sql_validation_" + std::string(dbName) + ".tsv");
+
+        ValidationCache cache = cachePath.empty() ? ValidationCache{} : LoadValidationCache(cachePath);
+        const bool schemaUnchanged = !fingerprint.empty() && fingerprint == cache.fingerprint;
+        if (!schemaUnchanged)
+            cache.validated.clear();
+
+        const auto allStatements = PreparedStatementRegistry::Instance().GetAll();
+        PlanMap plans;
+        std::vector<std::string> cachedPlans;
+        std::size_t cachedTotal = 0;
+        bool ranOnServer = false;
+
+        for (const ConnectionType connectionType : {ConnectionType::Sync, ConnectionType::Async})
+        {
+            const auto typeStart = std::chrono::steady_clock::now();
+
+            std::vector<StatementMetadata> pending;
+            std::size_t cached = 0;
+
+            for (const auto& metadata : allStatements)
+            {
+                if (!IsStatementForDatabase(metadata.name, kind))
+                    continue;
+                if (!SupportsConnectionType(metadata, connectionType))
+                    continue;
+
+                if (cache.validated.contains(CacheKey(metadata, connectionType)))
+                {
+                    ++cached;
+                    if (connectionType == ConnectionType::Sync && IsExplainable(metadata.query))
+                        cachedPlans.push_back(StatementLabel(metadata));
+                    continue;
+                }
+
+                pending.push_back(metadata);
+            }
+
+            cachedTotal += cached;
+            if (pending.empty())
+                continue;
+
+            ranOnServer = true;
+            std::vector<std::vector<PlanStep>> pendingPlans;
+            const auto states =
+                ValidateParallel<Database>(dbName, connectionType, pending, connectionType == ConnectionType::Sync ? &pendingPlans : nullptr);
+
+            int successCount = 0;
+            int failCount = 0;
+            int notRunCount = 0;
+            for (std::size_t i = 0; i < pending.size(); ++i)
+            {
+                switch (states[i])
+                {
+                    case ValidationState::Ok:
+                        ++successCount;
+                        cache.validated.insert(CacheKey(pending[i], connectionType));
+                        if (connectionType == ConnectionType::Sync && IsExplainable(pending[i].query))
+                            plans.emplace(StatementLabel(pending[i]), std::move(pendingPlans[i]));
+                        break;
+                    case ValidationState::Failed:
+                        ++failCount;
+                        break;
+                    case ValidationState::NotRun:
+                        ++notRunCount;
+                        break;
+                }
+            }
+
+            if (notRunCount > 0)
+                LOG_DEBUG("No {} {} connection available for {} statement(s)", dbName, connectionType == ConnectionType::Sync ? "sync" : "async", notRunCount);
+
+            const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - typeStart).count();
+            LOG_DEBUG("🧾 [{} {}] Validation complete. Success: {}, Failed: {}, Cached: {} | Duration: {} ms", dbName,
+                      connectionType == ConnectionType::Sync ? "sync" : "async", successCount, failCount, cached, duration);
+        }
+
+        if (!ranOnServer)
+        {
+            const auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            LOG_DEBUG("🧾 [{}] Schema unchanged, {} statement(s) taken from the validation cache | Duration: {} ms, saved ~{} ms", dbName, cachedTotal,
+                      duration, std::max<std::int64_t>(cache.lastServerMs - duration, 0));
+            return;
+        }
+
+        // Plans only change with the schema and indexes (both in the fingerprint) or
+        // with the statements themselves, so only the statements that ran have new ones.
+        CapturePlans(dbName, std::move(plans), cachedPlans);
+
+        if (fingerprint.empty() || cachePath.empty())
+            return;
+
+        if (!schemaUnchanged)
+            cache.lastServerMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+
+        cache.fingerprint = fingerprint;
+        SaveValidationCache(cachePath, cache);
     }
 } // namespace
 
 void SqlValidator::ValidateAllStatements()
 {
-    ValidateDatabaseStatements<ConnectionGuardIMS>(DatabaseKind::IMS, "IMS");
-    ValidateDatabaseStatements<ConnectionGuardAMS>(DatabaseKind::AMS, "AMS");
+    ValidateDatabaseStatements<IMSDatabase>(DatabaseKind::IMS, "IMS");
+    ValidateDatabaseStatements<AMSDatabase>(DatabaseKind::AMS, "AMS");
 }
 
 } // namespace database
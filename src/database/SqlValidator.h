@@ -5,6 +5,13 @@ namespace database
     class SqlValidator
     {
        public:
+        // Prepares every registered statement, spread over several pooled connections,
+        // keeps the EXPLAIN plans of the SELECT/UPDATE/DELETE ones and compares them with
+        // the baseline in the log folder (sql_plans_<db>_baseline.tsv). Plans that fell back
+        // to full scans are logged and listed in sql_plans_<db>_report.txt.
+        //
+        // Results are cached in sql_validation_<db>.tsv under a schema fingerprint;
+        // against an unchanged schema only new or edited statements reach the server.
         static void ValidateAllStatements();
     };
 }  // namespace database
\ No newline at end of file
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <QString>
+
+#include <mariadb/conncpp.hpp>
+
+#include "DatabaseConnection.h"
+#include "Duration.h"
+#include "Field.h"
+#include "PreparedStatement.h"
+#include "SingleFlight.h"
+
+namespace database
+{
+
+// Compile-time description of a prepared statement.
+//
+// Each statement that should be accessed through the typed layer specializes
+// StatementSignature with its parameter list and, for SELECT statements, the
+// target row type plus the member each result column is decoded into:
+//
+//   template <>
+//   struct StatementSignature<AMSPreparedStatement::DB_TA_SELECT_TICKET_ASSIGNMENTS_BY_TICKET_ID>
+//   {
+//       using Params = ParamList<std::uint64_t>;
+//       using Row = TicketAssignmentInformation;
+//       using Columns = ColumnList<&Row::ticketID, &Row::employeeID, ...>;
+//   };
+//
+// BindTyped() then fills every parameter in one call and rejects mismatching or
+// narrowing arguments at compile time; QueryTyped() decodes each row straight
+// from the connector result set into Row without going through Field.
+
+template <typename... Ts>
+struct ParamList
+{
+    static constexpr std::size_t Count = sizeof...(Ts);
+};
+
+template <auto... Members>
+struct ColumnList
+{
+    static constexpr std::size_t Count = sizeof...(Members);
+};
+
+template <auto Statement>
+struct StatementSignature;
+
+namespace detail
+{
+
+template <typename T>
+struct IsOptional : std::false_type
+{
+};
+
+template <typename T>
+struct IsOptional<std::optional<T>> : std::true_type
+{
+};
+
+template <typename T>
+struct MemberPointerTraits;
+
+template <typename Class, typename Member>
+struct MemberPointerTraits<Member Class::*>
+{
+    using ClassType = Class;
+    using MemberType = Member;
+};
+
+template <auto Member>
+using MemberTypeOf = typename MemberPointerTraits<decltype(Member)>::MemberType;
+
+template <typename T>
+inline constexpr bool IsSupportedType =
+    std::is_same_v<T, bool> || std::is_integral_v<T> || std::is_floating_point_v<T> || std::is_same_v<T, std::string> ||
+    std::is_same_v<T, QString> || std::is_same_v<T, SystemTimePoint>;
+
+// Param{arg} is ill-formed for narrowing conversions, which is exactly what we
+// want to reject (e.g. passing a std::uint64_t where the statement expects a
+// std::uint32_t column).
+template <typename Param, typename Arg>
+concept BindableAs = requires(Arg&& arg) { Param{std::forward<Arg>(arg)}; };
+
+template <typename T>
+void BindParam(PreparedStatement& statement, std::size_t index, const T& value)
+{
+    if constexpr (IsOptional<T>::value)
+    {
+        if (value.has_value())
+            BindParam(statement, index, *value);
+        else
+            statement.SetNull(index);
+    }
+    else
+    {
+        static_assert(IsSupportedType<T>, "Unsupported parameter type in StatementSignature");
+
+        if constexpr (std::is_same_v<T, bool>)
+            statement.SetBool(index, value);
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) <= 4)
+            statement.SetInt(index, value);
+        else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) <= 4)
+            statement.SetUInt(index, value);
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            statement.SetInt64(index, value);
+        else if constexpr (std::is_integral_v<T>)
+            statement.SetUInt64(index, value);
+        else if constexpr (std::is_floating_point_v<T>)
+            statement.SetDouble(index, static_cast<double>(value));
+        else if constexpr (std::is_same_v<T, std::string>)
+            statement.SetString(index, value);
+        else if constexpr (std::is_same_v<T, QString>)
+            statement.SetQString(index, value);
+        else if constexpr (std::is_same_v<T, SystemTimePoint>)
+            statement.SetSystemPointTime(index, value);
+    }
+}
+
+template <typename T>
+T ReadColumn(sql::ResultSet& result, std::int32_t column)
+{
+    if constexpr (std::is_same_v<T, std::optional<SystemTimePoint>>)
+    {
+        // Unparseable values read as NULL (logged by ReadDateTimeColumn).
+        return ReadDateTimeColumn(result, column);
+    }
+
+    if (result.isNull(column))
+        return T{};
+
+    if constexpr (IsOptional<T>::value)
+    {
+        return ReadColumn<typename T::value_type>(result, column);
+    }
+    else
+    {
+        static_assert(IsSupportedType<T>, "Unsupported column type in StatementSignature");
+
+        if constexpr (std::is_same_v<T, bool>)
+            return result.getBoolean(column);
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) <= 4)
+            return static_cast<T>(result.getInt(column));
+        else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && sizeof(T) <= 4)
+            return static_cast<T>(result.getUInt(column));
+        else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+            return static_cast<T>(result.getInt64(column));
+        else if constexpr (std::is_integral_v<T>)
+            return static_cast<T>(result.getUInt64(column));
+        else if constexpr (std::is_floating_point_v<T>)
+            return static_cast<T>(result.getDouble(column));
+        else if constexpr (std::is_same_v<T, std::string>)
+        {
+            const sql::SQLString value = result.getString(column);
+            return std::string(value.c_str(), value.length());
+        }
+        else if constexpr (std::is_same_v<T, QString>)
+        {
+            const sql::SQLString value = result.getString(column);
+            return QString::fromUtf8(value.c_str(), static_cast<qsizetype>(value.length()));
+        }
+        else if constexpr (std::is_same_v<T, SystemTimePoint>)
+        {
+            // A required column has no NULL to fall back to; same error as Field::GetDateTime.
+            auto parsed = ReadDateTimeColumn(result, column);
+            if (!parsed)
+                throw std::runtime_error("Column does not contain a parseable datetime value");
+
+            return *parsed;
+        }
+    }
+}
+
+template <typename Params, typename... Args>
+struct ParamBinder;
+
+template <typename... Params, typename... Args>
+struct ParamBinder<ParamList<Params...>, Args...>
+{
+    static_assert(sizeof...(Params) == sizeof...(Args), "Argument count does not match the statement signature");
+    static_assert((BindableAs<Params, Args> && ...),
+                  "Argument type does not match the statement signature (mismatch or narrowing conversion)");
+
+    static void Bind(PreparedStatement& statement, Args&&... args)
+    {
+        BindAll(statement, std::index_sequence_for<Params...>{}, std::forward<Args>(args)...);
+    }
+
+private:
+    template <std::size_t... Index>
+    static void BindAll(PreparedStatement& statement, std::index_sequence<Index...>, Args&&... args)
+    {
+        (BindParam<Params>(statement, Index, Params{std::forward<Args>(args)}), ...);
+    }
+};
+
+template <typename Row, typename Columns>
+struct RowDecoder;
+
+template <typename Row, auto... Members>
+struct RowDecoder<Row, ColumnList<Members...>>
+{
+    static_assert((std::is_same_v<typename MemberPointerTraits<decltype(Members)>::ClassType, Row> && ...),
+                  "Column member does not belong to the statement row type");
+
+    static Row Decode(sql::ResultSet& result)
+    {
+        Row row{};
+        std::int32_t column = 1;
+        ((row.*Members = ReadColumn<MemberTypeOf<Members>>(result, column++)), ...);
+        return row;
+    }
+};
+
+template <typename Signature>
+concept HasRowType = requires {
+    typename Signature::Row;
+    typename Signature::Columns;
+};
+
+} // namespace detail
+
+template <auto Statement>
+using StatementRow = typename StatementSignature<Statement>::Row;
+
+template <auto Statement, typename... Args>
+void BindTyped(PreparedStatement& statement, Args&&... args)
+{
+    using Params = typename StatementSignature<Statement>::Params;
+    detail::ParamBinder<Params, Args...>::Bind(statement, std::forward<Args>(args)...);
+}
+
+template <auto Statement>
+StatementRow<Statement> DecodeTypedRow(sql::ResultSet& result)
+{
+    using Signature = StatementSignature<Statement>;
+    return detail::RowDecoder<typename Signature::Row, typename Signature::Columns>::Decode(result);
+}
+
+template <auto Statement, typename... Args>
+std::vector<StatementRow<Statement>> QueryTyped(DatabaseConnection& connection, Args&&... args)
+{
+    using Signature = StatementSignature<Statement>;
+    static_assert(detail::HasRowType<Signature>, "QueryTyped requires a statement signature with Row and Columns");
+
+    std::vector<StatementRow<Statement>> rows;
+
+    auto stmt = connection.GetPreparedStatement(Statement);
+    BindTyped<Statement>(*stmt, std::forward<Args>(args)...);
+
+    auto result = connection.ExecutePreparedSelectRaw(*stmt);
+    if (!result)
+        return rows;
+
+    while (result->next())
+        rows.push_back(DecodeTypedRow<Statement>(*result));
+
+    return rows;
+}
+
+// Same as QueryTyped, but concurrent identical reads (same statement and
+// parameters) share one execution and one immutable result. A non-zero ttl also
+// reuses the result for that long. Waiters keep their own connection leased.
+template <auto Statement, typename... Args>
+std::shared_ptr<const std::vector<StatementRow<Statement>>> QueryTypedShared(DatabaseConnection& connection, std::chrono::milliseconds ttl,
+                                                                            const Args&... args)
+{
+    static SingleFlightGroup<std::vector<StatementRow<Statement>>> group;
+    return group.Do(MakeReadKey(Statement, args...), [&]() { return QueryTyped<Statement>(connection, args...); }, ttl);
+}
+
+template <auto Statement, typename... Args>
+std::optional<StatementRow<Statement>> QueryTypedSingle(DatabaseConnection& connection, Args&&... args)
+{
+    using Signature = StatementSignature<Statement>;
+    static_assert(detail::HasRowType<Signature>, "QueryTypedSingle requires a statement signature with Row and Columns");
+
+    auto stmt = connection.GetPreparedStatement(Statement);
+    BindTyped<Statement>(*stmt, std::forward<Args>(args)...);
+
+    auto result = connection.ExecutePreparedSelectRaw(*stmt);
+    if (!result || !result->next())
+        return std::nullopt;
+
+    return DecodeTypedRow<Statement>(*result);
+}
+
+template <auto Statement, typename... Args>
+std::uint64_t ExecuteTyped(DatabaseConnection& connection, Args&&... args)
+{
+    auto stmt = connection.GetPreparedStatement(Statement);
+    BindTyped<Statement>(*stmt, std::forward<Args>(args)...);
+    return connection.ExecutePreparedModification(*stmt);
+}
+
+} // namespace database
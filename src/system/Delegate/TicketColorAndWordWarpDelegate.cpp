@@ -2,9 +2,8 @@
 
 #include <QApplication>
 #include <QPainter>
-#include <QTextDocument>
+#include <QTextOption>
 #include <cmath>
-#include <QAbstractTextDocumentLayout>
 
 #include "ShowTicketDetailManager.h"
 #include "pch.h"
@@ -18,6 +17,11 @@ namespace
     constexpr int ColStatus = 6;
     constexpr int ColOpenFor = 13;
 
+    // Vertical padding sizeHint adds around the text (QTextDocument's default margin).
+    constexpr qreal TextPadding = 4.0;
+    // Line width used when the column width is not known yet.
+    constexpr qreal UnboundedLineWidth = 1.0e6;
+
     QColor ColorForMinutesLocal(qint64 minutesOpen)
     {
         if (minutesOpen >= 48 * 60)
@@ -74,6 +78,53 @@ TicketColorAndWordWarpDelegate::TicketColorAndWordWarpDelegate(QObject* parent)
 
 QColor TicketColorAndWordWarpDelegate::ColorForMinutes(qint64 minutesOpen) { return ColorForMinutesLocal(minutesOpen); }
 
+void TicketColorAndWordWarpDelegate::ClearLayoutCache() { _layoutCache.clear(); }
+
+const TicketColorAndWordWarpDelegate::CachedLayout& TicketColorAndWordWarpDelegate::LayoutFor(const QString& text, const QFont& font, int width) const
+{
+    LayoutKey key{text, font, width};
+
+    if (auto it = _layoutCache.constFind(key); it != _layoutCache.cend())
+        return **it;
+
+    if (_layoutCache.size() >= MaxCachedLayouts)
+        _layoutCache.clear();
+
+    auto entry = std::make_shared<CachedLayout>();
+
+    // QTextLayout does not split paragraphs itself; line separators keep multi-line text intact.
+    QString layoutText = text;
+    layoutText.replace(QLatin1Char('\n'), QChar::LineSeparator);
+
+    QTextOption textOpt;
+    textOpt.setAlignment(Qt::AlignHCenter);
+    textOpt.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
+
+    QTextLayout& layout = entry->layout;
+    layout.setText(layoutText);
+    layout.setFont(font);
+    layout.setTextOption(textOpt);
+    layout.setCacheEnabled(true);
+
+    const qreal lineWidth = width > 0 ? static_cast<qreal>(width) : UnboundedLineWidth;
+
+    qreal y = 0.0;
+    layout.beginLayout();
+    for (QTextLine line = layout.createLine(); line.isValid(); line = layout.createLine())
+    {
+        line.setLineWidth(lineWidth);
+        line.setPosition(QPointF(0.0, y));
+        y += line.height();
+        entry->naturalWidth = std::max(entry->naturalWidth, line.naturalTextWidth());
+    }
+    layout.endLayout();
+
+    entry->height = y;
+
+    auto it = _layoutCache.insert(std::move(key), std::move(entry));
+    return **it;
+}
+
 void TicketColorAndWordWarpDelegate::paint(QPainter* painter, const QStyleOptionViewItem& option,
                                            const QModelIndex& index) const
 {
@@ -95,24 +146,15 @@ void TicketColorAndWordWarpDelegate::paint(QPainter* painter, const QStyleOption
 
     style->drawControl(QStyle::CE_ItemViewItem, &opt, painter, w);
 
-    QTextDocument doc;
-    doc.setDefaultFont(opt.font);
-    doc.setDocumentMargin(0.0);
-    doc.setTextWidth(opt.rect.width());
-    doc.setPlainText(text);
-
-    QTextOption textOpt = doc.defaultTextOption();
-    textOpt.setAlignment(Qt::AlignHCenter);
-    textOpt.setWrapMode(QTextOption::WrapAtWordBoundaryOrAnywhere);
-    doc.setDefaultTextOption(textOpt);
-
-    const qreal docHeight = doc.size().height();
-    const qreal yOffset = std::max<qreal>(0.0, (opt.rect.height() - docHeight) * 0.5);
-
-    painter->translate(opt.rect.left(), opt.rect.top() + yOffset);
+    if (!text.isEmpty())
+    {
+        const CachedLayout& cached = LayoutFor(text, opt.font, opt.rect.width());
+        const qreal yOffset = std::max<qreal>(0.0, (opt.rect.height() - cached.height) * 0.5);
 
-    const QRectF clip(0.0, 0.0, opt.rect.width(), opt.rect.height() - yOffset);
-    doc.drawContents(painter, clip);
+        painter->setClipRect(opt.rect, Qt::IntersectClip);
+        painter->setPen(opt.palette.color(opt.state & QStyle::State_Selected ? QPalette::HighlightedText : QPalette::Text));
+        cached.layout.draw(painter, QPointF(opt.rect.left(), opt.rect.top() + yOffset));
+    }
 
     painter->restore();
 }
@@ -124,11 +166,9 @@ QSize TicketColorAndWordWarpDelegate::sizeHint(const QStyleOptionViewItem& optio
 
     ApplyTicketColorFormatting(&opt, index);
 
-    QTextDocument doc;
-    doc.setDefaultFont(opt.font);
-    doc.setTextWidth(opt.rect.width());
-    doc.setPlainText(opt.text);
+    // Same layout paint uses, so the row is exactly as high as the wrapped text.
+    const CachedLayout& cached = LayoutFor(opt.text, opt.font, opt.rect.width());
 
-    const QSizeF s = doc.size();
-    return QSize(static_cast<int>(s.width()), static_cast<int>(std::ceil(s.height())));
+    const int width = opt.rect.width() > 0 ? opt.rect.width() : static_cast<int>(std::ceil(cached.naturalWidth + 2 * TextPadding));
+    return QSize(width, static_cast<int>(std::ceil(cached.height + 2 * TextPadding)));
 }
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <QFont>
+#include <QHash>
 #include <QStyledItemDelegate>
+#include <QTextLayout>
+#include <memory>
 
 class TicketColorAndWordWarpDelegate : public QStyledItemDelegate
 {
@@ -12,6 +16,36 @@ class TicketColorAndWordWarpDelegate : public QStyledItemDelegate
     void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
     QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const override;
 
+    // Drops all wrapped layouts, e.g. after the view font changed.
+    void ClearLayoutCache();
+
    private:
     static QColor ColorForMinutes(qint64 minutesOpen);
+
+    // Wrapped text of one cell at one column width, shared by paint and sizeHint.
+    struct CachedLayout
+    {
+        QTextLayout layout;
+        qreal height = 0.0;
+        qreal naturalWidth = 0.0;
+    };
+
+    struct LayoutKey
+    {
+        QString text;
+        QFont font;
+        int width = 0;
+
+        bool operator==(const LayoutKey& other) const { return width == other.width && text == other.text && font == other.font; }
+    };
+
+    friend size_t qHash(const LayoutKey& key, size_t seed) { return qHashMulti(seed, key.text, key.font, key.width); }
+
+    const CachedLayout& LayoutFor(const QString& text, const QFont& font, int width) const;
+
+    // The wall dashboard shows a few hundred cells; full is reached only after
+    // many refreshes or resizes, and then the cache simply starts over.
+    static constexpr qsizetype MaxCachedLayouts = 4096;
+
+    mutable QHash<LayoutKey, std::shared_ptr<CachedLayout>> _layoutCache;
 };
@@ -12,37 +12,42 @@ AssetDataManager::AssetDataManager() {}
 
 std::vector<LookupTableModel::Row> AssetDataManager::LoadMachineLines(std::uint32_t location, bool includeDeleted)
 {
-    std::vector<LookupTableModel::Row> machineLines;
+    ConnectionGuardAMS connection(ConnectionType::Sync, /*preferReplica*/ true);
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_ML_SELECT_ALL_LINES);
-    stmt->SetBool(0, includeDeleted);
-    stmt->SetUInt(1, location);
+    const std::string key = std::to_string(location) + "/" + std::to_string(includeDeleted);
+    return _lineCache.Get(*connection, key, [&](DatabaseConnection& conn) -> std::optional<std::vector<LookupTableModel::Row>>
+    {
+        auto stmt = conn.GetPreparedStatement(AMSPreparedStatement::DB_ML_SELECT_ALL_LINES);
+        stmt->SetBool(0, includeDeleted);
+        stmt->SetUInt(1, location);
 
-    // Load machine lines from the database
-    auto result = connection->ExecutePreparedSelect(*stmt);
+        // Load machine lines from the database
+        auto result = conn.ExecutePreparedSelect(*stmt);
 
-    if (!result.IsValid())
-        return machineLines;
+        if (!result.IsValid())
+            return std::nullopt;
 
-    while (result.Next())
-    {
-        LookupTableModel::Row line;
-        Field* fields = result.Fetch();
+        std::vector<LookupTableModel::Row> machineLines;
 
-        line.id = fields[0].GetUInt32();
-        line.name = fields[1].GetString();
-        line.isDeleted = fields[2].GetBool();
+        while (result.Next())
+        {
+            LookupTableModel::Row line;
+            Field* fields = result.Fetch();
 
-        if (!fields[3].IsNull())
-            line.deletedAt = Util::ConvertToQDateTime(fields[3].GetDateTime());
-        else
-            line.deletedAt = QDateTime();
+            line.id = fields[0].GetUInt32();
+            line.name = fields[1].GetString();
+            line.isDeleted = fields[2].GetBool();
 
-        machineLines.push_back(std::move(line));
-    }
+            if (!fields[3].IsNull())
+                line.deletedAt = Util::ConvertToQDateTime(fields[3].GetDateTime());
+            else
+                line.deletedAt = QDateTime();
+
+            machineLines.push_back(std::move(line));
+        }
 
-    return machineLines;
+        return machineLines;
+    });
 }
 
 std::uint32_t AssetDataManager::AddMachineLine(std::uint32_t location, const std::string& name)
@@ -103,32 +108,36 @@ QString AssetDataManager::GetMachineLineDeleteBlockReason(std::uint32_t /*id*/)
 
 std::vector<LookupTableModel::Row> AssetDataManager::LoadMachineTypes(bool includeDeleted)
 {
-    std::vector<LookupTableModel::Row> result;
+    ConnectionGuardAMS connection(ConnectionType::Sync, /*preferReplica*/ true);
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_MT_SELECT_ALL_TYPES);
-    stmt->SetUInt(0, includeDeleted);
-    auto queryResult = connection->ExecutePreparedSelect(*stmt);
+    return _typeCache.Get(*connection, std::to_string(includeDeleted), [&](DatabaseConnection& conn) -> std::optional<std::vector<LookupTableModel::Row>>
+    {
+        auto stmt = conn.GetPreparedStatement(AMSPreparedStatement::DB_MT_SELECT_ALL_TYPES);
+        stmt->SetUInt(0, includeDeleted);
+        auto queryResult = conn.ExecutePreparedSelect(*stmt);
 
-    if (!queryResult.IsValid())
-        return result;
+        if (!queryResult.IsValid())
+            return std::nullopt;
 
-    while (queryResult.Next())
-    {
-        LookupTableModel::Row type;
-        Field* fields = queryResult.Fetch();
-
-        type.id = fields[0].GetUInt32();
-        type.name = fields[1].GetString();
-        type.isDeleted = fields[2].GetBool();
-        if (!fields[3].IsNull())
-            type.deletedAt = Util::ConvertToQDateTime(fields[3].GetDateTime());
-        else
-            type.deletedAt = QDateTime();
-        result.push_back(std::move(type));
-    }
+        std::vector<LookupTableModel::Row> result;
 
-    return result;
+        while (queryResult.Next())
+        {
+            LookupTableModel::Row type;
+            Field* fields = queryResult.Fetch();
+
+            type.id = fields[0].GetUInt32();
+            type.name = fields[1].GetString();
+            type.isDeleted = fields[2].GetBool();
+            if (!fields[3].IsNull())
+                type.deletedAt = Util::ConvertToQDateTime(fields[3].GetDateTime());
+            else
+                type.deletedAt = QDateTime();
+            result.push_back(std::move(type));
+        }
+
+        return result;
+    });
 }
 
 std::uint32_t AssetDataManager::AddMachineType(const std::string& name)
@@ -186,32 +195,36 @@ QString AssetDataManager::GetMachineTypeDeleteBlockReason(std::uint32_t /*id*/)
 
 std::vector<LookupTableModel::Row> AssetDataManager::LoadMachineManufacturers(bool includeDeleted)
 {
-    std::vector<LookupTableModel::Row> result;
+    ConnectionGuardAMS connection(ConnectionType::Sync, /*preferReplica*/ true);
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_MM_SELECT_ALL_MANUFACTURERS);
-    stmt->SetUInt(0, includeDeleted);
+    return _manufacturerCache.Get(*connection, std::to_string(includeDeleted), [&](DatabaseConnection& conn) -> std::optional<std::vector<LookupTableModel::Row>>
+    {
+        auto stmt = conn.GetPreparedStatement(AMSPreparedStatement::DB_MM_SELECT_ALL_MANUFACTURERS);
+        stmt->SetUInt(0, includeDeleted);
 
-    auto queryResult = connection->ExecutePreparedSelect(*stmt);
+        auto queryResult = conn.ExecutePreparedSelect(*stmt);
 
-    if (!queryResult.IsValid())
-        return result;
+        if (!queryResult.IsValid())
+            return std::nullopt;
 
-    while (queryResult.Next())
-    {
-        LookupTableModel::Row manufacturer;
-        Field* fields = queryResult.Fetch();
-        manufacturer.id = fields[0].GetUInt32();
-        manufacturer.name = fields[1].GetString();
-        manufacturer.isDeleted = fields[2].GetBool();
-        if (!fields[3].IsNull())
-            manufacturer.deletedAt = Util::ConvertToQDateTime(fields[3].GetDateTime());
-        else
-            manufacturer.deletedAt = QDateTime();
-        result.push_back(std::move(manufacturer));
-    }
+        std::vector<LookupTableModel::Row> result;
 
-    return result;
+        while (queryResult.Next())
+        {
+            LookupTableModel::Row manufacturer;
+            Field* fields = queryResult.Fetch();
+            manufacturer.id = fields[0].GetUInt32();
+            manufacturer.name = fields[1].GetString();
+            manufacturer.isDeleted = fields[2].GetBool();
+            if (!fields[3].IsNull())
+                manufacturer.deletedAt = Util::ConvertToQDateTime(fields[3].GetDateTime());
+            else
+                manufacturer.deletedAt = QDateTime();
+            result.push_back(std::move(manufacturer));
+        }
+
+        return result;
+    });
 }
 
 std::uint32_t AssetDataManager::AddMachineManufacturer(const std::string& name)
@@ -271,34 +284,38 @@ std::vector<RoomTableModel::Row> AssetDataManager::LoadRooms(std::uint32_t cLoc,
 {
     // SELECT ID, room_code, room_name, is_deleted, deleted_at FROM facility_room WHERE companyLocation = ? AND is_deleted = ?
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_FR_SELECT_ROOMS_BY_LOCATION);
-    stmt->SetUInt(0, cLoc);
-    stmt->SetBool(1, showDeleted);
-    auto queryResult = connection->ExecutePreparedSelect(*stmt);
+    ConnectionGuardAMS connection(ConnectionType::Sync, /*preferReplica*/ true);
 
-    if (!queryResult.IsValid())
-        return {};
+    const std::string key = std::to_string(cLoc) + "/" + std::to_string(showDeleted);
+    return _roomCache.Get(*connection, key, [&](DatabaseConnection& conn) -> std::optional<std::vector<RoomTableModel::Row>>
+    {
+        auto stmt = conn.GetPreparedStatement(AMSPreparedStatement::DB_FR_SELECT_ROOMS_BY_LOCATION);
+        stmt->SetUInt(0, cLoc);
+        stmt->SetBool(1, showDeleted);
+        auto queryResult = conn.ExecutePreparedSelect(*stmt);
 
-    std::vector<RoomTableModel::Row> rooms;
+        if (!queryResult.IsValid())
+            return std::nullopt;
 
-    while (queryResult.Next())
-    {
-        RoomTableModel::Row room;
-        Field* fields = queryResult.Fetch();
-        room.id = fields[0].GetUInt32();
-        room.code = fields[1].GetString();
-        room.name = fields[2].GetString();
-        room.isDeleted = fields[3].GetBool();
-        if (!fields[4].IsNull())
-            room.deletedAt = Util::ConvertToQDateTime(fields[4].GetDateTime());
-        else
-            room.deletedAt = QDateTime();
-        rooms.push_back(std::move(room));
-    }
+        std::vector<RoomTableModel::Row> rooms;
 
-    return rooms;
+        while (queryResult.Next())
+        {
+            RoomTableModel::Row room;
+            Field* fields = queryResult.Fetch();
+            room.id = fields[0].GetUInt32();
+            room.code = fields[1].GetString();
+            room.name = fields[2].GetString();
+            room.isDeleted = fields[3].GetBool();
+            if (!fields[4].IsNull())
+                room.deletedAt = Util::ConvertToQDateTime(fields[4].GetDateTime());
+            else
+                room.deletedAt = QDateTime();
+            rooms.push_back(std::move(room));
+        }
 
+        return rooms;
+    });
 }
 
 std::uint32_t AssetDataManager::AddRoom(std::uint32_t cLoc, const std::string& code, const std::string& name)
@@ -613,108 +630,124 @@ std::vector<AssetDataManager::MachineData> AssetDataManager::LoadRoomData(Compan
 {
     // SELECT ID, room_code, room_name, is_deleted, deleted_at FROM facility_room WHERE companyLocation
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_FR_SELECT_ROOM_BY_LOCATION_ONLY);
-    stmt->SetUInt(0, static_cast<int>(cl));
+    ConnectionGuardAMS connection(ConnectionType::Sync, /*preferReplica*/ true);
 
-    auto queryResult = connection->ExecutePreparedSelect(*stmt);
+    return _roomDataCache.Get(*connection, std::to_string(static_cast<int>(cl)), [&](DatabaseConnection& conn) -> std::optional<std::vector<MachineData>>
+    {
+        auto stmt = conn.GetPreparedStatement(AMSPreparedStatement::DB_FR_SELECT_ROOM_BY_LOCATION_ONLY);
+        stmt->SetUInt(0, static_cast<int>(cl));
 
-    if (!queryResult.IsValid())
-        return {};
+        auto queryResult = conn.ExecutePreparedSelect(*stmt);
 
-    std::vector<MachineData> rooms;
+        if (!queryResult.IsValid())
+            return std::nullopt;
 
-    while (queryResult.Next())
-    {
-        MachineData room;
-        Field* fields = queryResult.Fetch();
-        room.id = fields[0].GetUInt32();
-        room.code = fields[1].GetString();
-        room.name = fields[2].GetString();
+        std::vector<MachineData> rooms;
 
-        rooms.push_back(std::move(room));
-    }
+        while (queryResult.Next())
+        {
+            MachineData room;
+            Field* fields = queryResult.Fetch();
+            room.id = fields[0].GetUInt32();
+            room.code = fields[1].GetString();
+            room.name = fields[2].GetString();
+
+            rooms.push_back(std::move(room));
+        }
 
-    return rooms;
+        return rooms;
+    });
 }
 
 std::vector<AssetDataManager::MachineData> AssetDataManager::LoadLineData(CompanyLocations cl)
 {
-    std::vector<MachineData> machineLines;
+    ConnectionGuardAMS connection(ConnectionType::Sync, /*preferReplica*/ true);
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_ML_SELECT_ALL_LINES);
-    stmt->SetBool(0, false);
-    stmt->SetUInt(1, static_cast<int>(cl));
+    return _lineDataCache.Get(*connection, std::to_string(static_cast<int>(cl)), [&](DatabaseConnection& conn) -> std::optional<std::vector<MachineData>>
+    {
+        auto stmt = conn.GetPreparedStatement(AMSPreparedStatement::DB_ML_SELECT_ALL_LINES);
+        stmt->SetBool(0, false);
+        stmt->SetUInt(1, static_cast<int>(cl));
 
-    // Load machine lines from the database
-    auto result = connection->ExecutePreparedSelect(*stmt);
+        // Load machine lines from the database
+        auto result = conn.ExecutePreparedSelect(*stmt);
 
-    if (!result.IsValid())
-        return machineLines;
+        if (!result.IsValid())
+            return std::nullopt;
 
-    while (result.Next())
-    {
-        MachineData line;
-        Field* fields = result.Fetch();
+        std::vector<MachineData> machineLines;
 
-        line.id = fields[0].GetUInt32();
-        line.name = fields[1].GetString();
+        while (result.Next())
+        {
+            MachineData line;
+            Field* fields = result.Fetch();
 
-        machineLines.push_back(std::move(line));
-    }
+            line.id = fields[0].GetUInt32();
+            line.name = fields[1].GetString();
 
-    return machineLines;
+            machineLines.push_back(std::move(line));
+        }
+
+        return machineLines;
+    });
 }
 
 std::vector<AssetDataManager::MachineData> AssetDataManager::LoadTypeData()
 {
-    std::vector<MachineData> result;
+    ConnectionGuardAMS connection(ConnectionType::Sync, /*preferReplica*/ true);
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_MT_SELECT_ALL_TYPES);
-    stmt->SetUInt(0, false);
-    auto queryResult = connection->ExecutePreparedSelect(*stmt);
+    return _typeDataCache.Get(*connection, {}, [](DatabaseConnection& conn) -> std::optional<std::vector<MachineData>>
+    {
+        auto stmt = conn.GetPreparedStatement(AMSPreparedStatement::DB_MT_SELECT_ALL_TYPES);
+        stmt->SetUInt(0, false);
+        auto queryResult = conn.ExecutePreparedSelect(*stmt);
 
-    if (!queryResult.IsValid())
-        return result;
+        if (!queryResult.IsValid())
+            return std::nullopt;
 
-    while (queryResult.Next())
-    {
-        MachineData type;
-        Field* fields = queryResult.Fetch();
+        std::vector<MachineData> result;
 
-        type.id = fields[0].GetUInt32();
-        type.name = fields[1].GetString();
+        while (queryResult.Next())
+        {
+            MachineData type;
+            Field* fields = queryResult.Fetch();
 
-        result.push_back(std::move(type));
-    }
+            type.id = fields[0].GetUInt32();
+            type.name = fields[1].GetString();
 
-    return result;
+            result.push_back(std::move(type));
+        }
+
+        return result;
+    });
 }
 
 std::vector<AssetDataManager::MachineData> AssetDataManager::LoadManufacturerData()
 {
-    std::vector<MachineData> result;
+    ConnectionGuardAMS connection(ConnectionType::Sync, /*preferReplica*/ true);
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_MM_SELECT_ALL_MANUFACTURERS);
-    stmt->SetUInt(0, false);
+    return _manufacturerDataCache.Get(*connection, {}, [](DatabaseConnection& conn) -> std::optional<std::vector<MachineData>>
+    {
+        auto stmt = conn.GetPreparedStatement(AMSPreparedStatement::DB_MM_SELECT_ALL_MANUFACTURERS);
+        stmt->SetUInt(0, false);
 
-    auto queryResult = connection->ExecutePreparedSelect(*stmt);
+        auto queryResult = conn.ExecutePreparedSelect(*stmt);
 
-    if (!queryResult.IsValid())
-        return result;
+        if (!queryResult.IsValid())
+            return std::nullopt;
 
-    while (queryResult.Next())
-    {
-        MachineData manufacturer;
-        Field* fields = queryResult.Fetch();
-        manufacturer.id = fields[0].GetUInt32();
-        manufacturer.name = fields[1].GetString();
+        std::vector<MachineData> result;
 
-        result.push_back(std::move(manufacturer));
-    }
+        while (queryResult.Next())
+        {
+            MachineData manufacturer;
+            Field* fields = queryResult.Fetch();
+            manufacturer.id = fields[0].GetUInt32();
+            manufacturer.name = fields[1].GetString();
 
-    return result;
+            result.push_back(std::move(manufacturer));
+        }
+
+        return result;
+    });
 }
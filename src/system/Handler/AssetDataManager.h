@@ -1,4 +1,5 @@
 #pragma once
+#include "ChangeProbe.h"
 #include "ChangeTracker.h"
 #include "LookupTableModel.h"
 #include "RoomTableModel.h"
@@ -116,4 +117,19 @@ private:
     std::vector<MachineData> LoadLineData(CompanyLocations cl);
     std::vector<MachineData> LoadTypeData();
     std::vector<MachineData> LoadManufacturerData();
+
+    // Reference tables rarely change; a read is reused while the table's version is unchanged
+    template <typename T>
+    using ReferenceCache = database::ProbedCache<std::vector<T>>;
+    static constexpr auto VersionProbe = database::Implementation::AMSPreparedStatement::DB_TV_SELECT_VERSION;
+
+    ReferenceCache<LookupTableModel::Row> _lineCache{"machine_line", VersionProbe};
+    ReferenceCache<LookupTableModel::Row> _typeCache{"machine_type", VersionProbe};
+    ReferenceCache<LookupTableModel::Row> _manufacturerCache{"machine_manufacturer", VersionProbe};
+    ReferenceCache<RoomTableModel::Row> _roomCache{"facility_room", VersionProbe};
+
+    ReferenceCache<MachineData> _lineDataCache{"machine_line", VersionProbe};
+    ReferenceCache<MachineData> _typeDataCache{"machine_type", VersionProbe};
+    ReferenceCache<MachineData> _manufacturerDataCache{"machine_manufacturer", VersionProbe};
+    ReferenceCache<MachineData> _roomDataCache{"facility_room", VersionProbe};
 };
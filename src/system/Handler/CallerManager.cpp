@@ -12,6 +12,11 @@ bool CallerManager::LoadCallerData()
 
     ConnectionGuardAMS connection(ConnectionType::Sync);
 
+    // callerMap is still current as long as caller_information was not written
+    const auto probe = _callerProbe.Check(*connection);
+    if (probe.unchanged)
+        return true;
+
     auto select = connection->GetPreparedStatement(AMSPreparedStatement::DB_CI_SELECT_ALL_CALLERS);
     auto result = connection->ExecutePreparedSelect(*select);
 
@@ -38,6 +43,8 @@ bool CallerManager::LoadCallerData()
         counter++;
     }
 
+    _callerProbe.MarkLoaded(probe);
+
     LOG_DEBUG("CallerManager::LoadCallerData: Loaded {} callers from database.", counter);
 
     return true;
@@ -1,4 +1,5 @@
 #pragma once
+#include "ChangeProbe.h"
 #include "DatabaseDefines.h"
 #include "Define.h"
 
@@ -23,5 +24,6 @@ private:
 
 
 	std::unordered_map<std::uint64_t, CallerInformation> callerMap;
+    database::ChangeProbe _callerProbe{"caller_information", database::Implementation::AMSPreparedStatement::DB_TV_SELECT_VERSION};
 };
 
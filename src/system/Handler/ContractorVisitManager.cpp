@@ -17,6 +17,12 @@ void ContractorVisitManager::LoadContractorVisitData()
     //"FROM contractor_visit"
 
     ConnectionGuardAMS connection(ConnectionType::Sync);
+
+    // the dashboard refreshes on a timer, most of the time nothing changed
+    const auto probe = _visitProbe.Check(*connection);
+    if (probe.unchanged)
+        return;
+
     auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_CV_SELECT_CONTRACTOR_VISITS);
 
     auto result = connection->ExecutePreparedSelect(*stmt);
@@ -58,6 +64,8 @@ void ContractorVisitManager::LoadContractorVisitData()
         LOG_DEBUG("Loaded data status is {}", static_cast<int>(row.status));
     }
 
+    _visitProbe.MarkLoaded(probe);
+
     LOG_DEBUG("Loaded {} contractor visit records", count);
 
 }
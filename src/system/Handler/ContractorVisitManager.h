@@ -1,6 +1,7 @@
 #pragma once
 #include <unordered_set>
 
+#include "ChangeProbe.h"
 #include "ConnectionGuard.h"
 #include "DatabaseDefines.h"
 
@@ -38,4 +39,5 @@ private:
     std::vector<ContractorVisitInformation> _contractorVisit;
     std::vector<ContractorVisitInformation> _activeVisit;
     std::unordered_map<std::uint64_t, ContractorVisitInformation> _visitByID;
+    database::ChangeProbe _visitProbe{"contractor_visit", database::Implementation::AMSPreparedStatement::DB_TV_SELECT_VERSION};
 };
@@ -3,6 +3,7 @@
 
 #include "ConnectionGuard.h"
 #include "DatabaseTypes.h"
+#include "TicketStore.h"
 #include "UserManagement.h"
 #include "pch.h"
 
@@ -11,7 +12,11 @@ CreateTicketManager::CreateTicketManager() : _lastTicketID(0)
 
 bool CreateTicketManager::SaveTicket(const TicketInformation& ticketInfo, const TicketAssignmentInformation& assignmentInfo)
 { 
-    return CreateNewTicket(ticketInfo) && CreateNewTicketAssignment(assignmentInfo);
+    const bool saved = CreateNewTicket(ticketInfo) && CreateNewTicketAssignment(assignmentInfo);
+
+    // Also after a failed assignment: the ticket row itself was inserted.
+    TicketStore::instance()->TicketWritten();
+    return saved;
 }
 
 bool CreateTicketManager::CreateNewTicket(const TicketInformation& ticketInfo)
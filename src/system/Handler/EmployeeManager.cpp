@@ -16,6 +16,10 @@ void EmployeeManager::LoadEmployeeData()
 
     ConnectionGuardAMS connection(ConnectionType::Sync);
 
+    const auto probe = _employeeProbe.Check(*connection);
+    if (probe.unchanged)
+        return;
+
     auto select = connection->GetPreparedStatement(AMSPreparedStatement::DB_EI_SELECT_ALL_EMPLOYEES);
     auto result = connection->ExecutePreparedSelect(*select);
 
@@ -42,6 +46,8 @@ void EmployeeManager::LoadEmployeeData()
         ++count;
     }
 
+    _employeeProbe.MarkLoaded(probe);
+
     LOG_DEBUG("EmployeeManager::LoadEmployeeData: Loaded {} employees from database.", count);
 }
 
@@ -1,4 +1,5 @@
 #pragma once
+#include "ChangeProbe.h"
 #include "DatabaseDefines.h"
 
 class EmployeeManager
@@ -24,6 +25,7 @@ private:
     std::uint32_t GetLastInsertEmployeeID(const EmployeeInformation& info);
 
 	std::unordered_map<std::uint32_t, EmployeeInformation> employeeMap;
+    database::ChangeProbe _employeeProbe{"employees", database::Implementation::AMSPreparedStatement::DB_TV_SELECT_VERSION};
 
 };
 
@@ -10,7 +10,11 @@ void MachineListManager::LoadMachineListFromDatabase()
 
     //         0         1          2           3        4              5            6                      7               8               9               10          11          12
     // SELECT ID, CostUnitID, MachineTypeID, LineID, ManufacturerID, MachineName, MachineNumber, ManufacturerMachineNumber, RoomNumber, MoreInformation, location, is_deleted, deleted_at  FROM machine_list
-    ConnectionGuardAMS connection(database::ConnectionType::Sync);
+    ConnectionGuardAMS connection(database::ConnectionType::Sync, /*preferReplica*/ true);
+
+    const auto probe = _machineProbe.Check(*connection);
+    if (probe.unchanged)
+        return;
 
     auto statement = connection->GetPreparedStatement(AMSPreparedStatement::DB_ML_SELECT_ALL_MACHINES);
     auto result = connection->ExecutePreparedSelect(*statement);
@@ -43,6 +47,8 @@ void MachineListManager::LoadMachineListFromDatabase()
         _machineVector.push_back(machineInfo);
         _indexById[machineInfo.ID] = _machineVector.size() - 1;
     }
+
+    _machineProbe.MarkLoaded(probe);
 }
 
 const MachineInformation* MachineListManager::GetById(std::uint32_t id) const
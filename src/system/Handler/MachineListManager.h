@@ -1,4 +1,5 @@
 #pragma once
+#include "ChangeProbe.h"
 #include "DatabaseDefines.h"
 
 class MachineListManager
@@ -20,5 +21,6 @@ private:
 
     std::vector<MachineInformation> _machineVector;
     std::unordered_map<std::uint32_t, std::size_t> _indexById;
+    database::ChangeProbe _machineProbe{"machine_list", database::Implementation::AMSPreparedStatement::DB_TV_SELECT_VERSION};
 };
 
@@ -1,17 +1,21 @@
 #include "pch.h"
 #include "ShowTicketDetailManager.h"
 
+#include "Implementation/AMSStatementSignatures.h"
+#include "TicketStore.h"
 #include "UserManagement.h"
 
-ShowTicketDetailManager::ShowTicketDetailManager() : _ticketManager(nullptr)
+ShowTicketDetailManager::ShowTicketDetailManager()
 {}
 
-void ShowTicketDetailManager::LoadTicketDetails(std::uint64_t ticketID)
+QueryFuture<TicketDetailsPtr> ShowTicketDetailManager::LoadTicketDetailsAsync(std::uint64_t ticketID)
 {
-    if (!_ticketManager)
-        _ticketManager = std::make_unique<ShowTicketManager>();
+    return ShowTicketManager::LoadTicketDetailsAsync(ticketID);
+}
 
-    _ticketData = _ticketManager->LoadTicketDetails(ticketID);
+void ShowTicketDetailManager::SetTicketData(const ShowTicketData& data)
+{
+    _ticketData = data;
     BuildTimeline(_ticketData);
 }
 
@@ -27,7 +31,8 @@ void ShowTicketDetailManager::AddNewComment(std::uint64_t ticketID, const QStrin
     stmt->SetBool(3, is_internal);
     stmt->SetQString(4, comment);
 
-    connection->ExecutePreparedInsert(*stmt);
+    if (connection->ExecutePreparedInsert(*stmt))
+        TicketStore::instance()->TicketWritten();
 }
 
 void ShowTicketDetailManager::RemoveComment(std::uint64_t ID)
@@ -36,12 +41,8 @@ void ShowTicketDetailManager::RemoveComment(std::uint64_t ID)
 
     ConnectionGuardAMS connection(ConnectionType::Sync);
 
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TC_UPDATE_COMMENT_MARK_AS_DELETED);
-    stmt->SetUInt(0, GetUser().GetUserID());
-    stmt->SetCurrentDate(1);
-    stmt->SetUInt64(2, ID);
-
-    connection->ExecutePreparedUpdate(*stmt);
+    ExecuteTyped<AMSPreparedStatement::DB_TC_UPDATE_COMMENT_MARK_AS_DELETED>(*connection, GetUser().GetUserID(), std::chrono::system_clock::now(), ID);
+    TicketStore::instance()->TicketWritten();
 }
 
 void ShowTicketDetailManager::FillTicketStatusBox(QComboBox* cb)
@@ -106,48 +107,98 @@ void ShowTicketDetailManager::FillTicketPriorityBox(QComboBox* cb)
     }
 }
 
-void ShowTicketDetailManager::UpdatePriority(std::uint64_t ticketID, const TicketPriority& newPriority)
+ShowTicketDetailManager::SqlUpdate ShowTicketDetailManager::BuildTicketUpdateSql(std::uint64_t ticketID, std::uint32_t rowVersion,
+                                                                                  const ChangeTracker<TicketField>& tracker)
 {
-    ConnectionGuardAMS connection(ConnectionType::Async);
+    SqlUpdate out;
 
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_PRIORITY_BY_ID);
-    stmt->SetUInt(0, static_cast<std::uint32_t>(newPriority));
-    stmt->SetUInt64(1, ticketID);
+    const auto dirty = tracker.GetDirtyFields();
+    if (dirty.isEmpty())
+        return out;
 
-    connection->ExecutePreparedUpdate(*stmt);
-}
+    std::string setPart;
+    std::vector<QVariant> params;
 
-void ShowTicketDetailManager::UpdateStatus(std::uint64_t ticketID, const TicketStatus& newStatus)
-{
-    ConnectionGuardAMS connection(ConnectionType::Async);
+    // enum order, so the same set of fields always yields the same statement text
+    for (std::uint8_t i = 0; i < static_cast<std::uint8_t>(TicketField::Max); ++i)
+    {
+        const auto field = static_cast<TicketField>(i);
+        if (!dirty.contains(field))
+            continue;
 
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_STATUS_BY_ID);
-    stmt->SetUInt(0, static_cast<std::uint32_t>(newStatus));
-    stmt->SetUInt64(1, ticketID);
+        const char* col = TicketFieldToColumn(field);
+        if (col[0] == '\0')
+            continue;
 
-    connection->ExecutePreparedUpdate(*stmt);
-}
+        if (!setPart.empty())
+            setPart += ", ";
 
-bool ShowTicketDetailManager::UpdateTicketTitle(std::uint64_t ticketID, const QString& newTitle)
-{
-    ConnectionGuardAMS connection(ConnectionType::Async);
+        setPart += col;
+        setPart += " = ?";
+
+        params.push_back(tracker.GetCurrentValue(field));
+
+        if (field == TicketField::Status)
+            setPart += ", last_status_change_at = NOW()";
+    }
+
+    if (setPart.empty())
+        return out;
 
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_TITLE_BY_ID);
-    stmt->SetQString(0, newTitle);
-    stmt->SetUInt64(1, ticketID);
+    out.sql = "UPDATE tickets SET " + setPart + ", updated_by_user = ?, row_version = row_version + 1 WHERE ID = ? AND row_version = ?";
+    out.params = std::move(params);
+    out.params.emplace_back(GetUser().GetUserID());
+    out.params.emplace_back(static_cast<qulonglong>(ticketID));
+    out.params.emplace_back(rowVersion);
 
-    return connection->ExecutePreparedUpdate(*stmt);
+    return out;
 }
 
-bool ShowTicketDetailManager::UpdateTicketDescription(std::uint64_t ticketID, const QString& newDescription)
+TicketSaveResult ShowTicketDetailManager::SaveTicketChanges(std::uint64_t ticketID, std::uint32_t& rowVersion, const ChangeTracker<TicketField>& tracker)
 {
-    ConnectionGuardAMS connection(ConnectionType::Async);
+    auto sqlUpdate = BuildTicketUpdateSql(ticketID, rowVersion, tracker);
+    if (sqlUpdate.sql.empty())
+        return TicketSaveResult::NoChanges;
+
+    ConnectionGuardAMS connection(ConnectionType::Sync);
+
+    auto stmt = connection->GetStatementRaw(sqlUpdate.sql);
+
+    for (std::size_t i = 0; i < sqlUpdate.params.size(); ++i)
+    {
+        stmt->SetQVariant(i, sqlUpdate.params[i]);
+    }
+
+    if (!connection->ExecutePreparedUpdate(*stmt))
+        return TicketSaveResult::Failed;
 
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_DESCRIPTION_BY_ID);
-    stmt->SetQString(0, newDescription);
-    stmt->SetUInt64(1, ticketID);
+    // row_version always changes, so a matched row is always an affected row
+    if (connection->GetAffectedRows() == 0)
+    {
+        LOG_INFO("Ticket {} was changed by someone else since version {}, save rejected", ticketID, rowVersion);
+        return TicketSaveResult::Conflict;
+    }
+
+    ++rowVersion;
+    TicketStore::instance()->TicketWritten();
+    return TicketSaveResult::Saved;
+}
 
-    return connection->ExecutePreparedUpdate(*stmt);
+const char* ShowTicketDetailManager::TicketFieldToColumn(TicketField field)
+{
+    switch (field)
+    {
+        case TicketField::Status:
+            return "current_status";
+        case TicketField::Priority:
+            return "priority";
+        case TicketField::Title:
+            return "title";
+        case TicketField::Description:
+            return "description";
+        default:
+            return "";
+    }
 }
 
 QString ShowTicketDetailManager::LoadMachineLineName(std::uint32_t lineID)
@@ -173,14 +224,16 @@ QString ShowTicketDetailManager::LoadManufacturerName(std::uint32_t manufacturer
 void ShowTicketDetailManager::CloseTicket(std::uint64_t ticketID)
 {
     // simply we set current_status and closed_at
-    // UPDATE tickets Set current_status = ?, closed_at = ? WHERE ID = ?
+    // UPDATE tickets SET current_status = ?, closed_at = ?, updated_by_user = ?, row_version = row_version + 1 WHERE ID = ?
     ConnectionGuardAMS connection(ConnectionType::Async);
     auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_UPDATE_TICKET_TO_CLOSED_BY_ID);
     stmt->SetUInt(0, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_CLOSED));
     stmt->SetCurrentDate(1);
-    stmt->SetUInt64(2, ticketID);
+    stmt->SetUInt(2, GetUser().GetUserID());
+    stmt->SetUInt64(3, ticketID);
 
-    void(connection->ExecutePreparedUpdate(*stmt));
+    if (connection->ExecutePreparedUpdate(*stmt))
+        TicketStore::instance()->TicketWritten();
 }
 
 
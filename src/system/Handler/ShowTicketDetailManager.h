@@ -1,16 +1,34 @@
 #pragma once
+#include "ChangeTracker.h"
 #include "ShowTicketManager.h"
 
 #include <QString>
 
+enum class TicketSaveResult : std::uint8_t
+{
+    Saved,
+    NoChanges,
+    Conflict,   // saved by someone else since it was loaded, nothing written
+    Failed
+};
+
 class ShowTicketDetailManager
 {
 public:
+    struct SqlUpdate
+    {
+        std::string sql;
+        std::vector<QVariant> params;
+    };
+
 	ShowTicketDetailManager();
     ~ShowTicketDetailManager() = default;
 
-	void LoadTicketDetails(std::uint64_t ticketID);
+    QueryFuture<TicketDetailsPtr> LoadTicketDetailsAsync(std::uint64_t ticketID);
+    // Takes over data delivered by LoadTicketDetailsAsync; call on the GUI thread.
+    void SetTicketData(const ShowTicketData& data);
     ShowTicketData GetTicketData() const { return _ticketData; }
+    const ShowTicketData& GetTicketDataRef() const { return _ticketData; }
 
     void AddNewComment(std::uint64_t ticketID, const QString& comment, bool is_internal = true);
     void RemoveComment(std::uint64_t ID);
@@ -18,11 +36,12 @@ public:
     void FillTicketStatusBox(QComboBox* cb);
     void FillTicketPriorityBox(QComboBox* cb);
 
-    void UpdatePriority(std::uint64_t ticketID, const TicketPriority& newPriority);
-    void UpdateStatus(std::uint64_t ticketID, const TicketStatus& newStatus);
-
-    bool UpdateTicketTitle(std::uint64_t ticketID, const QString& newTitle);
-    bool UpdateTicketDescription(std::uint64_t ticketID, const QString& newDescription);
+    // Writes all dirty fields with one UPDATE, guarded by the row version the ticket was
+    // loaded with; the history entry is written by the server in the same statement.
+    // On success rowVersion is advanced to the stored version.
+    TicketSaveResult SaveTicketChanges(std::uint64_t ticketID, std::uint32_t& rowVersion, const ChangeTracker<TicketField>& tracker);
+    static SqlUpdate BuildTicketUpdateSql(std::uint64_t ticketID, std::uint32_t rowVersion, const ChangeTracker<TicketField>& tracker);
+    static const char* TicketFieldToColumn(TicketField field);
 
     QString LoadMachineLineName(std::uint32_t lineID);
     QString LoadMachineTypeName(std::uint32_t typeID);
@@ -44,7 +63,6 @@ private:
     QString LoadNameByID(AMSPreparedStatement stmt, std::uint32_t id);
 
 	ShowTicketData _ticketData;
-    std::unique_ptr<ShowTicketManager> _ticketManager;
 
 
 };
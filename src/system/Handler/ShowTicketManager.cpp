@@ -6,26 +6,97 @@
 #include "ConnectionGuard.h"
 #include "CostUnitDataHandler.h"
 #include "DatabaseTypes.h"
+#include "Implementation/AMSStatementSignatures.h"
+#include "SingleFlight.h"
+#include "TicketDetailCache.h"
 #include "pch.h"
 
+namespace
+{
+    // Every ticket view refreshes the same overview; views opened together share one read.
+    constexpr std::chrono::seconds OverviewReuseWindow{3};
+
+    SingleFlightGroup<std::vector<TicketRowData>>& OverviewFlight()
+    {
+        static SingleFlightGroup<std::vector<TicketRowData>> group;
+        return group;
+    }
+
+    SingleFlightGroup<TicketDetailsPtr>& DetailsFlight()
+    {
+        static SingleFlightGroup<TicketDetailsPtr> group;
+        return group;
+    }
+
+    ReadKey DetailsKey(std::uint64_t ticketID)
+    {
+        return MakeReadKey(AMSPreparedStatement::DB_TICKET_SELECT_ALL_TICKETS, ticketID);
+    }
+
+    // Search tokens match literally; goes with LIKE ... ESCAPE '!'.
+    std::string LikeContainsPattern(const QString& token)
+    {
+        std::string pattern = "%";
+        for (char c : token.toStdString())
+        {
+            if (c == '!' || c == '%' || c == '_')
+                pattern += '!';
+            pattern += c;
+        }
+        pattern += '%';
+        return pattern;
+    }
+}
+
 ShowTicketManager::ShowTicketManager() {}
 
 
 void ShowTicketManager::LoadTableTicketData()
 {
+    _ticketRowDataList = LoadTableTicketRows();
+}
+
+std::vector<TicketRowData> ShowTicketManager::LoadTableTicketRows()
+{
+    auto rows = OverviewFlight().Do(MakeReadKey(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT), &ShowTicketManager::QueryTicketOverview,
+                                    OverviewReuseWindow);
+    return *rows;
+}
+
+void ShowTicketManager::InvalidateTicketOverview()
+{
+    OverviewFlight().Invalidate(MakeReadKey(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT));
+}
+
+void ShowTicketManager::InvalidateTicketDetails()
+{
+    DetailsFlight().Clear();
+}
+
+std::vector<TicketRowData> ShowTicketManager::QueryTicketOverview()
+{
+    // Primary only: the sync point taken before this load assumes the rows are
+    // current, a lagging replica would hide writes from every later delta.
     ConnectionGuardAMS connection(ConnectionType::Sync);
     auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT);
+    stmt->SetUInt(0, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_RESOLVED));
+    stmt->SetUInt(1, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_CLOSED));
 
     auto result = connection->ExecutePreparedSelect(*stmt);
 
     if (!result.IsValid())
-    {
-        // TODO: log error
-        return;
-    }
+        return {};
+
+    return ReadTicketRows(result, /*withLastComment*/ true);
+}
 
-    std::unordered_map<std::uint64_t, TicketRowData> rowMap;
-    rowMap.reserve(128);
+std::vector<TicketRowData> ShowTicketManager::ReadTicketRows(QueryResult& result, bool withLastComment)
+{
+    // Columns as in DB_TICKET_OVERVIEW_SELECT_SINCE, one row per current assignee.
+    // Rows keep the order of their first appearance.
+    std::vector<TicketRowData> rows;
+    std::unordered_map<std::uint64_t, std::size_t> indexById;
+    indexById.reserve(128);
 
     while (result.Next())
     {
@@ -33,25 +104,20 @@ void ShowTicketManager::LoadTableTicketData()
 
         const std::uint64_t ticketId = f[0].GetUInt64();
 
-        auto it = rowMap.find(ticketId);
-        if (it == rowMap.end())
+        auto it = indexById.find(ticketId);
+        if (it == indexById.end())
         {
             TicketRowData row{};
 
             row.id = ticketId;
             row.title = f[1].GetString();
-            if (!f[2].IsNull())
-                row.area = f[2].GetString();
-            else
-                row.area = {};
+            row.area = !f[2].IsNull() ? f[2].GetString() : std::string{};
 
             row.createdAt = f[3].GetDateTime();
             row.updatedAt = f[4].GetDateTime();
 
-            if (!f[5].IsNull())
-                row.status = static_cast<TicketStatus>(f[5].GetUInt8());
-            else
-                row.status = TicketStatus::TICKET_STATUS_NONE;
+            row.status =
+                !f[5].IsNull() ? static_cast<TicketStatus>(f[5].GetUInt8()) : TicketStatus::TICKET_STATUS_NONE;
 
             row.priority = static_cast<TicketPriority>(f[6].GetUInt8());
 
@@ -59,13 +125,10 @@ void ShowTicketManager::LoadTableTicketData()
             {
                 const std::uint16_t costUnitId = f[7].GetUInt16();
                 row.costUnitName = CostUnitDataHandler::instance().GetCostUnitNameByInternalId(costUnitId);
-                std::string test{};
             }
-            else
-                row.costUnitName = {};
 
             {
-                std::string reporterName = f[8].GetString();
+                std::string reporterName = !f[8].IsNull() ? f[8].GetString() : std::string{};
                 if (!f[9].IsNull())
                 {
                     std::string reporterPhone = f[9].GetString();
@@ -76,43 +139,29 @@ void ShowTicketManager::LoadTableTicketData()
                         reporterName.push_back(')');
                     }
                 }
-
                 row.reporterName = std::move(reporterName);
             }
 
-            if (!f[10].IsNull())
-                row.machineName = f[10].GetString();
-            else
-                row.machineName.clear();
+            row.machineName = !f[10].IsNull() ? f[10].GetString() : std::string{};
 
-            if (!f[14].IsNull())
+            if (withLastComment && !f[14].IsNull())
                 row.lastComment = f[14].GetString();
-            else
-                row.lastComment.clear();
 
-            // Insert into map and get iterator
-            auto [newIt, inserted] = rowMap.emplace(ticketId, std::move(row));
-            it = newIt;
+            it = indexById.emplace(ticketId, rows.size()).first;
+            rows.push_back(std::move(row));
         }
 
-        // Employees (can be multiple rows per ticket)
+        // Current employees (can be multiple rows per ticket)
         if (!f[11].IsNull() || !f[12].IsNull())
         {
-            std::string firstName;
-            std::string lastName;
-            std::string phone;
-
-            if (!f[11].IsNull())
-                firstName = f[11].GetString();
-            if (!f[12].IsNull())
-                lastName = f[12].GetString();
-
-            phone = f[13].GetString();
+            std::string firstName = !f[11].IsNull() ? f[11].GetString() : std::string{};
+            std::string lastName = !f[12].IsNull() ? f[12].GetString() : std::string{};
+            std::string phone = !f[13].IsNull() ? f[13].GetString() : std::string{};
 
             if (!firstName.empty() || !lastName.empty())
             {
                 std::string fullName;
-                fullName.reserve(firstName.size() + 1 + lastName.size());
+                fullName.reserve(firstName.size() + 1 + lastName.size() + 16);
 
                 if (!firstName.empty())
                 {
@@ -130,26 +179,50 @@ void ShowTicketManager::LoadTableTicketData()
                     fullName.append(phone);
                     fullName.push_back(')');
                 }
-         
-                auto& vec = it->second.employeeAssigned;
+
+                auto& vec = rows[it->second].employeeAssigned;
                 if (std::ranges::find(vec, fullName) == vec.end())
                     vec.push_back(std::move(fullName));
             }
         }
     }
 
-    // Move map content into vector for the model
-    _ticketRowDataList.clear();
-    _ticketRowDataList.reserve(rowMap.size());
-    for (auto& row : rowMap | std::views::values)
-        _ticketRowDataList.push_back(std::move(row));
+    return rows;
 }
 
-ShowTicketData ShowTicketManager::LoadTicketDetails(std::uint64_t ticketID)
+TicketDetailsPtr ShowTicketManager::LoadTicketDetails(std::uint64_t ticketID)
 {
-    ShowTicketData data;
+    // Several detail windows may open the same ticket at once
+    auto shared = DetailsFlight().Do(DetailsKey(ticketID),
+                                     [ticketID]()
+                                     {
+                                         ConnectionGuardAMS connection(ConnectionType::Sync);
+                                         return LoadTicketDetailsCached(ticketID, *connection);
+                                     });
+
+    return *shared;
+}
 
-    ConnectionGuardAMS connection(ConnectionType::Sync);
+TicketDetailsPtr ShowTicketManager::LoadTicketDetailsCached(std::uint64_t ticketID, DatabaseConnection& connection)
+{
+    // Probe first: a change committed while loading only makes the next probe miss.
+    std::string version = QueryTicketDetailVersion(ticketID, connection);
+
+    auto& cache = TicketDetailCache::instance();
+    if (auto cached = cache.Lookup(ticketID); cached && !version.empty() && cached->version == version)
+        return cached->data;
+
+    auto data = std::make_shared<const ShowTicketData>(QueryTicketDetails(ticketID, connection));
+
+    if (!version.empty())
+        cache.Store(ticketID, std::move(version), data);
+
+    return data;
+}
+
+ShowTicketData ShowTicketManager::QueryTicketDetails(std::uint64_t ticketID, DatabaseConnection& connection)
+{
+    ShowTicketData data;
 
     LoadTicketData(ticketID, data.ticketInfo, connection);
     LoadTicketAssignments(ticketID, data.ticketAssignment, connection);
@@ -158,23 +231,62 @@ ShowTicketData ShowTicketManager::LoadTicketDetails(std::uint64_t ticketID)
     LoadTicketStatusHistory(ticketID, data.ticketStatusHistory, connection);
     LoadCallerInformation(static_cast<std::uint16_t>(data.ticketInfo.reporterID), data.callerInfo, connection);
     LoadTicketSpareData(ticketID, data.sparePartsUsed, connection);
+    LoadAssignedEmployees(data.ticketAssignment, data.employeeInfo, connection);
+    LoadMachineData(data.ticketInfo.entityID, data.machineInfo, connection);
 
-    std::unordered_set<uint32_t> employeeIds;
+    return data;
+}
+
+std::string ShowTicketManager::QueryTicketDetailVersion(std::uint64_t ticketID, DatabaseConnection& connection)
+{
+    auto stmt = connection.GetPreparedStatement(AMSPreparedStatement::DB_TICKET_SELECT_DETAIL_VERSION);
+    stmt->SetUInt64(0, ticketID);
+
+    auto result = connection.ExecutePreparedSelect(*stmt);
+    if (!result.IsValid() || !result.Next())
+        return {};
+
+    Field* f = result.Fetch();
+    return f[0].IsNull() ? std::string{} : f[0].GetString();
+}
 
-    for (const auto& a : data.ticketAssignment)
+TicketDetailsPtr ShowTicketManager::PeekTicketDetails(std::uint64_t ticketID)
+{
+    auto cached = TicketDetailCache::instance().Lookup(ticketID);
+    return cached ? cached->data : nullptr;
+}
+
+void ShowTicketManager::PrefetchTicketDetails(const std::vector<std::uint64_t>& ticketIDs)
+{
+    auto& cache = TicketDetailCache::instance();
+
+    for (const auto ticketID : ticketIDs)
     {
-        if (a.employeeID != 0)
-            employeeIds.insert(a.employeeID);
-    }
-    
-    for (auto id : employeeIds)
-        LoadEmployees(id, data.employeeInfo, connection);
+        if (!cache.BeginPrefetch(ticketID))
+            continue;
 
-    LoadMachineData(data.ticketInfo.entityID, data.machineInfo, connection);
+        auto future = AMSDatabase::QueryAsync(ConnectionType::Sync, [ticketID](DatabaseConnection& connection)
+                                              { return LoadTicketDetailsCached(ticketID, connection) != nullptr; });
 
-    _fullTicketData = data;
+        // Releases the slot whether the prefetch ran, failed or was dropped
+        future.State()->OnComplete([ticketID]() { TicketDetailCache::instance().EndPrefetch(ticketID); });
+    }
+}
 
-    return data;
+QueryFuture<TicketDetailsPtr> ShowTicketManager::LoadTicketDetailsAsync(std::uint64_t ticketID)
+{
+    // One lease for the whole ticket: the version probe decides whether the
+    // cached snapshot is still current, otherwise all parts load on the same
+    // connection. Splitting the parts over several leases starves the pool
+    // when many details open at once.
+    // Shares the flight of the sync path: windows opening the same ticket
+    // together run one load, the others wait for it.
+    return AMSDatabase::QueryAsync(ConnectionType::Sync,
+        [ticketID](DatabaseConnection& connection)
+        {
+            return *DetailsFlight().Do(DetailsKey(ticketID),
+                                       [ticketID, &connection]() { return LoadTicketDetailsCached(ticketID, connection); });
+        });
 }
 
 const std::unordered_map<std::uint64_t, ShowTicketData>& ShowTicketManager::GetTicketDataMap() const
@@ -198,15 +310,15 @@ ShowTicketData ShowTicketManager::GetTicketDataByID(std::uint64_t ticketID)
     return ShowTicketData{}; 
 }
 
-void ShowTicketManager::LoadTicketData(std::uint64_t ticketID, TicketInformation& ticketInfo, const ConnectionGuardAMS& connection)
+void ShowTicketManager::LoadTicketData(std::uint64_t ticketID, TicketInformation& ticketInfo, DatabaseConnection& connection)
 {
     // SELECT creator_user_id, created_at, current_status, cost_unit_id, area, reporter_id, entity.id, "
-    // "title, description, priority, updated_at, closed_at, last_status_changed_at FROM tickets WHERE ID = ?
+    // "title, description, priority, updated_at, closed_at, last_status_changed_at, row_version FROM tickets WHERE ID = ?
 
-    auto stmt = connection->GetPreparedStatement(database::Implementation::AMSPreparedStatement::DB_TICKET_SELECT_ALL_TICKETS);
+    auto stmt = connection.GetPreparedStatement(database::Implementation::AMSPreparedStatement::DB_TICKET_SELECT_ALL_TICKETS);
     stmt->SetUInt64(0, ticketID);
 
-    auto result = connection->ExecutePreparedSelect(*stmt);
+    auto result = connection.ExecutePreparedSelect(*stmt);
 
     if (!result.IsValid())
     {
@@ -231,180 +343,44 @@ void ShowTicketManager::LoadTicketData(std::uint64_t ticketID, TicketInformation
         ticketInfo.updatedAt = fields[10].GetDateTime();
         ticketInfo.closedAt = fields[11].GetDateTime();
         ticketInfo.lastStatusChangeAt = fields[12].GetDateTime();
+        ticketInfo.rowVersion = fields[13].GetUInt32();
     }
 }
 
 
-void ShowTicketManager::LoadTicketAssignments(std::uint64_t ticketID, std::vector<TicketAssignmentInformation>& ticketAssignment, const ConnectionGuardAMS& connection)
+void ShowTicketManager::LoadTicketAssignments(std::uint64_t ticketID, std::vector<TicketAssignmentInformation>& ticketAssignment, DatabaseConnection& connection)
 {
     // SELECT ticket_id, employee_id, assigned_at, unassigned_at, is_current, comment_assigned, comment_unassigned, assigned_by_user_id, unassigned_by_user_id FROM ticket_assignment WHERE ticket_id = ?
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TA_SELECT_TICKET_ASSIGNMENTS_BY_TICKET_ID);
-    stmt->SetUInt64(0, ticketID);
-
-    auto result = connection->ExecutePreparedSelect(*stmt);
-
-    if (!result.IsValid())
-    {
-        // log error
-        return;
-    }
-
-    while (result.Next())
-    {
-        Field* fields = result.Fetch();
-        TicketAssignmentInformation assignmentInfo;
-        assignmentInfo.ticketID = fields[0].GetUInt64();
-        assignmentInfo.employeeID = fields[1].GetUInt32();
-        assignmentInfo.assignedAt = fields[2].GetDateTime();
-        assignmentInfo.unassignedAt = fields[3].GetDateTime();
-        assignmentInfo.isCurrent = fields[4].GetBool();
-        assignmentInfo.commentAssigned = fields[5].GetString();
-        assignmentInfo.commentUnassigned = fields[6].GetString();
-        assignmentInfo.assignedByUserID = fields[7].GetUInt32();
-        assignmentInfo.unassignedByUserID = fields[8].GetUInt32();
-
-        ticketAssignment.push_back(std::move(assignmentInfo));
-    }
+    ticketAssignment = *QueryTypedShared<AMSPreparedStatement::DB_TA_SELECT_TICKET_ASSIGNMENTS_BY_TICKET_ID>(connection, {}, ticketID);
 }
 
-void ShowTicketManager::LoadTicketAttachments(std::uint64_t ticketID, std::vector<TicketAttachmentInformation>& ticketAttachment, const ConnectionGuardAMS& connection)
+void ShowTicketManager::LoadTicketAttachments(std::uint64_t ticketID, std::vector<TicketAttachmentInformation>& ticketAttachment, DatabaseConnection& connection)
 {
-
     // SELECT id, ticket_id, uploader_user_id, uploaded_at, original_filename, stored_file_name, file_path, mime_type,
     // file_size, description, is_deleted FROM ticket_attachment WHERE ticket_id = ?
-
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TATT_SELECT_TICKET_ATTACHMENTS_BY_TICKET_ID);
-    stmt->SetUInt64(0, ticketID);
-
-    auto result = connection->ExecutePreparedSelect(*stmt);
-
-    if (!result.IsValid())
-    {
-        // log error
-        return;
-    }
-
-    while (result.Next())
-    {
-        Field* fields = result.Fetch();
-        TicketAttachmentInformation attachmentInfo;
-        attachmentInfo.id = fields[0].GetUInt64();
-        attachmentInfo.ticketID = fields[1].GetUInt64();
-        attachmentInfo.uploaderUserID = fields[2].GetUInt32();
-        attachmentInfo.uploadedAt = fields[3].GetDateTime();
-        attachmentInfo.originalFilename = fields[4].GetString();
-        attachmentInfo.storedFileName = fields[5].GetString();
-        attachmentInfo.filePath = fields[6].GetString();
-
-        if (!fields[7].IsNull())
-            attachmentInfo.mimeType = fields[7].GetString();            
-        else
-            attachmentInfo.mimeType = {};
-
-        if (!fields[8].IsNull())
-            attachmentInfo.fileSize = fields[8].GetUInt64();
-        else
-            attachmentInfo.fileSize = 0;
-
-        if (!fields[9].IsNull())
-            attachmentInfo.description = fields[9].GetString();
-        else
-            attachmentInfo.description = {};
-        attachmentInfo.isDeleted = fields[10].GetBool();
-
-        ticketAttachment.push_back(std::move(attachmentInfo));
-    }
+    ticketAttachment = *QueryTypedShared<AMSPreparedStatement::DB_TATT_SELECT_TICKET_ATTACHMENTS_BY_TICKET_ID>(connection, {}, ticketID);
 }
 
-void ShowTicketManager::LoadTicketComments(std::uint64_t ticketID, std::vector<TicketCommentInformation>& ticketComment, const ConnectionGuardAMS& connection)
+void ShowTicketManager::LoadTicketComments(std::uint64_t ticketID, std::vector<TicketCommentInformation>& ticketComment, DatabaseConnection& connection)
 {
     // SELECT id, ticket_id, author_user_id, created_at, updated_at, is_internal, is_deleted, message, delete_user_id, delete_at FROM ticket_comments WHERE ticket_id = ?
-
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TC_SELECT_TICKET_COMMENTS_BY_TICKET_ID);
-    stmt->SetUInt64(0, ticketID);
-
-    auto result = connection->ExecutePreparedSelect(*stmt);
-
-    if (!result.IsValid())
-    {
-
-        return;
-    }
-
-    while (result.Next())
-    {
-        Field* fields = result.Fetch();
-        TicketCommentInformation commentInfo;
-        commentInfo.id = fields[0].GetUInt64();
-        commentInfo.ticketID = fields[1].GetUInt64();
-        commentInfo.authorUserID = fields[2].GetUInt32();
-        commentInfo.createdAt = fields[3].GetDateTime();
-
-        if (!fields[4].IsNull())
-            commentInfo.updatedAt = fields[4].GetDateTime();
-        else
-            commentInfo.updatedAt = {};
-
-        commentInfo.isInternal = fields[5].GetBool();
-        commentInfo.isDeleted = fields[6].GetBool();
-        commentInfo.message = fields[7].GetString();
-        commentInfo.deleterUserID = fields[8].GetUInt32();        
-        commentInfo.deleteAt = fields[9].GetDateTime();
-
-        ticketComment.push_back(std::move(commentInfo));
-    }
+    ticketComment = *QueryTypedShared<AMSPreparedStatement::DB_TC_SELECT_TICKET_COMMENTS_BY_TICKET_ID>(connection, {}, ticketID);
 }
 
-void ShowTicketManager::LoadTicketStatusHistory(std::uint64_t ticketID, std::vector<TicketStatusHistoryInformation>& ticketStatusHistory, const ConnectionGuardAMS& connection)
+void ShowTicketManager::LoadTicketStatusHistory(std::uint64_t ticketID, std::vector<TicketStatusHistoryInformation>& ticketStatusHistory, DatabaseConnection& connection)
 {
-
     // SELECT id, ticket_id, old_status, new_status, changed_at, changed_by_user, comment FROM ticket_status_history WHERE ticket_id = ?
-
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TSH_SELECT_TICKET_STATUS_HISTORY_BY_TICKET_ID);
-    stmt->SetUInt64(0, ticketID);
-
-    auto result = connection->ExecutePreparedSelect(*stmt);
-
-    if (!result.IsValid())
-    {
-        // todo log
-        return;
-    }
-
-    while (result.Next())
-    {
-        Field* fields = result.Fetch();
-        TicketStatusHistoryInformation statusHistoryInfo;
-        statusHistoryInfo.id = fields[0].GetUInt64();
-        statusHistoryInfo.ticketID = fields[1].GetUInt64();
-
-        if (!fields[2].IsNull())
-            statusHistoryInfo.oldStatus = fields[2].GetUInt8();
-        else
-            statusHistoryInfo.oldStatus = 0;
-
-        statusHistoryInfo.newStatus = fields[3].GetUInt8();
-        statusHistoryInfo.changedAt = fields[4].GetDateTime();
-        statusHistoryInfo.changedByUserID = fields[5].GetUInt32();
-
-        if (!fields[6].IsNull())
-            statusHistoryInfo.comment = fields[6].GetString();
-        else
-            statusHistoryInfo.comment = {};
-
-        ticketStatusHistory.push_back(std::move(statusHistoryInfo));
-    }
-    
+    ticketStatusHistory = *QueryTypedShared<AMSPreparedStatement::DB_TSH_SELECT_TICKET_STATUS_HISTORY_BY_TICKET_ID>(connection, {}, ticketID);
 }
 
-void ShowTicketManager::LoadCallerInformation(std::uint16_t callerID, CallerInformation& callerInfo, const ConnectionGuardAMS& connection)
+void ShowTicketManager::LoadCallerInformation(std::uint16_t callerID, CallerInformation& callerInfo, DatabaseConnection& connection)
 {
     // SELECT id, department, phone, name, costUnit, location, is_active FROM caller_information WHERE id = ?
 
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_CI_SELECT_CALLER_BY_ID);
+    auto stmt = connection.GetPreparedStatement(AMSPreparedStatement::DB_CI_SELECT_CALLER_BY_ID);
     stmt->SetUInt(0, callerID);
 
-    auto result = connection->ExecutePreparedSelect(*stmt);
+    auto result = connection.ExecutePreparedSelect(*stmt);
 
     if (!result.IsValid())
     {
@@ -433,14 +409,14 @@ void ShowTicketManager::LoadCallerInformation(std::uint16_t callerID, CallerInfo
     }
 }
 
-void ShowTicketManager::LoadEmployees(std::uint32_t employeeID, std::vector<EmployeeInformation>& employeeInfo, const ConnectionGuardAMS& connection)
+void ShowTicketManager::LoadEmployees(std::uint32_t employeeID, std::vector<EmployeeInformation>& employeeInfo, DatabaseConnection& connection)
 {
     // SELECT id, firstName, lastName, phone, location, isActive FROM employees WHERE id = ?
 
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_EI_SELECT_EMPLOYEE_BY_ID);
+    auto stmt = connection.GetPreparedStatement(AMSPreparedStatement::DB_EI_SELECT_EMPLOYEE_BY_ID);
     stmt->SetUInt(0, employeeID);
 
-    auto result = connection->ExecutePreparedSelect(*stmt);
+    auto result = connection.ExecutePreparedSelect(*stmt);
 
     if (!result.IsValid())
     {
@@ -466,14 +442,29 @@ void ShowTicketManager::LoadEmployees(std::uint32_t employeeID, std::vector<Empl
     }
 }
 
-void ShowTicketManager::LoadMachineData(std::uint32_t machineID, MachineInformation& machineInfo, const ConnectionGuardAMS& connection)
+void ShowTicketManager::LoadAssignedEmployees(const std::vector<TicketAssignmentInformation>& ticketAssignment, std::vector<EmployeeInformation>& employeeInfo,
+                                              DatabaseConnection& connection)
+{
+    std::unordered_set<uint32_t> employeeIds;
+
+    for (const auto& a : ticketAssignment)
+    {
+        if (a.employeeID != 0)
+            employeeIds.insert(a.employeeID);
+    }
+
+    for (auto id : employeeIds)
+        LoadEmployees(id, employeeInfo, connection);
+}
+
+void ShowTicketManager::LoadMachineData(std::uint32_t machineID, MachineInformation& machineInfo, DatabaseConnection& connection)
 {
     // SELECT ID, CostUnitID, MachineTypeID, LineID, ManufacturerID, MachineName, MachineNumber, ManufacturerMachineNumber, RoomNumber, MoreInformation, location FROM machine_list WHERE ID = ?
 
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_ML_SELECT_MACHINE_BY_ID);
+    auto stmt = connection.GetPreparedStatement(AMSPreparedStatement::DB_ML_SELECT_MACHINE_BY_ID);
     stmt->SetUInt(0, machineID);
 
-    auto result = connection->ExecutePreparedSelect(*stmt);
+    auto result = connection.ExecutePreparedSelect(*stmt);
 
     if (!result.IsValid())
     {
@@ -538,12 +529,12 @@ void ShowTicketManager::LoadMachineData(std::uint32_t machineID, MachineInformat
 }
 
 void ShowTicketManager::LoadTicketSpareData(std::uint64_t ticketID, std::vector<SparePartsTable>& sparePartsUsed,
-                                            const ConnectionGuardAMS& connection)
+                                            DatabaseConnection& connection)
 {
-    auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TSPU_SELECT_SPARE_PARTS_USED_BY_TICKET_ID);
+    auto stmt = connection.GetPreparedStatement(AMSPreparedStatement::DB_TSPU_SELECT_SPARE_PARTS_USED_BY_TICKET_ID);
     stmt->SetUInt64(0, ticketID);
 
-    auto result = connection->ExecutePreparedSelect(*stmt);
+    auto result = connection.ExecutePreparedSelect(*stmt);
 
     if (!result.IsValid())
         return;
@@ -610,12 +601,16 @@ TicketDelta ShowTicketManager::LoadTableTicketDelta(const std::string& sinceDb)
     // Capture first to avoid missing updates happening during the select.
     delta.newSyncPoint = Util::GetCurrentSystemPointTime();
 
+    // Primary only, like the full load: writes a replica has not applied yet
+    // would fall before the next delta's start and stay missing.
     ConnectionGuardAMS connection(ConnectionType::Sync);
 
     // 1) Upserts (new/changed tickets)
     {
+        // Changed tickets and tickets whose comments changed (see ticket_overview_summary)
         auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT_SINCE);
         stmt->SetString(0, sinceDb);
+        stmt->SetString(1, sinceDb);
 
         auto result = connection->ExecutePreparedSelect(*stmt);
         if (!result.IsValid())
@@ -623,128 +618,220 @@ TicketDelta ShowTicketManager::LoadTableTicketDelta(const std::string& sinceDb)
             return delta;
         }
 
-        std::unordered_map<std::uint64_t, TicketRowData> rowMap;
-        rowMap.reserve(128);
+        delta.upserts = ReadTicketRows(result, /*withLastComment*/ true);
+    }
 
-        while (result.Next())
+    // 2) Removed (closed/resolved/deleted tickets)
+    {
+        auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT_REMOVED_SINCE);
+        stmt->SetString(0, sinceDb);
+        stmt->SetUInt(1, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_RESOLVED));
+        stmt->SetUInt(2, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_CLOSED));
+
+        auto result = connection->ExecutePreparedSelect(*stmt);
+        if (result.IsValid())
         {
-            Field* f = result.Fetch();
+            while (result.Next())
+            {
+                Field* f = result.Fetch();
+                delta.removedIds.push_back(f[0].GetUInt64());
+            }
+        }
+    }
 
-            const std::uint64_t ticketId = f[0].GetUInt64();
+    // De-dup removed IDs
+    if (delta.removedIds.size() > 1)
+    {
+        std::ranges::sort(delta.removedIds);
+        delta.removedIds.erase(std::ranges::unique(delta.removedIds).begin(), delta.removedIds.end());
+    }
 
-            auto it = rowMap.find(ticketId);
-            if (it == rowMap.end())
-            {
-                TicketRowData row{};
+    return delta;
+}
+
+std::size_t ShowTicketManager::RepairOverviewSummary()
+{
+    // Checked against the primary; a lagging replica would report false drift.
+    ConnectionGuardAMS connection(ConnectionType::Sync);
+
+    // One client per day does the check; it scans the comments of every open ticket.
+    auto claim = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_SUMMARY_CLAIM_REPAIR_RUN);
+    if (connection->ExecutePreparedModification(*claim) == 0)
+    {
+        LOG_DEBUG("Ticket overview summary: checked within the last day, skipped");
+        return 0;
+    }
 
-                row.id = ticketId;
-                row.title = f[1].GetString();
-                row.area = !f[2].IsNull() ? f[2].GetString() : std::string{};
+    std::vector<std::uint64_t> drifted;
+    {
+        auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_SUMMARY_SELECT_DRIFT);
+        stmt->SetUInt(0, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_RESOLVED));
+        stmt->SetUInt(1, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_CLOSED));
 
-                row.createdAt = f[3].GetDateTime();
-                row.updatedAt = f[4].GetDateTime();
+        auto result = connection->ExecutePreparedSelect(*stmt);
+        if (!result.IsValid())
+            return 0;
 
-                row.status =
-                    !f[5].IsNull() ? static_cast<TicketStatus>(f[5].GetUInt8()) : TicketStatus::TICKET_STATUS_NONE;
+        while (result.Next())
+        {
+            Field* f = result.Fetch();
+            drifted.push_back(f[0].GetUInt64());
+        }
+    }
 
-                row.priority = static_cast<TicketPriority>(f[6].GetUInt8());
+    std::size_t repaired = 0;
+    for (const std::uint64_t ticketId : drifted)
+    {
+        auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_SUMMARY_REFRESH);
+        stmt->SetUInt64(0, ticketId);
 
-                if (!f[7].IsNull())
-                {
-                    const std::uint16_t costUnitId = f[7].GetUInt16();
-                    row.costUnitName = CostUnitDataHandler::instance().GetCostUnitNameByInternalId(costUnitId);
-                }
-                else
-                {
-                    row.costUnitName = {};
-                }
+        if (connection->ExecutePreparedUpdate(*stmt))
+            ++repaired;
+    }
 
-                {
-                    std::string reporterName = !f[8].IsNull() ? f[8].GetString() : std::string{};
-                    if (!f[9].IsNull())
-                    {
-                        std::string reporterPhone = f[9].GetString();
-                        if (!reporterPhone.empty())
-                        {
-                            reporterName.append(" - (");
-                            reporterName.append(reporterPhone);
-                            reporterName.push_back(')');
-                        }
-                    }
-                    row.reporterName = std::move(reporterName);
-                }
+    if (!drifted.empty())
+        LOG_WARNING("Ticket overview summary: repaired {} of {} drifted row(s)", repaired, drifted.size());
 
-                row.machineName = !f[10].IsNull() ? f[10].GetString() : std::string{};
+    return repaired;
+}
 
-                auto [newIt, inserted] = rowMap.emplace(ticketId, std::move(row));
-                it = newIt;
-            }
+bool ShowTicketManager::IsHistorySortColumn(int column) { return column == 0 || column == 7 || column == 8; }
 
-            // Current employees (can be multiple rows per ticket)
-            if (!f[11].IsNull() || !f[12].IsNull())
-            {
-                std::string firstName = !f[11].IsNull() ? f[11].GetString() : std::string{};
-                std::string lastName = !f[12].IsNull() ? f[12].GetString() : std::string{};
-                std::string phone = !f[13].IsNull() ? f[13].GetString() : std::string{};
+TicketHistoryCursor ShowTicketManager::HistoryCursorFor(const TicketRowData& row, int sortColumn)
+{
+    TicketHistoryCursor cursor;
+    cursor.id = row.id;
 
-                if (!firstName.empty() || !lastName.empty())
-                {
-                    std::string fullName;
-                    fullName.reserve(firstName.size() + 1 + lastName.size() + 16);
+    if (sortColumn == 0)
+        return cursor;
 
-                    if (!firstName.empty())
-                    {
-                        fullName.append(firstName);
-                        if (!lastName.empty())
-                            fullName.push_back(' ');
-                    }
+    const SystemTimePoint sortTime = sortColumn == 7 ? row.createdAt : row.updatedAt;
+    if (sortTime != SystemTimePoint{})
+        cursor.sortTime = sortTime;
 
-                    if (!lastName.empty())
-                        fullName.append(lastName);
+    return cursor;
+}
 
-                    if (!phone.empty())
-                    {
-                        fullName.append(" - (");
-                        fullName.append(phone);
-                        fullName.push_back(')');
-                    }
+QueryFuture<std::vector<TicketRowData>> ShowTicketManager::LoadTicketHistoryPageAsync(TicketHistoryQuery query)
+{
+    // Closed tickets do not change often, a lagging replica is good enough
+    AsyncQueryOptions options;
+    options.preferReplica = true;
 
-                    auto& vec = it->second.employeeAssigned;
-                    if (std::ranges::find(vec, fullName) == vec.end())
-                        vec.push_back(std::move(fullName));
-                }
-            }
+    return AMSDatabase::QueryAsync(ConnectionType::Sync,
+        [query = std::move(query)](DatabaseConnection& connection) { return QueryTicketHistoryPage(query, connection); }, options);
+}
+
+std::vector<TicketRowData> ShowTicketManager::QueryTicketHistoryPage(const TicketHistoryQuery& query, DatabaseConnection& connection)
+{
+    const int sortColumn = IsHistorySortColumn(query.sortColumn) ? query.sortColumn : 8;
+    const std::string sortExpr = sortColumn == 0 ? "t.ID" : (sortColumn == 7 ? "t.created_at" : "t.updated_at");
+    const std::string direction = query.ascending ? " ASC" : " DESC";
+    const std::string after = query.ascending ? " > ?" : " < ?";
+
+    std::string orderBy = " ORDER BY " + sortExpr + direction;
+    if (sortColumn != 0)
+        orderBy += ", t.ID" + direction;
+
+    std::vector<QVariant> params;
+
+    // Page of ticket IDs first, so the assignment join cannot split a ticket across the LIMIT
+    std::string page =
+        "SELECT t.ID "
+        "FROM tickets t "
+        "LEFT JOIN caller_information ci ON ci.ID = t.reporter_id "
+        "LEFT JOIN machine_list ml       ON ml.ID = t.entity_id "
+        "WHERE t.is_deleted = 0 AND t.current_status IN (?, ?)";
+
+    params.push_back(static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_RESOLVED));
+    params.push_back(static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_CLOSED));
+
+    // Keyset on (sort column, ID). MariaDB orders NULL timestamps first ascending
+    // and last descending, so a cursor on either side of them has to say so.
+    if (query.after)
+    {
+        const QVariant afterId = static_cast<qulonglong>(query.after->id);
+
+        if (sortColumn == 0)
+        {
+            page += " AND t.ID" + after;
+        }
+        else if (query.after->sortTime)
+        {
+            page += " AND (" + sortExpr + after + " OR (" + sortExpr + " = ? AND t.ID" + after + ")";
+            if (!query.ascending)
+                page += " OR " + sortExpr + " IS NULL";
+            page += ")";
+
+            const QVariant sortTime = Util::ConvertToQDateTime(*query.after->sortTime);
+            params.push_back(sortTime);
+            params.push_back(sortTime);
+        }
+        else if (query.ascending)
+        {
+            page += " AND (" + sortExpr + " IS NOT NULL OR t.ID > ?)";
+        }
+        else
+        {
+            page += " AND " + sortExpr + " IS NULL AND t.ID < ?";
         }
 
-        delta.upserts.reserve(rowMap.size());
-        for (auto& row : rowMap | std::views::values)
-            delta.upserts.push_back(std::move(row));
+        params.push_back(afterId);
     }
 
-    // 2) Removed (closed/resolved/deleted tickets)
+    // AND over tokens, OR over columns
+    for (const QString& token : query.tokens)
     {
-        auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TICKET_OVERVIEW_SELECT_REMOVED_SINCE);
-        stmt->SetString(0, sinceDb);
-        stmt->SetUInt(1, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_RESOLVED));
-        stmt->SetUInt(2, static_cast<std::uint32_t>(TicketStatus::TICKET_STATUS_CLOSED));
+        const QVariant pattern = QString::fromStdString(LikeContainsPattern(token));
 
-        auto result = connection->ExecutePreparedSelect(*stmt);
-        if (result.IsValid())
+        page += " AND (t.title LIKE ? ESCAPE '!' OR t.area LIKE ? ESCAPE '!' OR ci.name LIKE ? ESCAPE '!' OR ml.MachineName LIKE ? ESCAPE '!'";
+        for (std::size_t i = 0; i < 4; ++i)
+            params.push_back(pattern);
+
+        bool isNumber = false;
+        const qulonglong id = token.toULongLong(&isNumber);
+        if (isNumber)
         {
-            while (result.Next())
-            {
-                Field* f = result.Fetch();
-                delta.removedIds.push_back(f[0].GetUInt64());
-            }
+            page += " OR t.ID = ?";
+            params.push_back(id);
         }
-    }
 
-    // De-dup removed IDs
-    if (delta.removedIds.size() > 1)
-    {
-        std::ranges::sort(delta.removedIds);
-        delta.removedIds.erase(std::ranges::unique(delta.removedIds).begin(), delta.removedIds.end());
+        page += ")";
     }
 
-    return delta;
+    page += orderBy + " LIMIT " + std::to_string(std::max<std::size_t>(query.pageSize, 1));
+
+    const std::string sql =
+        "SELECT "
+        "t.ID, "
+        "t.title, "
+        "t.area, "
+        "t.created_at, "
+        "t.updated_at, "
+        "t.current_status, "
+        "t.priority, "
+        "t.cost_unit_id, "
+        "ci.name          AS reporter_name, "
+        "ci.phone         AS reporter_phone, "
+        "ml.MachineName   AS machine_name, "
+        "ep.firstName     AS employee_first_name, "
+        "ep.lastName      AS employee_last_name, "
+        "ep.phone         AS employee_phone "
+        "FROM (" + page + ") page "
+        "INNER JOIN tickets t            ON t.ID = page.ID "
+        "LEFT JOIN caller_information ci ON ci.ID = t.reporter_id "
+        "LEFT JOIN machine_list ml       ON ml.ID = t.entity_id "
+        "LEFT JOIN ticket_assignment ta  ON ta.ticket_id = t.ID AND ta.is_current = 1 "
+        "LEFT JOIN employees ep          ON ep.ID = ta.employee_id" +
+        orderBy;
+
+    auto stmt = connection.GetStatementRaw(sql);
+    for (std::size_t i = 0; i < params.size(); ++i)
+        stmt->SetQVariant(i, params[i]);
+
+    auto result = connection.ExecutePreparedSelect(*stmt);
+    if (!result.IsValid())
+        return {};
+
+    return ReadTicketRows(result, /*withLastComment*/ false);
 }
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <QStringList>
+#include <optional>
+
 #include "ConnectionGuard.h"
 #include "DatabaseDefines.h"
 #include "SharedDefines.h"
@@ -47,6 +50,8 @@ struct ShowTicketData
     MachineInformation machineInfo{};
 };
 
+using TicketDetailsPtr = std::shared_ptr<const ShowTicketData>;
+
 struct TicketRowData
 {
     std::uint64_t id{};
@@ -73,6 +78,27 @@ struct TicketDelta
     SystemTimePoint newSyncPoint{};
 };
 
+// Position after the last row of a history page: its value in the sort
+// column (empty when sorting by ID) and its ID as the tie breaker.
+struct TicketHistoryCursor
+{
+    // Sort column value of the last row shown. Unset when sorting by ID and
+    // for rows without that timestamp (NULL, which the rows read as the epoch).
+    std::optional<SystemTimePoint> sortTime{};
+    std::uint64_t id{};
+};
+
+// One page of resolved and closed tickets. Filtering and ordering run in SQL
+// with keyset pagination, so deep pages cost the same as the first one.
+struct TicketHistoryQuery
+{
+    QStringList tokens{};
+    int sortColumn = 8;  // TicketTableModel columns: 0 = ID, 7 = created, 8 = updated
+    bool ascending = false;
+    std::optional<TicketHistoryCursor> after{};
+    std::size_t pageSize = 200;
+};
+
 class ShowTicketManager
 {
 public:
@@ -80,29 +106,57 @@ public:
     ~ShowTicketManager() = default;
 
     void LoadTableTicketData();
-    ShowTicketData LoadTicketDetails(std::uint64_t ticketID);
+    static std::vector<TicketRowData> LoadTableTicketRows();
+    // Drops the overview kept for the reuse window, so the next read sees local writes.
+    static void InvalidateTicketOverview();
+    // Lets the next detail load start fresh instead of joining one that may
+    // have read the ticket before a local write.
+    static void InvalidateTicketDetails();
+    // Details go through TicketDetailCache: a version probe decides whether the
+    // cached snapshot is reused or the ticket is loaded again.
+    static TicketDetailsPtr LoadTicketDetails(std::uint64_t ticketID);
+    // Same as LoadTicketDetails, on one pooled connection off the calling thread.
+    static QueryFuture<TicketDetailsPtr> LoadTicketDetailsAsync(std::uint64_t ticketID);
+    // Cached snapshot without touching the database, may be stale. Null if not cached.
+    static TicketDetailsPtr PeekTicketDetails(std::uint64_t ticketID);
+    // Loads the given tickets into the detail cache in the background.
+    static void PrefetchTicketDetails(const std::vector<std::uint64_t>& ticketIDs);
     const std::unordered_map<std::uint64_t, ShowTicketData>& GetTicketDataMap() const;
     const std::vector<TicketRowData> GetTableTicketVector() const;
     const std::vector<TicketRowData>& GetTableTicketVectorNoCopy() const { return _ticketRowDataList; }
     ShowTicketData GetTicketDataByID(std::uint64_t ticketID);
-    ShowTicketData GetFullTicketData() const { return _fullTicketData; }
-    TicketDelta LoadTableTicketDelta(const std::string& sinceDb);
+    static TicketDelta LoadTableTicketDelta(const std::string& sinceDb);
+
+    // Recomputes ticket_overview_summary rows of open tickets that disagree with
+    // their comments, at most once a day across all clients. Returns the number
+    // of rows repaired.
+    static std::size_t RepairOverviewSummary();
+
+    // Columns the history can be ordered by on the server (indexed).
+    static bool IsHistorySortColumn(int column);
+    static TicketHistoryCursor HistoryCursorFor(const TicketRowData& row, int sortColumn);
+    static QueryFuture<std::vector<TicketRowData>> LoadTicketHistoryPageAsync(TicketHistoryQuery query);
 
 private:
-    void LoadTicketData(std::uint64_t ticketID, TicketInformation& ticketInfo, const ConnectionGuardAMS& connection);
-    void LoadTicketAssignments(std::uint64_t ticketID, std::vector<TicketAssignmentInformation>& ticketAssignment, const ConnectionGuardAMS& connection);
-    void LoadTicketAttachments(std::uint64_t ticketID, std::vector<TicketAttachmentInformation>& ticketAttachment, const ConnectionGuardAMS& connection);
-    void LoadTicketComments(std::uint64_t ticketID, std::vector<TicketCommentInformation>& ticketComment, const ConnectionGuardAMS& connection);
-    void LoadTicketStatusHistory(std::uint64_t ticketID, std::vector<TicketStatusHistoryInformation>& ticketStatusHistory, const ConnectionGuardAMS& connection);
-    void LoadCallerInformation(std::uint16_t callerID, CallerInformation& callerInfo, const ConnectionGuardAMS& connection);
-    void LoadEmployees(std::uint32_t employeeID, std::vector<EmployeeInformation>& employeeInfo, const ConnectionGuardAMS& connection);
-    void LoadMachineData(std::uint32_t machineID, MachineInformation& machineInfo, const ConnectionGuardAMS& connection);
-    void LoadTicketSpareData(std::uint64_t ticketID, std::vector<SparePartsTable>& sparePartsUsed,
-                             const ConnectionGuardAMS& connection);
-    
+    static std::vector<TicketRowData> QueryTicketOverview();
+    static std::vector<TicketRowData> QueryTicketHistoryPage(const TicketHistoryQuery& query, DatabaseConnection& connection);
+    static std::vector<TicketRowData> ReadTicketRows(QueryResult& result, bool withLastComment);
+    static TicketDetailsPtr LoadTicketDetailsCached(std::uint64_t ticketID, DatabaseConnection& connection);
+    static ShowTicketData QueryTicketDetails(std::uint64_t ticketID, DatabaseConnection& connection);
+    static std::string QueryTicketDetailVersion(std::uint64_t ticketID, DatabaseConnection& connection);
 
+    static void LoadTicketData(std::uint64_t ticketID, TicketInformation& ticketInfo, DatabaseConnection& connection);
+    static void LoadTicketAssignments(std::uint64_t ticketID, std::vector<TicketAssignmentInformation>& ticketAssignment, DatabaseConnection& connection);
+    static void LoadTicketAttachments(std::uint64_t ticketID, std::vector<TicketAttachmentInformation>& ticketAttachment, DatabaseConnection& connection);
+    static void LoadTicketComments(std::uint64_t ticketID, std::vector<TicketCommentInformation>& ticketComment, DatabaseConnection& connection);
+    static void LoadTicketStatusHistory(std::uint64_t ticketID, std::vector<TicketStatusHistoryInformation>& ticketStatusHistory, DatabaseConnection& connection);
+    static void LoadCallerInformation(std::uint16_t callerID, CallerInformation& callerInfo, DatabaseConnection& connection);
+    static void LoadEmployees(std::uint32_t employeeID, std::vector<EmployeeInformation>& employeeInfo, DatabaseConnection& connection);
+    static void LoadMachineData(std::uint32_t machineID, MachineInformation& machineInfo, DatabaseConnection& connection);
+    static void LoadTicketSpareData(std::uint64_t ticketID, std::vector<SparePartsTable>& sparePartsUsed, DatabaseConnection& connection);
+    static void LoadAssignedEmployees(const std::vector<TicketAssignmentInformation>& ticketAssignment, std::vector<EmployeeInformation>& employeeInfo,
+                                      DatabaseConnection& connection);
 
     std::unordered_map<std::uint64_t, ShowTicketData> ticketDataMap{};
     std::vector<TicketRowData> _ticketRowDataList{};
-    ShowTicketData _fullTicketData;
 };
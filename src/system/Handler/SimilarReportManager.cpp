@@ -69,7 +69,7 @@ std::vector<SimilarReportResult> SimilarReportManager::FindSimilarTickets(std::u
 {
     LOG_DEBUG("Similar: FindSimilarTickets(ticketId={}, limit={})", ticketId, limit);
 
-    ConnectionGuardAMS connection(database::ConnectionType::Sync);
+    ConnectionGuardAMS connection(database::ConnectionType::Sync, /*preferReplica*/ true);
 
     if (!connection)
         return {};
@@ -0,0 +1,71 @@
+#include "TicketDetailCache.h"
+
+#include "pch.h"
+
+TicketDetailCache& TicketDetailCache::instance()
+{
+    static TicketDetailCache cache;
+    return cache;
+}
+
+std::optional<TicketDetailCache::Entry> TicketDetailCache::Lookup(std::uint64_t ticketID)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(ticketID);
+    if (it == _entries.end())
+        return std::nullopt;
+
+    _lru.splice(_lru.begin(), _lru, it->second.lruPos);
+    return it->second.entry;
+}
+
+void TicketDetailCache::Store(std::uint64_t ticketID, std::string version, TicketDetailsPtr data)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(ticketID);
+    if (it != _entries.end())
+    {
+        it->second.entry = Entry{std::move(data), std::move(version)};
+        _lru.splice(_lru.begin(), _lru, it->second.lruPos);
+        return;
+    }
+
+    _lru.push_front(ticketID);
+    _entries.emplace(ticketID, Slot{Entry{std::move(data), std::move(version)}, _lru.begin()});
+
+    while (_entries.size() > Capacity)
+    {
+        _entries.erase(_lru.back());
+        _lru.pop_back();
+    }
+}
+
+void TicketDetailCache::Invalidate(std::uint64_t ticketID)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    auto it = _entries.find(ticketID);
+    if (it == _entries.end())
+        return;
+
+    _lru.erase(it->second.lruPos);
+    _entries.erase(it);
+}
+
+bool TicketDetailCache::BeginPrefetch(std::uint64_t ticketID)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (_entries.contains(ticketID))
+        return false;
+
+    return _prefetching.insert(ticketID).second;
+}
+
+void TicketDetailCache::EndPrefetch(std::uint64_t ticketID)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _prefetching.erase(ticketID);
+}
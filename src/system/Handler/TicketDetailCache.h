@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "ShowTicketManager.h"
+
+// Bounded LRU of immutable ticket detail snapshots. Each entry carries the
+// version fingerprint it was loaded at (DB_TICKET_SELECT_DETAIL_VERSION), so a
+// reopen only needs the probe to decide whether the snapshot is still current.
+class TicketDetailCache
+{
+public:
+    struct Entry
+    {
+        TicketDetailsPtr data;
+        std::string version;
+    };
+
+    static TicketDetailCache& instance();
+
+    std::optional<Entry> Lookup(std::uint64_t ticketID);
+    void Store(std::uint64_t ticketID, std::string version, TicketDetailsPtr data);
+    void Invalidate(std::uint64_t ticketID);
+
+    // Claims a background prefetch slot; false if cached or already being fetched.
+    bool BeginPrefetch(std::uint64_t ticketID);
+    void EndPrefetch(std::uint64_t ticketID);
+
+private:
+    TicketDetailCache() = default;
+
+    static constexpr std::size_t Capacity = 32;
+
+    struct Slot
+    {
+        Entry entry;
+        std::list<std::uint64_t>::iterator lruPos;
+    };
+
+    std::mutex _mutex;
+    std::list<std::uint64_t> _lru;  // most recent first
+    std::unordered_map<std::uint64_t, Slot> _entries;
+    std::unordered_set<std::uint64_t> _prefetching;
+};
@@ -0,0 +1,273 @@
+#include "TicketStore.h"
+
+#include <unordered_set>
+
+#include "Databases.h"
+#include "Util.h"
+#include "pch.h"
+
+namespace
+{
+    constexpr int RefreshIntervalMs = 30 * 1000;
+
+    // Every n-th tick reloads the whole overview. Deltas only see changes that touch
+    // tickets.updated_at or the comment summary; this catches the rest (assignments).
+    constexpr int FullReloadEveryTicks = 10;
+
+    // Deltas re-read a little before the last sync point. Upserts are idempotent,
+    // and the overlap covers the reuse window of ShowTicketManager::LoadTableTicketRows
+    // as well as replica lag up to the default maxAllowedLagSeconds.
+    constexpr std::chrono::seconds SyncOverlap{5};
+
+    // Mirrors the WHERE clause of DB_TICKET_OVERVIEW_SELECT.
+    bool IsVisibleInOverview(const TicketRowData& row)
+    {
+        return row.status != TicketStatus::TICKET_STATUS_RESOLVED && row.status != TicketStatus::TICKET_STATUS_CLOSED;
+    }
+
+    void RebuildIndex(TicketSnapshot& snapshot)
+    {
+        snapshot.indexById.clear();
+        snapshot.indexById.reserve(snapshot.rows.size());
+
+        for (std::size_t i = 0; i < snapshot.rows.size(); ++i)
+            snapshot.indexById.emplace(snapshot.rows[i]->id, i);
+    }
+}  // namespace
+
+TicketRowPtr TicketSnapshot::Find(std::uint64_t ticketID) const
+{
+    auto it = indexById.find(ticketID);
+    if (it == indexById.end())
+        return nullptr;
+
+    return rows[it->second];
+}
+
+TicketStore* TicketStore::_instance = nullptr;
+
+TicketStore* TicketStore::instance()
+{
+    if (!_instance)
+    {
+        _instance = new TicketStore();
+    }
+    return _instance;
+}
+
+TicketStore::TicketStore() : _snapshot(std::make_shared<const TicketSnapshot>())
+{
+    _refreshTimer = new QTimer(this);
+    _refreshTimer->setInterval(RefreshIntervalMs);
+    connect(_refreshTimer, &QTimer::timeout, this, [this]() { StartRefresh(_deltasSinceFull + 1 >= FullReloadEveryTicks); });
+}
+
+TicketSnapshotPtr TicketStore::GetSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(_snapshotMutex);
+    return _snapshot;
+}
+
+void TicketStore::Attach()
+{
+    if (++_consumers > 1)
+        return;
+
+    _refreshTimer->start();
+    StartRefresh(true);
+}
+
+void TicketStore::Detach()
+{
+    if (_consumers == 0)
+        return;
+
+    if (--_consumers == 0)
+        _refreshTimer->stop();
+}
+
+void TicketStore::RequestRefresh(bool fullReload) { StartRefresh(fullReload); }
+
+void TicketStore::TicketWritten()
+{
+    ShowTicketManager::InvalidateTicketOverview();
+    ShowTicketManager::InvalidateTicketDetails();
+
+    QMetaObject::invokeMethod(this, [this]()
+    {
+        if (_consumers > 0)
+            StartRefresh(false);
+    }, Qt::QueuedConnection);
+}
+
+void TicketStore::StartRefresh(bool fullReload)
+{
+    if (_refreshRunning)
+    {
+        // Run once more after the current refresh instead of stacking queries.
+        _refreshQueued = true;
+        _queuedFullReload = _queuedFullReload || fullReload;
+        return;
+    }
+
+    _refreshRunning = true;
+
+    // A delta needs a baseline to apply to.
+    if (_lastSyncDb.empty())
+        fullReload = true;
+
+    auto task = [this, fullReload, since = _lastSyncDb, current = GetSnapshot()]()
+    {
+        // Timer driven; must not hold up leases the GUI is waiting for.
+        LeasePriorityScope background(LeasePriority::Background);
+
+        RefreshResult result;
+        SystemTimePoint syncPoint{};
+
+        try
+        {
+            if (fullReload)
+            {
+                // Captured before the select so nothing written during it is missed.
+                syncPoint = Util::GetCurrentSystemPointTime() - SyncOverlap;
+                result = BuildFull(current, ShowTicketManager::LoadTableTicketRows());
+            }
+            else
+            {
+                TicketDelta delta = ShowTicketManager::LoadTableTicketDelta(since);
+                syncPoint = delta.newSyncPoint - SyncOverlap;
+                result = BuildDelta(current, std::move(delta));
+            }
+        }
+        catch (const std::exception& ex)
+        {
+            LOG_ERROR("TicketStore: refresh failed: {}", ex.what());
+            result = {};
+        }
+
+        QMetaObject::invokeMethod(
+            this, [this, result = std::move(result), syncPoint]() { FinishRefresh(result.first, result.second, syncPoint); },
+            Qt::QueuedConnection);
+    };
+
+    Util::RunInThread(std::move(task), this);
+}
+
+void TicketStore::FinishRefresh(TicketSnapshotPtr snapshot, TicketChangeSetPtr changes, SystemTimePoint syncPoint)
+{
+    _refreshRunning = false;
+
+    if (snapshot && changes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_snapshotMutex);
+            _snapshot = snapshot;
+        }
+
+        _lastSyncDb = Util::FormatDateTimeStd(syncPoint);
+        _deltasSinceFull = changes->fullReload ? 0 : _deltasSinceFull + 1;
+
+        if (!changes->IsEmpty())
+            emit SnapshotChanged(snapshot, changes);
+    }
+
+    if (_refreshQueued)
+    {
+        const bool fullReload = _queuedFullReload;
+        _refreshQueued = false;
+        _queuedFullReload = false;
+        StartRefresh(fullReload);
+    }
+}
+
+TicketStore::RefreshResult TicketStore::BuildFull(const TicketSnapshotPtr& current, std::vector<TicketRowData> rows)
+{
+    auto snapshot = std::make_shared<TicketSnapshot>();
+    snapshot->version = current->version + 1;
+    snapshot->rows.reserve(rows.size());
+
+    for (auto& row : rows)
+        snapshot->rows.push_back(std::make_shared<const TicketRowData>(std::move(row)));
+
+    RebuildIndex(*snapshot);
+
+    auto changes = std::make_shared<TicketChangeSet>();
+    changes->fromVersion = current->version;
+    changes->toVersion = snapshot->version;
+    changes->fullReload = true;
+
+    return {std::move(snapshot), std::move(changes)};
+}
+
+TicketStore::RefreshResult TicketStore::BuildDelta(const TicketSnapshotPtr& current, TicketDelta delta)
+{
+    auto changes = std::make_shared<TicketChangeSet>();
+    changes->fromVersion = current->version;
+    changes->toVersion = current->version;
+
+    std::unordered_map<std::uint64_t, TicketRowPtr> upsertById;
+    std::unordered_set<std::uint64_t> removed;
+
+    for (auto& row : delta.upserts)
+    {
+        if (!IsVisibleInOverview(row))
+        {
+            removed.insert(row.id);
+            continue;
+        }
+
+        auto ptr = std::make_shared<const TicketRowData>(std::move(row));
+        upsertById[ptr->id] = ptr;
+        changes->upserts.push_back(std::move(ptr));
+    }
+
+    // A visible upsert wins; a ticket changed between the two selects is settled
+    // by the next delta, which re-reads the overlap.
+    for (auto id : delta.removedIds)
+    {
+        if (!upsertById.contains(id))
+            removed.insert(id);
+    }
+
+    for (auto id : removed)
+    {
+        if (current->indexById.contains(id))
+            changes->removedIds.push_back(id);
+    }
+
+    if (changes->IsEmpty())
+        return {current, std::move(changes)};
+
+    auto snapshot = std::make_shared<TicketSnapshot>();
+    snapshot->version = current->version + 1;
+    snapshot->rows.reserve(current->rows.size() + changes->upserts.size());
+
+    // Keep existing order, swap in changed rows and append new ones.
+    for (const auto& row : current->rows)
+    {
+        if (removed.contains(row->id))
+            continue;
+
+        auto it = upsertById.find(row->id);
+        if (it != upsertById.end())
+        {
+            snapshot->rows.push_back(it->second);
+            upsertById.erase(it);
+        }
+        else
+        {
+            snapshot->rows.push_back(row);
+        }
+    }
+
+    for (const auto& row : changes->upserts)
+    {
+        if (upsertById.contains(row->id))
+            snapshot->rows.push_back(row);
+    }
+
+    RebuildIndex(*snapshot);
+    changes->toVersion = snapshot->version;
+
+    return {std::move(snapshot), std::move(changes)};
+}
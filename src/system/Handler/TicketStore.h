@@ -0,0 +1,98 @@
+#pragma once
+
+#include <QObject>
+#include <QTimer>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "ShowTicketManager.h"
+
+using TicketRowPtr = std::shared_ptr<const TicketRowData>;
+
+// Immutable view of the ticket overview. Rows are shared between consecutive
+// snapshots, so a delta only allocates the rows it actually changes.
+struct TicketSnapshot
+{
+    std::uint64_t version{};
+    std::vector<TicketRowPtr> rows{};
+    std::unordered_map<std::uint64_t, std::size_t> indexById{};
+
+    TicketRowPtr Find(std::uint64_t ticketID) const;
+};
+
+using TicketSnapshotPtr = std::shared_ptr<const TicketSnapshot>;
+
+// Difference between two consecutive snapshots. With fullReload set the
+// consumer should rebuild from the snapshot instead of applying the lists.
+struct TicketChangeSet
+{
+    std::uint64_t fromVersion{};
+    std::uint64_t toVersion{};
+    bool fullReload = false;
+    std::vector<TicketRowPtr> upserts{};
+    std::vector<std::uint64_t> removedIds{};
+
+    bool IsEmpty() const { return !fullReload && upserts.empty() && removedIds.empty(); }
+};
+
+using TicketChangeSetPtr = std::shared_ptr<const TicketChangeSet>;
+
+// Process-wide owner of the ticket overview. All ticket views read the same
+// snapshot and are fed by one refresh loop instead of each polling the database.
+class TicketStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static TicketStore* instance();
+
+    // Never null. Safe to call from any thread.
+    TicketSnapshotPtr GetSnapshot() const;
+
+    // Views attach while they are alive; the refresh loop only runs while at
+    // least one view is attached. The first attach triggers a full load.
+    void Attach();
+    void Detach();
+
+    // Pulls changes now instead of waiting for the next tick.
+    void RequestRefresh(bool fullReload = false);
+
+    // Every ticket write of this client (create, edit, status change, close,
+    // comments) reports here. Drops the cached overview and detail reads in
+    // flight, and refreshes the attached views right away. Safe to call from any thread.
+    void TicketWritten();
+
+signals:
+    // Emitted on the GUI thread after a refresh changed the overview.
+    void SnapshotChanged(TicketSnapshotPtr snapshot, TicketChangeSetPtr changes);
+
+private:
+    TicketStore();
+
+    void StartRefresh(bool fullReload);
+    void FinishRefresh(TicketSnapshotPtr snapshot, TicketChangeSetPtr changes, SystemTimePoint syncPoint);
+
+    using RefreshResult = std::pair<TicketSnapshotPtr, TicketChangeSetPtr>;
+
+    static RefreshResult BuildFull(const TicketSnapshotPtr& current, std::vector<TicketRowData> rows);
+    static RefreshResult BuildDelta(const TicketSnapshotPtr& current, TicketDelta delta);
+
+    mutable std::mutex _snapshotMutex;
+    TicketSnapshotPtr _snapshot;
+
+    QTimer* _refreshTimer = nullptr;
+    int _consumers = 0;
+    int _deltasSinceFull = 0;
+    bool _refreshRunning = false;
+    bool _refreshQueued = false;
+    bool _queuedFullReload = false;
+    std::string _lastSyncDb;
+
+    static TicketStore* _instance;
+};
@@ -134,7 +134,19 @@ void Logger::WriteLogFile(LoggerTypes type, LogLevel level, const std::string& f
 
 bool Logger::IsLogLevelEnabled(LogLevel level)
 {
-	return GetSettings().isLogLevelEnabled(level);
+	return ShouldLog(level);
+}
+
+void Logger::SetEnabledLevels(const std::unordered_map<LogLevel, bool>& enabledLevels)
+{
+	std::uint32_t mask = 0;
+	for (const auto& [level, enabled] : enabledLevels)
+	{
+		if (enabled)
+			mask |= 1u << level;
+	}
+
+	_enabledLevels.store(mask, std::memory_order_relaxed);
 }
 
 void Logger::CloseLogFile()
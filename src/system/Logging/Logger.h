@@ -20,6 +20,10 @@ Copyright 2023 - 2024 by Severin
 #include <string>
 #include <format>
 #include <mutex>
+#include <atomic>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
 #include <type_traits>
 #include <cstdint>
 
@@ -294,6 +298,28 @@ struct ConvertIfQType<std::error_code>
 	}
 };
 
+template <typename T>
+inline constexpr bool IsLogCharType = std::is_same_v<T, char> || std::is_same_v<T, signed char> || std::is_same_v<T, unsigned char> ||
+	std::is_same_v<T, wchar_t> || std::is_same_v<T, char8_t> || std::is_same_v<T, char16_t> || std::is_same_v<T, char32_t>;
+
+// Numbers and std::string are formatted as they are, so format specs like {:X}
+// or {:.2f} work. Integers render as before; floating point values now print
+// in shortest form ("0.5", not to_string's "0.500000") unless a spec is given.
+// bool and character types keep going through ConvertIfQType and still print
+// as 1/0 and as their numeric code, as with to_string.
+template <typename T>
+decltype(auto) ToLogArg(const T& v)
+{
+	if constexpr ((std::is_arithmetic_v<T> && !std::is_same_v<T, bool> && !IsLogCharType<T>) || std::is_same_v<T, std::string> ||
+	              std::is_same_v<T, std::string_view>)
+		return (v);
+	else
+		return ConvertIfQType<T>::convert(v);
+}
+
+template <typename T>
+using LogArg = decltype(ToLogArg(std::declval<const std::remove_cvref_t<T>&>()));
+
 class Logger
 {
 public:
@@ -317,18 +343,27 @@ public:
 	std::string ensurePath(const std::string& desiredPath) const;
 	static bool IsLogLevelEnabled(LogLevel level);
 
+	// Checked by the LOG_* macros before anything is formatted.
+	static bool ShouldLog(LogLevel level)
+	{
+		return (_enabledLevels.load(std::memory_order_relaxed) >> level) & 1u;
+	}
+
+	// Called by SettingsManager whenever the enabled levels are (re)loaded.
+	static void SetEnabledLevels(const std::unordered_map<LogLevel, bool>& enabledLevels);
+
+	// The format string is checked at compile time against the converted argument types.
 	template <typename... Args>
-	std::enable_if_t<(sizeof...(Args) > 0), void> OutMessage(LoggerTypes type, LogLevel level, std::string_view format_str, Args&&... args)
+	std::enable_if_t<(sizeof...(Args) > 0), void> OutMessage(LoggerTypes type, LogLevel level, std::format_string<LogArg<Args>...> format_str, Args&&... args)
 	{
 		try
 		{
 			// Decay args so specializations (e.g. sql::SQLString) match
-			auto convertedArgs = std::tuple{
-				ConvertIfQType<std::remove_cvref_t<Args>>::convert(args)... };
+			std::tuple<LogArg<Args>...> convertedArgs{ ToLogArg<std::remove_cvref_t<Args>>(args)... };
 
-			auto formattedMessage = std::vformat(format_str, std::apply([](const auto&... unpackedArgs) {
-				return std::make_format_args(unpackedArgs...);
-				}, convertedArgs));
+			auto formattedMessage = std::apply([&format_str](auto&... unpackedArgs) {
+				return std::vformat(format_str.get(), std::make_format_args(unpackedArgs...));
+				}, convertedArgs);
 
 			WriteLogFile(type, level, formattedMessage);
 		}
@@ -347,6 +382,9 @@ private:
 	static std::tm GetCurrentLocalTime();
 	std::string GetLogLevelString(LogLevel level);
 
+	// Bit n set = LogLevel n enabled. Everything is on until the settings are loaded.
+	static inline std::atomic<std::uint32_t> _enabledLevels{0xFFFFFFFFu};
+
 	std::ofstream _logFile;
 	std::unordered_map<LoggerTypes, std::ofstream> _logFiles;
 	LoggerTypes _loggerTypes;
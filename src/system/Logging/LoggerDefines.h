@@ -26,10 +26,12 @@ enum LogLevel : std::uint8_t
 // Singleton access macro
 #define sLog Logger::instance()
 
-// Internal macro to format and log a message
+// Internal macro to format and log a message. Disabled levels return before
+// any argument is converted or formatted.
 #define TC_LOG_MESSAGE_BODY(type__, level__, format__, ...) \
     do { \
-        sLog->OutMessage(type__, level__, format__, ##__VA_ARGS__); \
+        if (Logger::ShouldLog(level__)) \
+            sLog->OutMessage(type__, level__, format__, ##__VA_ARGS__); \
     } while (0)
 
 // Macro for logging miscellaneous information
@@ -99,6 +99,7 @@ struct TicketInformation
     SystemTimePoint updatedAt{};
     SystemTimePoint closedAt{};
     SystemTimePoint lastStatusChangeAt{};
+    std::uint32_t rowVersion{};     // optimistic concurrency token, see ShowTicketDetailManager::SaveTicketChanges
     bool isDeleted{false};
 };
 
@@ -4,6 +4,7 @@
 #include <span>
 #include <string>
 
+#include "AttachmentCache.h"
 #include "ConnectionGuard.h"
 #include "IMSDatabase.h"
 #include "LoggerDefines.h"
@@ -21,6 +22,7 @@ void RBACAccess::Initialize(std::uint32_t accountId)
     _access.setAccount(accountId);
 
     _access.reload();
+    ApplyAttachmentAccess(lock);
 }
 
 void RBACAccess::Shutdown()
@@ -47,6 +49,7 @@ void RBACAccess::SetCurrentAccount(std::uint32_t accountId)
     _loggedMissingInit = false;
     _access.setAccount(accountId);
     _access.reload();
+    ApplyAttachmentAccess(lock);
 }
 
 void RBACAccess::Reload()
@@ -58,6 +61,16 @@ void RBACAccess::Reload()
     }
 
     _access.reload();
+    ApplyAttachmentAccess(lock);
+}
+
+void RBACAccess::ApplyAttachmentAccess(std::unique_lock<std::shared_mutex>& lock)
+{
+    const auto accountId = _access.getAccountId();
+    const bool mayView = _access.hasPermission(static_cast<std::uint32_t>(Permission::RBAC_SHOW_TICKETS));
+    lock.unlock();
+
+    AttachmentCache::instance().SetAccess(accountId, mayView);
 }
 
 bool RBACAccess::HasPermission(std::uint32_t permId)
@@ -3,6 +3,7 @@
 #include <QString>
 #include <cstdint>
 #include <initializer_list>
+#include <mutex>
 #include <shared_mutex>
 #include <string>
 
@@ -33,6 +34,8 @@ class RBACAccess
 
    private:
     static bool IsReady();
+    // Passes the reloaded access on to AttachmentCache; releases lock first.
+    static void ApplyAttachmentAccess(std::unique_lock<std::shared_mutex>& lock);
 
     static AccessControl _access;
     static std::shared_mutex _mutex;
@@ -407,6 +407,7 @@ void SettingsManager::loadEnabledLogLevels()
         out.emplace(lv, enabled.contains(static_cast<int>(lv)));
 
     _enabledLogLevels = out;
+    Logger::SetEnabledLevels(_enabledLogLevels);
 }
 
 void SettingsManager::loadWindowGeometry()
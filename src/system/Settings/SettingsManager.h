@@ -35,6 +35,8 @@ struct PoolLimits
     std::size_t minSize = 1;
     std::size_t maxSize = 5;
     std::size_t maxQueueDepth = 1024;
+    // Connections background leases may hold at once; the rest stay free for interactive work.
+    std::size_t maxBackground = 4;
 };
 
 struct ReplicaConfig
@@ -54,6 +56,8 @@ struct MaintenanceConfig
 {
     std::uint32_t pingIntervalSeconds = 30;
     std::uint32_t reconnectDelaySeconds = 5;
+    // Connections idle longer than this are pinged before they are handed out.
+    std::uint32_t validateAfterIdleSeconds = 15;
 };
 
 struct MySQLSettings
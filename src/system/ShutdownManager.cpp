@@ -14,6 +14,7 @@
 #include <thread>
 #include <vector>
 
+#include "ChangeProbe.h"
 #include "Databases.h"
 #include "Logger.h"
 #include "LoggerDefines.h"
@@ -308,6 +309,23 @@ void ShutdownManager::LogDatabaseSnapshot()
              amsDiag.replicaSyncAvailable,
              amsDiag.replicaAsyncAvailable,
              amsDiag.queuedJobs);
+
+    LOG_MISC("Shutdown diagnostics: interrupted leases IMS killed={} cancelled={} timedOut={} unbounded={}, AMS killed={} cancelled={} timedOut={} unbounded={}.",
+             imsDiag.killedQueries, imsDiag.cancelledLeases, imsDiag.timedOutLeases, imsDiag.unboundedLeases,
+             amsDiag.killedQueries, amsDiag.cancelledLeases, amsDiag.timedOutLeases, amsDiag.unboundedLeases);
+
+    auto logWait = [](const char* pool, const char* priority, const database::LeaseWaitStats& wait)
+    {
+        LOG_MISC("Shutdown diagnostics: {} {} lease wait leases={} p50={:.2f}ms p99={:.2f}ms max={:.2f}ms.", pool, priority, wait.leases,
+                 wait.p50Ms, wait.p99Ms, wait.maxMs);
+    };
+    logWait("IMS", "interactive", imsDiag.interactiveWait);
+    logWait("IMS", "background", imsDiag.backgroundWait);
+    logWait("AMS", "interactive", amsDiag.interactiveWait);
+    logWait("AMS", "background", amsDiag.backgroundWait);
+
+    for (const auto& probe : database::ChangeProbe::GetDiagnostics())
+        LOG_MISC("Shutdown diagnostics: change probe table={} hits={} misses={}.", probe.table, probe.hits, probe.misses);
 }
 
 void ShutdownManager::LogThreadSnapshot(const std::string& context)
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <QCollator>
+#include <QCollatorSortKey>
+#include <QString>
+#include <algorithm>
+#include <cstddef>
+#include <execution>
+#include <string>
+#include <vector>
+
+// Helpers for models that sort text columns: collate each string once into a
+// QCollatorSortKey and compare the keys, instead of calling localeAwareCompare
+// inside the comparator.
+namespace CollatedSort
+{
+    // Above this many rows the stable sort runs on the parallel policy.
+    inline constexpr std::size_t ParallelSortThreshold = 20000;
+
+    // Same ordering as QString::localeAwareCompare. Models sort on the GUI
+    // thread only, QCollator itself is not thread-safe.
+    inline QCollator& Collator()
+    {
+        static QCollator collator;
+        return collator;
+    }
+
+    inline QCollatorSortKey Key(const QString& text) { return Collator().sortKey(text); }
+
+    inline QCollatorSortKey Key(const std::string& text) { return Key(QString::fromStdString(text)); }
+
+    // Stable sort that switches to the parallel policy for large tables. less
+    // must be safe to call concurrently (comparing prepared keys is).
+    template <typename T, typename Less>
+    void StableSort(std::vector<T>& items, Less less)
+    {
+        if (items.size() >= ParallelSortThreshold)
+            std::stable_sort(std::execution::par, items.begin(), items.end(), less);
+        else
+            std::stable_sort(items.begin(), items.end(), less);
+    }
+}  // namespace CollatedSort
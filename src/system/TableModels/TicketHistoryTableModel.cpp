@@ -0,0 +1,163 @@
+#include "pch.h"
+
+#include "TicketHistoryTableModel.h"
+
+#include "Logger.h"
+#include "TicketTableModel.h"
+#include "Util.h"
+
+TicketHistoryTableModel::TicketHistoryTableModel(QObject* parent) : QAbstractTableModel(parent)
+{
+    _query.pageSize = PageSize;
+}
+
+void TicketHistoryTableModel::setFilterText(const QString& text)
+{
+    if (_filterText == text)
+        return;
+
+    _filterText = text;
+    _query.tokens = Util::TokenizeSearch(text);
+    reload();
+}
+
+void TicketHistoryTableModel::reload()
+{
+    ++_generation;
+    _pending.Cancel();
+    _fetching = false;
+
+    beginResetModel();
+    _rows.clear();
+    _loadedIds.clear();
+    _atEnd = false;
+    _query.after.reset();
+    endResetModel();
+
+    // The attached view asks for the first page once it lays out the empty model
+}
+
+int TicketHistoryTableModel::rowCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    return static_cast<int>(_rows.size());
+}
+
+int TicketHistoryTableModel::columnCount(const QModelIndex& parent) const
+{
+    if (parent.isValid())
+        return 0;
+
+    // Same columns as TicketTableModel, so both can share one view setup
+    return 14;
+}
+
+QVariant TicketHistoryTableModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || index.row() < 0 || static_cast<std::size_t>(index.row()) >= _rows.size())
+        return {};
+
+    return TicketTableModel::RowData(*_rows[index.row()], index.column(), role);
+}
+
+QVariant TicketHistoryTableModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
+        return {};
+
+    return TicketTableModel::ColumnHeader(section);
+}
+
+void TicketHistoryTableModel::sort(int column, Qt::SortOrder order)
+{
+    // Other columns have no index to page along; keep the current order for them
+    if (!ShowTicketManager::IsHistorySortColumn(column))
+        return;
+
+    const bool ascending = order == Qt::AscendingOrder;
+    if (_query.sortColumn == column && _query.ascending == ascending)
+        return;
+
+    _query.sortColumn = column;
+    _query.ascending = ascending;
+    reload();
+}
+
+bool TicketHistoryTableModel::canFetchMore(const QModelIndex& parent) const
+{
+    return !parent.isValid() && !_atEnd && !_fetching;
+}
+
+void TicketHistoryTableModel::fetchMore(const QModelIndex& parent)
+{
+    if (parent.isValid() || _atEnd || _fetching)
+        return;
+
+    _fetching = true;
+
+    const std::uint64_t generation = _generation;
+
+    _pending = ShowTicketManager::LoadTicketHistoryPageAsync(_query);
+    _pending.Then(this,
+        [this, generation](QueryOutcome<std::vector<TicketRowData>> outcome)
+        {
+            if (generation != _generation || outcome.status == QueryStatus::Cancelled)
+                return;
+
+            if (!outcome.Ok())
+            {
+                // Leave _atEnd unset so scrolling down retries
+                LOG_ERROR("Loading ticket history failed: {}", outcome.error);
+                _fetching = false;
+                return;
+            }
+
+            onPageLoaded(std::move(*outcome.value));
+        });
+}
+
+void TicketHistoryTableModel::onPageLoaded(std::vector<TicketRowData> page)
+{
+    _fetching = false;
+    _atEnd = page.size() < _query.pageSize;
+
+    // The next page continues behind the last row the server returned
+    if (!page.empty())
+        _query.after = ShowTicketManager::HistoryCursorFor(page.back(), _query.sortColumn);
+
+    // A ticket updated between two pages may show up again further down
+    std::vector<TicketRowPtr> fresh;
+    fresh.reserve(page.size());
+
+    for (auto& row : page)
+    {
+        if (_loadedIds.insert(row.id).second)
+            fresh.push_back(std::make_shared<const TicketRowData>(std::move(row)));
+    }
+
+    if (fresh.empty())
+        return;
+
+    const int first = static_cast<int>(_rows.size());
+    beginInsertRows({}, first, first + static_cast<int>(fresh.size()) - 1);
+    _rows.insert(_rows.end(), std::make_move_iterator(fresh.begin()), std::make_move_iterator(fresh.end()));
+    endInsertRows();
+}
+
+std::optional<std::uint64_t> TicketHistoryTableModel::ticketIdForRow(int row) const
+{
+    if (row < 0 || static_cast<std::size_t>(row) >= _rows.size())
+        return std::nullopt;
+
+    return _rows[row]->id;
+}
+
+std::optional<std::uint64_t> TicketHistoryTableModel::ticketIdForIndex(const QModelIndex& index) const
+{
+    if (!index.isValid())
+        return std::nullopt;
+
+    return ticketIdForRow(index.row());
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <QString>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include "TicketStore.h"
+
+// Resolved and closed tickets, loaded page by page as the view scrolls. Search
+// tokens and sort order go to the server (ShowTicketManager::LoadTicketHistoryPageAsync),
+// so only the pages looked at are held in memory.
+class TicketHistoryTableModel : public QAbstractTableModel
+{
+    Q_OBJECT
+
+   public:
+    explicit TicketHistoryTableModel(QObject* parent = nullptr);
+
+    void setFilterText(const QString& text);
+    // Drops the loaded pages and starts again from the first one.
+    void reload();
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override;
+    void sort(int column, Qt::SortOrder order) override;
+
+    bool canFetchMore(const QModelIndex& parent) const override;
+    void fetchMore(const QModelIndex& parent) override;
+
+    std::optional<std::uint64_t> ticketIdForRow(int row) const;
+    std::optional<std::uint64_t> ticketIdForIndex(const QModelIndex& index) const;
+
+   private:
+    void onPageLoaded(std::vector<TicketRowData> page);
+
+    static constexpr std::size_t PageSize = 200;
+
+    QString _filterText{};
+    TicketHistoryQuery _query{};
+
+    std::vector<TicketRowPtr> _rows;
+    std::unordered_set<std::uint64_t> _loadedIds;
+
+    QueryFuture<std::vector<TicketRowData>> _pending;
+    // Bumped on every reload; pages of an older query are dropped on arrival.
+    std::uint64_t _generation = 0;
+    bool _fetching = false;
+    bool _atEnd = false;
+};
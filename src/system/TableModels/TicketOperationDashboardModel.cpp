@@ -31,14 +31,14 @@ namespace
     }
 }  // namespace
 
-TicketOperationDashboardModel::TicketOperationDashboardModel(QObject* parent) : QAbstractTableModel(parent) {}
+TicketOperationDashboardModel::TicketOperationDashboardModel(QObject* parent) : TicketRowsModel(parent) {}
 
-void TicketOperationDashboardModel::setRows(const std::vector<TicketRowData>& rows)
+void TicketOperationDashboardModel::setSnapshot(const TicketSnapshotPtr& snapshot)
 {
-    beginResetModel();
-    _allRows = rows;
-    endResetModel();
+    _snapshot = snapshot;
+    _allRows = snapshot ? snapshot->rows : std::vector<TicketRowPtr>{};
 
+    sortAllRows();
     rebuildRows();
 }
 
@@ -66,7 +66,7 @@ QVariant TicketOperationDashboardModel::data(const QModelIndex& index, int role)
     if (!index.isValid() || index.row() < 0 || static_cast<std::size_t>(index.row()) >= _rows.size())
         return {};
 
-    const auto& row = _rows[index.row()];
+    const TicketRowData& row = *_rows[index.row()];
 
     if (role == RoleTicketId)
         return static_cast<qulonglong>(row.id);
@@ -229,70 +229,70 @@ void TicketOperationDashboardModel::refreshOpenDurations()
     emit dataChanged(tl, br, {Qt::DisplayRole, RoleMinutesOpen});
 }
 
-void TicketOperationDashboardModel::ApplyDelta(const std::vector<TicketRowData>& upserts, const std::vector<std::uint64_t>& removedIds)
+void TicketOperationDashboardModel::ApplyChanges(const TicketSnapshotPtr& snapshot, const TicketChangeSet& changes)
 {
-    if (upserts.empty() && removedIds.empty())
+    if (changes.fullReload || !_snapshot || _snapshot->version != changes.fromVersion)
+    {
+        setSnapshot(snapshot);
+        return;
+    }
+
+    _snapshot = snapshot;
+
+    if (changes.upserts.empty() && changes.removedIds.empty())
         return;
 
     // Remove
-    if (!removedIds.empty() && !_allRows.empty())
+    if (!changes.removedIds.empty() && !_allRows.empty())
     {
-        std::unordered_set<std::uint64_t> removeSet;
-        removeSet.reserve(removedIds.size());
-        for (auto id : removedIds)
-            removeSet.insert(id);
-
-        _allRows.erase(
-            std::ranges::remove_if(_allRows, [&](const TicketRowData& r) { return removeSet.contains(r.id); }).begin(),
-            _allRows.end());
+        std::unordered_set<std::uint64_t> removeSet(changes.removedIds.begin(), changes.removedIds.end());
+        std::erase_if(_allRows, [&](const TicketRowPtr& r) { return removeSet.contains(r->id); });
     }
 
     // Upsert
-    if (!upserts.empty())
+    if (!changes.upserts.empty())
     {
         std::unordered_map<std::uint64_t, std::size_t> indexById;
         indexById.reserve(_allRows.size());
 
         for (std::size_t i = 0; i < _allRows.size(); ++i)
-            indexById.emplace(_allRows[i].id, i);
+            indexById.emplace(_allRows[i]->id, i);
 
-        for (const auto& row : upserts)
+        for (const auto& row : changes.upserts)
         {
-            auto it = indexById.find(row.id);
+            auto it = indexById.find(row->id);
             if (it != indexById.end())
             {
                 _allRows[it->second] = row;
             }
             else
             {
-                indexById.emplace(row.id, _allRows.size());
+                indexById.emplace(row->id, _allRows.size());
                 _allRows.push_back(row);
             }
         }
     }
 
+    sortAllRows();
     rebuildRows();
 }
 
-void TicketOperationDashboardModel::rebuildRows()
-{
-    beginResetModel();
-
-    _rows.clear();
-    _rows.reserve(_allRows.size());
+void TicketOperationDashboardModel::rebuildRows() { syncRows(filteredRows()); }
 
+std::vector<TicketRowPtr> TicketOperationDashboardModel::filteredRows() const
+{
     const QString filter = _filterText.trimmed();
     if (filter.isEmpty())
-    {
-        _rows = _allRows;
-        endResetModel();
-        return;
-    }
+        return _allRows;
+
+    std::vector<TicketRowPtr> rows;
+    rows.reserve(_allRows.size());
 
     const QStringList tokens = filter.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
 
-    for (const auto& row : _allRows)
+    for (const auto& rowPtr : _allRows)
     {
+        const TicketRowData& row = *rowPtr;
         bool include = true;
 
         for (const auto& token : tokens)
@@ -319,22 +319,39 @@ void TicketOperationDashboardModel::rebuildRows()
         }
 
         if (include)
-            _rows.push_back(row);
+            rows.push_back(rowPtr);
     }
 
-    endResetModel();
+    return rows;
 }
 
 void TicketOperationDashboardModel::sort(int column, Qt::SortOrder order)
 {
+    _sortColumn = column;
+    _sortOrder = order;
+
     if (_allRows.empty())
         return;
 
+    sortAllRows();
+    reorderRows(filteredRows());
+}
+
+void TicketOperationDashboardModel::sortAllRows()
+{
+    if (_sortColumn < 0 || _allRows.empty())
+        return;
+
+    const int column = _sortColumn;
+    const Qt::SortOrder order = _sortOrder;
+
     auto cmpStr = [](const std::string& a, const std::string& b)
     { return QString::fromStdString(a).localeAwareCompare(QString::fromStdString(b)); };
 
-    auto cmp = [=](const TicketRowData& a, const TicketRowData& b)
+    auto cmp = [=](const TicketRowPtr& lhs, const TicketRowPtr& rhs)
     {
+        const TicketRowData& a = *lhs;
+        const TicketRowData& b = *rhs;
         int r = 0;
 
         switch (column)
@@ -380,8 +397,5 @@ void TicketOperationDashboardModel::sort(int column, Qt::SortOrder order)
         return (order == Qt::AscendingOrder) ? (r < 0) : (r > 0);
     };
 
-    beginResetModel();
-    std::ranges::sort(_allRows, cmp);
-    rebuildRows();
-    endResetModel();
+    std::ranges::stable_sort(_allRows, cmp);
 }
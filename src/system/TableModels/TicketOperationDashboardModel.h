@@ -1,20 +1,19 @@
 #pragma once
 
-#include <QAbstractTableModel>
 #include <QString>
 #include <optional>
 #include <vector>
 
-#include "ShowTicketManager.h"
+#include "TicketRowsModel.h"
 
-class TicketOperationDashboardModel : public QAbstractTableModel
+class TicketOperationDashboardModel : public TicketRowsModel
 {
     Q_OBJECT
 
    public:
     explicit TicketOperationDashboardModel(QObject* parent = nullptr);
 
-    void setRows(const std::vector<TicketRowData>& rows);
+    void setSnapshot(const TicketSnapshotPtr& snapshot);
     void setFilterText(const QString& text);
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -29,15 +28,20 @@ class TicketOperationDashboardModel : public QAbstractTableModel
 
     void refreshOpenDurations();
 
-    void ApplyDelta(const std::vector<TicketRowData>& upserts, const std::vector<std::uint64_t>& removedIds);
+    void ApplyChanges(const TicketSnapshotPtr& snapshot, const TicketChangeSet& changes);
 
     void sort(int column, Qt::SortOrder order = Qt::AscendingOrder) override;
 
    private:
     void rebuildRows();
+    std::vector<TicketRowPtr> filteredRows() const;
+    void sortAllRows();
 
    private:
     QString _filterText{};
-    std::vector<TicketRowData> _allRows;
-    std::vector<TicketRowData> _rows;
+    TicketSnapshotPtr _snapshot;
+    std::vector<TicketRowPtr> _allRows;
+
+    int _sortColumn = -1;
+    Qt::SortOrder _sortOrder = Qt::AscendingOrder;
 };
@@ -0,0 +1,115 @@
+#include "pch.h"
+
+#include "TicketRowsModel.h"
+
+#include <algorithm>
+#include <ranges>
+#include <unordered_map>
+#include <unordered_set>
+
+void TicketRowsModel::syncRows(std::vector<TicketRowPtr> next)
+{
+    std::unordered_set<std::uint64_t> nextIds;
+    nextIds.reserve(next.size());
+
+    for (const auto& row : next)
+        nextIds.insert(row->id);
+
+    // Removals first, back to front in contiguous runs.
+    for (int last = static_cast<int>(_rows.size()) - 1; last >= 0;)
+    {
+        if (nextIds.contains(_rows[last]->id))
+        {
+            --last;
+            continue;
+        }
+
+        int first = last;
+        while (first > 0 && !nextIds.contains(_rows[first - 1]->id))
+            --first;
+
+        beginRemoveRows(QModelIndex(), first, last);
+        _rows.erase(_rows.begin() + first, _rows.begin() + last + 1);
+        endRemoveRows();
+
+        last = first - 1;
+    }
+
+    std::unordered_set<std::uint64_t> currentIds;
+    currentIds.reserve(_rows.size());
+
+    for (const auto& row : _rows)
+        currentIds.insert(row->id);
+
+    // Every row before i already matches next. What is left of _rows are
+    // tickets that stay, so each position is an insert, a move or an update.
+    const int lastColumn = columnCount() - 1;
+
+    for (std::size_t i = 0; i < next.size(); ++i)
+    {
+        const int row = static_cast<int>(i);
+
+        if (!currentIds.contains(next[i]->id))
+        {
+            std::size_t last = i;
+            while (last + 1 < next.size() && !currentIds.contains(next[last + 1]->id))
+                ++last;
+
+            beginInsertRows(QModelIndex(), row, static_cast<int>(last));
+            _rows.insert(_rows.begin() + row, next.begin() + row, next.begin() + static_cast<int>(last) + 1);
+            endInsertRows();
+
+            i = last;
+            continue;
+        }
+
+        if (_rows[i]->id != next[i]->id)
+        {
+            auto it = std::find_if(_rows.begin() + row + 1, _rows.end(),
+                                   [id = next[i]->id](const TicketRowPtr& candidate) { return candidate->id == id; });
+            const int from = static_cast<int>(it - _rows.begin());
+
+            beginMoveRows(QModelIndex(), from, from, QModelIndex(), row);
+            std::rotate(_rows.begin() + row, it, it + 1);
+            endMoveRows();
+        }
+
+        if (_rows[i] != next[i])
+        {
+            _rows[i] = next[i];
+            emit dataChanged(index(row, 0), index(row, lastColumn));
+        }
+    }
+}
+
+void TicketRowsModel::reorderRows(std::vector<TicketRowPtr> next)
+{
+    std::unordered_map<std::uint64_t, int> rowById;
+    rowById.reserve(next.size());
+
+    for (std::size_t i = 0; i < next.size(); ++i)
+        rowById.emplace(next[i]->id, static_cast<int>(i));
+
+    const bool sameTickets = next.size() == _rows.size() &&
+                             std::ranges::all_of(_rows, [&](const TicketRowPtr& row) { return rowById.contains(row->id); });
+
+    if (!sameTickets)
+    {
+        syncRows(std::move(next));
+        return;
+    }
+
+    emit layoutAboutToBeChanged({}, QAbstractItemModel::VerticalSortHint);
+
+    const QModelIndexList from = persistentIndexList();
+    QModelIndexList to;
+    to.reserve(from.size());
+
+    for (const QModelIndex& persistent : from)
+        to.push_back(index(rowById.at(_rows[persistent.row()]->id), persistent.column()));
+
+    changePersistentIndexList(from, to);
+    _rows = std::move(next);
+
+    emit layoutChanged({}, QAbstractItemModel::VerticalSortHint);
+}
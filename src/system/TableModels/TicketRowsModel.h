@@ -0,0 +1,26 @@
+#pragma once
+
+#include <QAbstractTableModel>
+#include <vector>
+
+#include "TicketStore.h"
+
+// Base of the models that show rows of the TicketStore snapshot. Changes reach
+// the view as row inserts, removals, moves and dataChanged instead of a model
+// reset, so selection, current index and scroll position survive a refresh.
+class TicketRowsModel : public QAbstractTableModel
+{
+   public:
+    using QAbstractTableModel::QAbstractTableModel;
+
+   protected:
+    // Turns _rows into next. Rows are matched by ticket id; a row whose
+    // pointer changed is reported through dataChanged.
+    void syncRows(std::vector<TicketRowPtr> next);
+
+    // Same tickets in a new order, e.g. after sort(). Persistent indexes
+    // follow their ticket. Falls back to syncRows if the tickets differ.
+    void reorderRows(std::vector<TicketRowPtr> next);
+
+    std::vector<TicketRowPtr> _rows;
+};
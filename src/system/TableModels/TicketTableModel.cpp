@@ -5,20 +5,54 @@
 #include <QRegularExpression>
 #include <algorithm>
 #include <ranges>
+#include <unordered_map>
 
+#include "CollatedSort.h"
 #include "SimpleBGDelegate.h"
 
 
-TicketTableModel::TicketTableModel(QObject* parent) : QAbstractTableModel(parent)
+TicketTableModel::TicketTableModel(QObject* parent) : TicketRowsModel(parent)
 {
 }
 
-void TicketTableModel::setRows(const std::vector<TicketRowData>& rows)
+void TicketTableModel::setSnapshot(const TicketSnapshotPtr& snapshot)
 {
-    beginResetModel();
-    _allRows = rows;
-    endResetModel();
+    _snapshot = snapshot;
+    _allRows = snapshot ? snapshot->rows : std::vector<TicketRowPtr>{};
 
+    sortAllRows();
+    rebuildRows();
+}
+
+void TicketTableModel::applyChanges(const TicketSnapshotPtr& snapshot, const TicketChangeSet& changes)
+{
+    if (changes.fullReload || !_snapshot || _snapshot->version != changes.fromVersion)
+    {
+        setSnapshot(snapshot);
+        return;
+    }
+
+    _snapshot = snapshot;
+
+    // Rows keep their current (sorted) position; only changed pointers are swapped.
+    std::erase_if(_allRows, [&](const TicketRowPtr& row) { return !snapshot->indexById.contains(row->id); });
+
+    std::unordered_map<std::uint64_t, std::size_t> indexById;
+    indexById.reserve(_allRows.size());
+
+    for (std::size_t i = 0; i < _allRows.size(); ++i)
+        indexById.emplace(_allRows[i]->id, i);
+
+    for (const auto& row : changes.upserts)
+    {
+        auto it = indexById.find(row->id);
+        if (it != indexById.end())
+            _allRows[it->second] = row;
+        else
+            _allRows.push_back(row);
+    }
+
+    sortAllRows();
     rebuildRows();
 }
 
@@ -47,11 +81,14 @@ QVariant TicketTableModel::data(const QModelIndex& index, int role) const
         return {};
     }
 
-    const auto& row = _rows[index.row()];
+    return RowData(*_rows[index.row()], index.column(), role);
+}
 
+QVariant TicketTableModel::RowData(const TicketRowData& row, int column, int role)
+{
     if (role == Qt::DisplayRole)
     {
-        switch (index.column())
+        switch (column)
         {
             case 0:
                 return static_cast<qulonglong>(row.id);
@@ -114,7 +151,7 @@ QVariant TicketTableModel::data(const QModelIndex& index, int role) const
 
     if (role == RoleMinutesOpen)
     {
-        if (index.column() != 13)
+        if (column != 13)
             return {};
 
         const bool isClosed =
@@ -135,6 +172,11 @@ QVariant TicketTableModel::headerData(int section, Qt::Orientation orientation,
     if (orientation != Qt::Horizontal || role != Qt::DisplayRole)
         return {};
 
+    return ColumnHeader(section);
+}
+
+QVariant TicketTableModel::ColumnHeader(int section)
+{
     switch (section)
     {
         case 0:
@@ -172,13 +214,48 @@ QVariant TicketTableModel::headerData(int section, Qt::Orientation orientation,
 
 void TicketTableModel::sort(int column, Qt::SortOrder order)
 {
+    _sortColumn = column;
+    _sortOrder = order;
+
     if (_allRows.empty())
         return;
 
-    auto cmp = [column, order](const TicketRowData& a, const TicketRowData& b)
+    sortAllRows();
+    reorderRows(filteredRows());
+}
+
+bool TicketTableModel::IsTextColumn(int column) { return column >= 1 && column <= 4; }
+
+const std::string& TicketTableModel::SortText(const TicketRowData& row, int column)
+{
+    switch (column)
+    {
+        case 1:
+            return row.title;
+        case 2:
+            return row.area;
+        case 3:
+            return row.reporterName;
+        default:
+            return row.machineName;
+    }
+}
+
+void TicketTableModel::sortAllRows()
+{
+    if (_sortColumn < 0 || _allRows.empty())
+        return;
+
+    if (IsTextColumn(_sortColumn))
     {
-        auto cmpStr = [](const std::string& sa, const std::string& sb)
-        { return QString::fromStdString(sa).localeAwareCompare(QString::fromStdString(sb)); };
+        sortByCollationKeys();
+        return;
+    }
+
+    auto cmp = [column = _sortColumn, order = _sortOrder](const TicketRowPtr& lhs, const TicketRowPtr& rhs)
+    {
+        const TicketRowData& a = *lhs;
+        const TicketRowData& b = *rhs;
 
         int r = 0;
 
@@ -188,22 +265,6 @@ void TicketTableModel::sort(int column, Qt::SortOrder order)
                 r = (a.id < b.id) ? -1 : (a.id > b.id ? 1 : 0);
                 break;
 
-            case 1:
-                r = cmpStr(a.title, b.title);
-                break;
-
-            case 2:
-                r = cmpStr(a.area, b.area);
-                break;
-
-            case 3:
-                r = cmpStr(a.reporterName, b.reporterName);
-                break;
-
-            case 4:
-                r = cmpStr(a.machineName, b.machineName);
-                break;
-
             case 5:
                 r = (int)a.priority - (int)b.priority;
                 break;
@@ -236,66 +297,94 @@ void TicketTableModel::sort(int column, Qt::SortOrder order)
         return order == Qt::AscendingOrder ? r < 0 : r > 0;
     };
 
-    beginResetModel();
-    std::ranges::sort(_allRows, cmp);
-    endResetModel();
-
-    rebuildRows();
+    CollatedSort::StableSort(_allRows, cmp);
 }
 
-void TicketTableModel::rebuildRows()
+void TicketTableModel::sortByCollationKeys()
 {
-    beginResetModel();
+    if (_sortKeyColumn != _sortColumn)
+    {
+        _sortKeys.clear();
+        _sortKeyColumn = _sortColumn;
+    }
 
-    _rows.clear();
-    _rows.reserve(_allRows.size());
+    // Carry over keys of unchanged rows, collate only new or changed ones.
+    // Tickets that left the snapshot drop out with the old map.
+    std::unordered_map<std::uint64_t, SortKeyEntry> keys;
+    keys.reserve(_allRows.size());
 
-    QString filter = _filterText.trimmed();
+    struct Keyed
+    {
+        const QCollatorSortKey* key;
+        TicketRowPtr row;
+    };
 
-    if (filter.isEmpty())
+    std::vector<Keyed> keyed;
+    keyed.reserve(_allRows.size());
+
+    for (const auto& row : _allRows)
     {
-        _rows = _allRows;
-        endResetModel();
-        return;
+        auto it = keys.find(row->id);
+
+        if (it == keys.end())
+        {
+            auto cached = _sortKeys.find(row->id);
+            if (cached != _sortKeys.end() && cached->second.row == row)
+                it = keys.emplace(row->id, std::move(cached->second)).first;
+            else
+                it = keys.emplace(row->id, SortKeyEntry{row, CollatedSort::Key(SortText(*row, _sortColumn))}).first;
+        }
+
+        keyed.push_back({&it->second.key, row});
     }
 
+    _sortKeys = std::move(keys);
+
+    const bool ascending = _sortOrder == Qt::AscendingOrder;
+    CollatedSort::StableSort(keyed, [ascending](const Keyed& a, const Keyed& b)
+    {
+        const int r = a.key->compare(*b.key);
+        return ascending ? r < 0 : r > 0;
+    });
+
+    for (std::size_t i = 0; i < keyed.size(); ++i)
+        _allRows[i] = std::move(keyed[i].row);
+}
+
+void TicketTableModel::rebuildRows() { syncRows(filteredRows()); }
+
+std::vector<TicketRowPtr> TicketTableModel::filteredRows() const
+{
+    QString filter = _filterText.trimmed();
+
+    if (filter.isEmpty())
+        return _allRows;
+
+    std::vector<TicketRowPtr> rows;
+    rows.reserve(_allRows.size());
+
     QStringList tokens = filter.split(QRegularExpression("\\s+"), Qt::SkipEmptyParts);
 
-    for (const auto& row : _allRows)
+    for (const auto& rowPtr : _allRows)
     {
-        bool include = true;
+        const TicketRowData& row = *rowPtr;
 
-        for (const auto& token : tokens)
-        {
-            bool match = QString::fromStdString(row.title).contains(token, Qt::CaseInsensitive) ||
-                         QString::fromStdString(row.area).contains(token, Qt::CaseInsensitive) ||
-                         QString::fromStdString(row.reporterName).contains(token, Qt::CaseInsensitive) ||
-                         QString::fromStdString(row.machineName).contains(token, Qt::CaseInsensitive) ||
-                         QString::fromStdString(row.costUnitName).contains(token, Qt::CaseInsensitive) ||
-                         QString::number(row.id).contains(token);
-
-            // search in assigned employees
-            if (!match)
-            {
-                match =
-                    std::ranges::any_of(row.employeeAssigned, [&](const std::string& emp)
-                    {
-                        return QString::fromStdString(emp).contains(token, Qt::CaseInsensitive);
-                    });
-            }
+        // One conversion per row; fields are separated so a token cannot match across two of them
+        QString haystack = QString::number(row.id);
+        for (const std::string* field : {&row.title, &row.area, &row.reporterName, &row.machineName, &row.costUnitName})
+            haystack += QChar('\n') + QString::fromStdString(*field);
 
-            if (!match)
-            {
-                include = false;
-                break;
-            }
-        }
+        for (const auto& emp : row.employeeAssigned)
+            haystack += QChar('\n') + QString::fromStdString(emp);
+
+        const bool include =
+            std::ranges::all_of(tokens, [&](const QString& token) { return haystack.contains(token, Qt::CaseInsensitive); });
 
         if (include)
-            _rows.push_back(row);
+            rows.push_back(rowPtr);
     }
 
-    endResetModel();
+    return rows;
 }
 
 std::optional<std::uint64_t> TicketTableModel::ticketIdForRow(int row) const
@@ -303,7 +392,7 @@ std::optional<std::uint64_t> TicketTableModel::ticketIdForRow(int row) const
     if (row < 0 || row >= _rows.size())
         return std::nullopt;
 
-    return _rows[row].id;
+    return _rows[row]->id;
 }
 
 std::optional<std::uint64_t> TicketTableModel::ticketIdForIndex(const QModelIndex& index) const
@@ -316,7 +405,7 @@ std::optional<std::uint64_t> TicketTableModel::ticketIdForIndex(const QModelInde
     if (row < 0 || row >= _rows.size())
         return std::nullopt;
 
-    return _rows[row].id;
+    return _rows[row]->id;
 }
 
 void TicketTableModel::refreshOpenDurations()
@@ -1,20 +1,22 @@
 #pragma once
 
-#include <QAbstractTableModel>
+#include <QCollatorSortKey>
 #include <QString>
 #include <optional>
+#include <unordered_map>
 #include <vector>
 
-#include "ShowTicketManager.h"
+#include "TicketRowsModel.h"
 
-class TicketTableModel : public QAbstractTableModel
+class TicketTableModel : public TicketRowsModel
 {
     Q_OBJECT
 
    public:
     explicit TicketTableModel(QObject* parent = nullptr);
 
-    void setRows(const std::vector<TicketRowData>& rows);
+    void setSnapshot(const TicketSnapshotPtr& snapshot);
+    void applyChanges(const TicketSnapshotPtr& snapshot, const TicketChangeSet& changes);
     void setFilterText(const QString& text);
 
     int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -28,11 +30,35 @@ class TicketTableModel : public QAbstractTableModel
 
     void refreshOpenDurations();
 
+    // Cell and header contents for one ticket row, shared with TicketHistoryTableModel.
+    static QVariant RowData(const TicketRowData& row, int column, int role);
+    static QVariant ColumnHeader(int section);
+
    private:
     void rebuildRows();
+    std::vector<TicketRowPtr> filteredRows() const;
+    void sortAllRows();
+    void sortByCollationKeys();
+
+    static bool IsTextColumn(int column);
+    static const std::string& SortText(const TicketRowData& row, int column);
+
+    // Collation key of one row for _sortKeyColumn. The row pointer tells
+    // whether the key is still current: changed tickets arrive as new rows.
+    struct SortKeyEntry
+    {
+        TicketRowPtr row;
+        QCollatorSortKey key;
+    };
 
    private:
     QString _filterText{};
-    std::vector<TicketRowData> _allRows;
-    std::vector<TicketRowData> _rows;
+    TicketSnapshotPtr _snapshot;
+    std::vector<TicketRowPtr> _allRows;
+
+    int _sortColumn = -1;
+    Qt::SortOrder _sortOrder = Qt::AscendingOrder;
+
+    int _sortKeyColumn = -1;
+    std::unordered_map<std::uint64_t, SortKeyEntry> _sortKeys;
 };
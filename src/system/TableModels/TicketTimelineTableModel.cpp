@@ -4,6 +4,7 @@
 #include <algorithm>
 #include <ranges>
 
+#include "CollatedSort.h"
 #include "SharedDefines.h"
 #include "TranslateMessageHelper.h"
 #include "UserCache.h"
@@ -16,6 +17,7 @@ void TicketTimelineTableModel::setEntries(const std::vector<TicketTimelineEntry>
 {
     beginResetModel();
     _allEntries = entries;
+    _sortKeys.assign(_allEntries.size(), SortKeys{});
     endResetModel();
 
     rebuildRows();
@@ -117,62 +119,78 @@ void TicketTimelineTableModel::sort(int column, Qt::SortOrder order)
     if (_allEntries.empty())
         return;
 
-    auto cmp = [column, order, this](const TicketTimelineEntry& a, const TicketTimelineEntry& b)
-    {
-        int r = 0;
+    std::vector<std::size_t> indices(_allEntries.size());
+    for (std::size_t i = 0; i < indices.size(); ++i)
+        indices[i] = i;
 
-        switch (column)
-        {
-            case 0:  // timestamp
-            {
-                if (a.timestamp < b.timestamp)
-                    r = -1;
-                else if (a.timestamp > b.timestamp)
-                    r = 1;
-                else
-                    r = 0;
-                break;
-            }
+    const bool ascending = order == Qt::AscendingOrder;
 
-            case 1:  // type (by translated name)
-            {
-                const auto sa = typeToString(a.type);
-                const auto sb = typeToString(b.type);
-                r = sa.localeAwareCompare(sb);
-                break;
-            }
+    if (column == 0)  // timestamp
+    {
+        CollatedSort::StableSort(indices, [this, ascending](std::size_t a, std::size_t b)
+        {
+            const auto& ta = _allEntries[a].timestamp;
+            const auto& tb = _allEntries[b].timestamp;
+            return ascending ? ta < tb : ta > tb;
+        });
+    }
+    else if (column >= 1 && column <= 3)  // type, user, summary text
+    {
+        const std::size_t slot = static_cast<std::size_t>(column - 1);
 
-            case 2:  // user
-            {
-                const auto sa = actorForEntry(a);
-                const auto sb = actorForEntry(b);
-                r = sa.localeAwareCompare(sb);
-                break;
-            }
+        for (std::size_t i = 0; i < _allEntries.size(); ++i)
+        {
+            auto& key = _sortKeys[i][slot];
+            if (!key)
+                key.emplace(CollatedSort::Key(sortTextForEntry(_allEntries[i], column)));
+        }
 
-            case 3:  // summary text
-            {
-                const auto sa = summaryForEntry(a);
-                const auto sb = summaryForEntry(b);
-                r = sa.localeAwareCompare(sb);
-                break;
-            }
+        CollatedSort::StableSort(indices, [this, slot, ascending](std::size_t a, std::size_t b)
+        {
+            const int r = _sortKeys[a][slot]->compare(*_sortKeys[b][slot]);
+            return ascending ? r < 0 : r > 0;
+        });
+    }
+    else
+    {
+        return;
+    }
 
-            default:
-                r = 0;
-                break;
-        }
+    // Entries and their keys move together, so keys survive re-sorting.
+    std::vector<TicketTimelineEntry> sortedEntries;
+    std::vector<SortKeys> sortedKeys;
+    sortedEntries.reserve(indices.size());
+    sortedKeys.reserve(indices.size());
 
-        return order == Qt::AscendingOrder ? (r < 0) : (r > 0);
-    };
+    for (const std::size_t i : indices)
+    {
+        sortedEntries.push_back(std::move(_allEntries[i]));
+        sortedKeys.push_back(std::move(_sortKeys[i]));
+    }
 
     beginResetModel();
-    std::ranges::sort(_allEntries, cmp);
+    _allEntries = std::move(sortedEntries);
+    _sortKeys = std::move(sortedKeys);
     endResetModel();
 
     rebuildRows();
 }
 
+QString TicketTimelineTableModel::sortTextForEntry(const TicketTimelineEntry& entry, int column) const
+{
+    switch (column)
+    {
+        case 1:
+            return typeToString(entry.type);
+        case 2:
+            return actorForEntry(entry);
+        case 3:
+            return summaryForEntry(entry);
+        default:
+            return {};
+    }
+}
+
 void TicketTimelineTableModel::rebuildRows()
 {
     beginResetModel();
@@ -354,9 +372,17 @@ QString TicketTimelineTableModel::summaryForEntry(const TicketTimelineEntry& ent
             const QString oldStatus = GetTicketStatusQString(static_cast<TicketStatus>(entry.statusHistory.oldStatus));
             const QString newStatus = GetTicketStatusQString(static_cast<TicketStatus>(entry.statusHistory.newStatus));
 
-            QString text = TranslateText::translateNew("TicketTimeline", "Status changed");
-            text += ": ";
-            text += oldStatus + " -> " + newStatus;
+            QString text;
+
+            // saves from the detail view are recorded here as well, the comment lists the changed fields
+            if (entry.statusHistory.oldStatus == entry.statusHistory.newStatus)
+                text = TranslateText::translateNew("TicketTimeline", "Ticket edited");
+            else
+            {
+                text = TranslateText::translateNew("TicketTimeline", "Status changed");
+                text += ": ";
+                text += oldStatus + " -> " + newStatus;
+            }
 
             if (!entry.statusHistory.comment.empty())
             {
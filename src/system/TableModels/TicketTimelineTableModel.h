@@ -1,10 +1,12 @@
 #pragma once
 
 #include <QAbstractTableModel>
+#include <QCollatorSortKey>
 #include <QIcon>
 #include <QString>
 #include <QColor>
 
+#include <array>
 #include <optional>
 #include <vector>
 
@@ -42,8 +44,15 @@ class TicketTimelineTableModel : public QAbstractTableModel
 
     QString actorForEntry(const TicketTimelineEntry& entry) const;
 
+    QString sortTextForEntry(const TicketTimelineEntry& entry, int column) const;
+
+    // Collation keys of the text columns (type, user, details), built on the
+    // first sort by that column and kept in step with _allEntries.
+    using SortKeys = std::array<std::optional<QCollatorSortKey>, 3>;
+
    private:
     QString _filterText{};
     std::vector<TicketTimelineEntry> _allEntries;
     std::vector<TicketTimelineEntry> _entries;
+    std::vector<SortKeys> _sortKeys;
 };
@@ -106,7 +106,11 @@ void AMSMain::CreateConnections()
         connect(GlobalSignals::instance(), &GlobalSignals::CreateTicketBackToMainPage, this, &AMSMain::DisplayMainPage);
     }
 
-    auto task = [this]() { CostUnitDataHandler::instance().Initialize(); };
+    auto task = [this]()
+    {
+        LeasePriorityScope background(LeasePriority::Background);
+        CostUnitDataHandler::instance().Initialize();
+    };
 
     Util::RunInThread(task, this);
 
@@ -4,6 +4,7 @@
 #include "ComboBoxDataLoader.h"
 #include "ConnectionGuard.h"
 #include "CostUnitDataHandler.h"
+#include "MachineDataHandler.h"
 #include "RoomTableModel.h"
 #include "SettingsManager.h"
 #include "TableSearchHelper.h"
@@ -606,6 +607,10 @@ void AssetManager::SetupMachineListTab()
 
     auto task = [this]()    
     {
+        LeasePriorityScope background(LeasePriority::Background);
+
+        // line, type, room and manufacturer names shown in the list; unchanged tables are not reloaded
+        MachineDataHandler::instance().Refresh();
         _machineListMgr->LoadMachineListFromDatabase();
         auto data = _machineListMgr->GetMachineData();
 
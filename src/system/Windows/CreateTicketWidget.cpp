@@ -4,6 +4,7 @@
 
 #include "AMSMain.h"
 #include "CostUnitDataHandler.h"
+#include "MachineDataHandler.h"
 #include "GlobalSignals.h"
 #include "MessageBoxHelper.h"
 #include "Util.h"
@@ -414,6 +415,8 @@ void CreateTicketWidget::LoadMachineListTable()
 
     auto task = [this]()
     {
+        // line, type, room and manufacturer names shown in the list; unchanged tables are not reloaded
+        MachineDataHandler::instance().Refresh();
         _machineListMgr->LoadMachineListFromDatabase();
         auto localMap = _machineListMgr->GetMachineDataByCostUnitID(_ticketInfo.costUnitID);
 
@@ -7,8 +7,10 @@
 #include <QTimer>
 
 #include "ContractorVisitLeftOverlayDelegate.h"
+#include "Databases.h"
 #include "TicketAgeTextDelegate.h"
 #include "TicketColorDelegate.h"
+#include "TicketStore.h"
 #include "Util.h"
 #include "WordWrapItemDelegate.h"
 #include "pch.h"
@@ -24,12 +26,9 @@ OperationsDashboardWidget::OperationsDashboardWidget(QWidget* parent)
 
     EnsureTicketUi();
 
-    _ticketMgr = std::make_unique<ShowTicketManager>();
     _contractVisitMgr = std::make_unique<ContractorVisitManager>();
 
-    _lastSyncDb = "1970-01-01 00:00:00";
-
-    LoadTicketsInitial();
+    AttachTicketStore();
     StartAutoRefresh();
 
     // Contractor Visits
@@ -39,7 +38,11 @@ OperationsDashboardWidget::OperationsDashboardWidget(QWidget* parent)
     connect(ui->pB_ExitFullscreen, &QPushButton::clicked, this, &OperationsDashboardWidget::onPushExitFullscreen);
 }
 
-OperationsDashboardWidget::~OperationsDashboardWidget() { delete ui; }
+OperationsDashboardWidget::~OperationsDashboardWidget()
+{
+    TicketStore::instance()->Detach();
+    delete ui;
+}
 
 void OperationsDashboardWidget::setTextPointSize(uint8_t size)
 {
@@ -63,6 +66,10 @@ void OperationsDashboardWidget::setTextPointSize(uint8_t size)
         view->viewport()->update();
     };
 
+    // Wrapped layouts are per font; the old size's entries would never hit again.
+    if (_ticketDelegate != nullptr)
+        _ticketDelegate->ClearLayoutCache();
+
     apply(ui->tv_tickets);
     apply(ui->tv_contractorVisits);
 }
@@ -145,78 +152,40 @@ void OperationsDashboardWidget::EnsureTicketUi()
     }
 }
 
-void OperationsDashboardWidget::LoadTicketsInitial()
+void OperationsDashboardWidget::AttachTicketStore()
 {
-    if (_refreshActive.exchange(true))
-        return;
+    // Tickets come from the shared TicketStore; it owns the 30 s delta refresh.
+    auto* store = TicketStore::instance();
+    connect(store, &TicketStore::SnapshotChanged, this, &OperationsDashboardWidget::OnTicketSnapshotChanged);
 
-    auto task = [this]()
-    {
-        _ticketMgr->LoadTableTicketData();
-        auto rows = _ticketMgr->GetTableTicketVectorNoCopy();
-
-        const std::string newSync = Util::CurrentDateTimeStringStd();
+    auto snapshot = store->GetSnapshot();
+    TicketChangeSet initial{};
+    initial.toVersion = snapshot->version;
+    initial.fullReload = true;
+    OnTicketSnapshotChanged(snapshot, std::make_shared<const TicketChangeSet>(std::move(initial)));
 
-        QMetaObject::invokeMethod(
-            this,
-            [this, rows = std::move(rows), newSync]()
-            {
-                _ticketModel->setRows(rows);
-
-                ui->tv_tickets->setSortingEnabled(true);
-                ui->tv_tickets->sortByColumn(0, Qt::AscendingOrder);
-
-                _lastSyncDb = newSync;
-                _ticketsScroller->BeginTicketTableUpdate();
-                ApplyTicketViewLayout(true);
-                _ticketsScroller->EndTicketTableUpdate();
-                EnsureTicketUi();
-                _refreshActive.store(false);
-            },
-            Qt::QueuedConnection);
-    };
-
-    Util::RunInThread(std::move(task), this);
+    store->Attach();
 }
 
-void OperationsDashboardWidget::LoadTicketsDelta()
+void OperationsDashboardWidget::OnTicketSnapshotChanged(const TicketSnapshotPtr& snapshot, const TicketChangeSetPtr& changes)
 {
-    if (_refreshActive.exchange(true))
-        return;
+    EnsureTicketUi();
 
-    const std::string since = _lastSyncDb;
+    _ticketModel->ApplyChanges(snapshot, *changes);
 
-    auto task = [this, since]()
+    if (changes->fullReload)
     {
-        auto delta = _ticketMgr->LoadTableTicketDelta(since);
-
-        QMetaObject::invokeMethod(
-            this,
-            [this, delta = std::move(delta)]() mutable
-            {
-                _ticketModel->ApplyDelta(delta.upserts, delta.removedIds);
-                _lastSyncDb = Util::FormatDateTimeStd(delta.newSyncPoint);
-                _ticketsScroller->BeginTicketTableUpdate();
-                ApplyTicketViewLayout(true);
-                _ticketsScroller->EndTicketTableUpdate();
-                EnsureTicketUi();
-
-                _refreshActive.store(false);
-            },
-            Qt::QueuedConnection);
-    };
+        ui->tv_tickets->setSortingEnabled(true);
+        ui->tv_tickets->sortByColumn(0, Qt::AscendingOrder);
+    }
 
-    Util::RunInThread(std::move(task), this);
+    _ticketsScroller->BeginTicketTableUpdate();
+    ApplyTicketViewLayout(true);
+    _ticketsScroller->EndTicketTableUpdate();
 }
 
 void OperationsDashboardWidget::StartAutoRefresh()
 {
-    if (!_refreshTimer)
-    {
-        _refreshTimer = new QTimer(this);
-        connect(_refreshTimer, &QTimer::timeout, this, [this]() { LoadTicketsInitial(); });
-    }
-
     if (!_openForTimer)
     {
         _openForTimer = new QTimer(this);
@@ -228,7 +197,6 @@ void OperationsDashboardWidget::StartAutoRefresh()
                 });
     }
 
-    _refreshTimer->start(30 * 1000);  // DB delta refresh
     _openForTimer->start(60 * 1000);  // update "Open For" column + delegate colors
 }
 
@@ -338,6 +306,8 @@ void OperationsDashboardWidget::LoadContractorInitial()
 
     auto task = [this]()
     {
+        LeasePriorityScope background(LeasePriority::Background);
+
         _contractVisitMgr->LoadContractorVisitData();
         auto rows = _contractVisitMgr->GetContractorVisits();
 
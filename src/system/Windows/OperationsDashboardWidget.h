@@ -42,8 +42,8 @@ class OperationsDashboardWidget : public QWidget
 
    private:
     void EnsureTicketUi();
-    void LoadTicketsInitial();
-    void LoadTicketsDelta();
+    void AttachTicketStore();
+    void OnTicketSnapshotChanged(const TicketSnapshotPtr& snapshot, const TicketChangeSetPtr& changes);
     void StartAutoRefresh();
     void ApplyTicketViewLayout(bool tvMode);
 
@@ -52,16 +52,12 @@ class OperationsDashboardWidget : public QWidget
 
     Ui::OperationsDashboardWidgetClass *ui;
     TicketOperationDashboardModel *_ticketModel;
-    std::unique_ptr<ShowTicketManager> _ticketMgr;
 
     std::unique_ptr<ContractorVisitManager> _contractVisitMgr;
     ContractorVisitModel *_contractVisitModel;
 
-    std::atomic_bool _refreshActive{false};
     std::atomic_bool _refreshActiveContractor{false};
-    std::string _lastSyncDb;
 
-    QTimer *_refreshTimer = nullptr;
     QTimer *_openForTimer = nullptr;
 
 
@@ -15,6 +15,7 @@
 #include "TicketSparePartsUsedActionDelegate.h"
 #include "TicketReportManager.h"
 #include "RBACVisibilityHelper.h"
+#include "UiChangeBinding.h"
 
 ShowTicketDetailWidget::ShowTicketDetailWidget(QWidget *parent) : QWidget(parent), ui(new Ui::ShowTicketDetailWidgetClass()), _ticketID(0),
 _ticketTimelineModel(nullptr), _ticketAssignEmployeeModel(nullptr), _ticketAttachmentModel(nullptr), _ticketCommentModel(nullptr), _ticketSparePartsModel(nullptr), _articleSearchModel(nullptr),
@@ -92,26 +93,8 @@ _ticketTimelineModel(nullptr), _ticketAssignEmployeeModel(nullptr), _ticketAttac
     _ticketDetailManager->FillTicketStatusBox(ui->cb_newStatus);
     _ticketDetailManager->FillTicketPriorityBox(ui->cb_priority);
 
-    connect(ui->cb_priority, &QComboBox::currentIndexChanged, this, [this](int index)
-    {
-        if (index < 0)
-            return;
-
-        TicketPriority prio = static_cast<TicketPriority>(ui->cb_priority->itemData(index).toInt());
-        ui->tb_priority->setText(GetTicketPriorityQString(prio));
-        _ticketDetailManager->UpdatePriority(_ticketID, prio);
-
-    });
-
-    connect(ui->cb_newStatus, &QComboBox::currentIndexChanged, this, [this](int index)
-    {
-        if (index < 0)
-            return;
-
-        TicketStatus status = static_cast<TicketStatus>(ui->cb_newStatus->itemData(index).toInt());
-        ui->tb_currentStatus->setText(GetTicketStatusQString(status));
-        _ticketDetailManager->UpdateStatus(_ticketID, status);
-    });
+    SetupTicketChangeTracking();
+    UpdateTicketUiState();
 
     connect(ui->pb_searchParts, &QPushButton::clicked, this, &ShowTicketDetailWidget::onPushSearchArticle);
     connect(ui->le_searchParts, &QLineEdit::returnPressed, this, &ShowTicketDetailWidget::onPushSearchArticle);
@@ -190,106 +173,131 @@ void ShowTicketDetailWidget::LoadAndFillData(std::uint64_t ticketID)
 
     _ticketID = ticketID;
 
-    auto task = [this, ticketID]()
-    {
-        QMetaObject::invokeMethod(
-        this, [this]()
-        {
-                ui->pb_loadingIndicator->setVisible(true);
-                ui->pb_loadingIndicator->setRange(0, 100);
+    ui->pb_loadingIndicator->setVisible(true);
+    ui->pb_loadingIndicator->setRange(0, 100);
+
+    _loadingValue = 0;
+    ui->pb_loadingIndicator->setValue(_loadingValue);
 
-                _loadingValue = 0;
-                ui->pb_loadingIndicator->setValue(_loadingValue);
+    if (_loadingTimer && !_loadingTimer->isActive())
+        _loadingTimer->start();
 
-                if (_loadingTimer && !_loadingTimer->isActive())
-                    _loadingTimer->start();
-        }, Qt::QueuedConnection);
+    // A newer request supersedes whatever is still in flight for the previous ticket
+    _detailsFuture.Cancel();
 
+    // Show a cached snapshot right away; the version probe below only replaces it if it changed
+    _shownDetails = nullptr;
+    if (auto cached = ShowTicketManager::PeekTicketDetails(ticketID))
+        ApplyTicketDetails(cached);
 
-        _ticketDetailManager->LoadTicketDetails(ticketID); // Load ticket details using the provided ticketID
-        _ticketData = _ticketDetailManager->GetTicketData();    // Assuming a method to get the ticket data
-        auto localMap = _ticketData;
+    _detailsFuture = _ticketDetailManager->LoadTicketDetailsAsync(ticketID);
+    _detailsFuture.Then(this,
+        [this, ticketID](QueryOutcome<TicketDetailsPtr> outcome)
+        {
+            if (ticketID != _ticketID || outcome.status == QueryStatus::Cancelled)
+                return;
+
+            ui->pb_loadingIndicator->setVisible(false);
+
+            if (!outcome.Ok() || !*outcome.value)
+            {
+                LOG_ERROR("Loading ticket {} failed: {}", ticketID, outcome.error);
+                return;
+            }
 
+            if (*outcome.value != _shownDetails)
+                ApplyTicketDetails(*outcome.value);
+        });
+
+    // Employee list is independent of the ticket details, load it alongside
+    auto task = [this, ticketID]()
+    {
         _employeeMgr->LoadEmployeeData();
         auto empTable = _employeeMgr->LoadEmployeeDataForDetails(ticketID);
 
-
         QMetaObject::invokeMethod(
             this,
-            [this, localMap = std::move(localMap), empTable = std::move(empTable)]()
+            [this, ticketID, empTable = std::move(empTable)]()
             {
-                // Ensure model exists once
-                if (!_ticketTimelineModel)
-                {
-                    _ticketTimelineModel = new TicketTimelineTableModel(this);
-                    ui->tv_ticketData->setModel(_ticketTimelineModel);
-                    ui->tv_ticketData->setSortingEnabled(true);
-                }
+                if (ticketID != _ticketID)
+                    return;
 
-                _ticketTimelineModel->setEntries(localMap.timeline);
-                FillTicketDetailData();
+                _ticketAssignEmployeeModel->setRows(empTable);
+                ui->tv_employee->hideColumn(0);  // hide ID column
+            },
+            Qt::QueuedConnection);
+    };
 
-                if (!_ticketAssignEmployeeModel)
-                {
-                    _ticketAssignEmployeeModel = new AssignEmployeeTableModel(this);
-                    ui->tv_employee->setModel(_ticketAssignEmployeeModel);
-                    ui->tv_employee->setSortingEnabled(true);
-                }
+    Util::RunInThread(std::move(task), this);
 
-                _ticketAssignEmployeeModel->setRows(empTable);
+    LoadSparePartTable(ticketID);
+    LoadTicketReport(ticketID);
+    LoadSimilarTickets(ticketID);
+}
 
-                ui->tv_employee->hideColumn(0);  // hide ID column
+void ShowTicketDetailWidget::ApplyTicketDetails(const TicketDetailsPtr& details)
+{
+    // A newer snapshot of the ticket on screen must not discard what the user typed meanwhile
+    bool keepEdits = _shownDetails && _shownDetails->ticketInfo.id == details->ticketInfo.id && _ticketTracker.IsDirty();
+    std::optional<std::uint32_t> editedRowVersion;
 
-                
-                if (!_ticketAttachmentModel)
-                {
-                    _ticketAttachmentModel = new TicketAttachmentTableModel(this);
-                    ui->tv_fileTable->setModel(_ticketAttachmentModel);
-                    ui->tv_fileTable->setSortingEnabled(true);
-                }
+    if (keepEdits)
+    {
+        const auto& shown = _shownDetails->ticketInfo;
+        const auto& current = details->ticketInfo;
 
-                _ticketAttachmentModel->setAttachments(localMap.ticketAttachment);
+        const bool editableChanged = shown.title != current.title || shown.description != current.description ||
+                                     shown.priority != current.priority || shown.currentStatus != current.currentStatus;
 
-                {
-                    auto* h = ui->tv_fileTable->horizontalHeader();
-                    h->setSectionResizeMode(0, QHeaderView::Stretch);
-                    h->setSectionResizeMode(1, QHeaderView::Stretch);
-                    h->setSectionResizeMode(2, QHeaderView::ResizeToContents);
-                    h->setSectionResizeMode(3, QHeaderView::ResizeToContents);
-                    h->setSectionResizeMode(4, QHeaderView::ResizeToContents);
-                    h->setSectionResizeMode(5, QHeaderView::ResizeToContents);
-                }
+        if (editableChanged)
+        {
+            const auto answer = QMessageBox::question(this, tr("Ticket changed"),
+                tr("This ticket was changed by someone else while you were editing it.\n\n"
+                   "Show the current version? Your unsaved changes will be lost."),
+                QMessageBox::Yes | QMessageBox::No);
+
+            if (answer == QMessageBox::Yes)
+                keepEdits = false;
+            else
+                editedRowVersion = _ticketData.ticketInfo.rowVersion;  // Save reports the conflict
+        }
+    }
 
-                if (!_ticketCommentModel)
-                {
-                    _ticketCommentModel = new TicketCommentTableModel(this);
-                    ui->tv_commentTable->setModel(_ticketCommentModel);
-                    ui->tv_commentTable->setSortingEnabled(true);
-                }
+    _shownDetails = details;
 
-                _ticketCommentModel->setData(localMap.ticketComment);
+    _ticketDetailManager->SetTicketData(*details);
+    _ticketData = _ticketDetailManager->GetTicketData();
 
-                {
-                    ui->tv_commentTable->setColumnHidden(0, true);  // ID
-                    ui->tv_commentTable->setColumnHidden(2, true);  // updated_at
-                    ui->tv_commentTable->setColumnHidden(4, true);  // internal
-                    ui->tv_commentTable->setColumnHidden(5, true);  // deleted
-                }
+    if (editedRowVersion)
+        _ticketData.ticketInfo.rowVersion = *editedRowVersion;
 
-                ui->pb_loadingIndicator->setVisible(false);
-            },
-            Qt::QueuedConnection);
-    };
+    _ticketTimelineModel->setEntries(_ticketData.timeline);
+    FillTicketDetailData(keepEdits);
 
-    Util::RunInThread(std::move(task), this);
+    _ticketAttachmentModel->setAttachments(_ticketData.ticketAttachment);
 
-    LoadSparePartTable(ticketID);
-    LoadTicketReport(ticketID);
-    LoadSimilarTickets(ticketID);
+    {
+        auto* h = ui->tv_fileTable->horizontalHeader();
+        h->setSectionResizeMode(0, QHeaderView::Stretch);
+        h->setSectionResizeMode(1, QHeaderView::Stretch);
+        h->setSectionResizeMode(2, QHeaderView::ResizeToContents);
+        h->setSectionResizeMode(3, QHeaderView::ResizeToContents);
+        h->setSectionResizeMode(4, QHeaderView::ResizeToContents);
+        h->setSectionResizeMode(5, QHeaderView::ResizeToContents);
+    }
+
+    _ticketCommentModel->setData(_ticketData.ticketComment);
+
+    {
+        ui->tv_commentTable->setColumnHidden(0, true);  // ID
+        ui->tv_commentTable->setColumnHidden(2, true);  // updated_at
+        ui->tv_commentTable->setColumnHidden(4, true);  // internal
+        ui->tv_commentTable->setColumnHidden(5, true);  // deleted
+    }
 }
 
-void ShowTicketDetailWidget::FillTicketDetailData()
-{ 
+void ShowTicketDetailWidget::FillTicketDetailData(bool keepEdits)
+{
     ui->tb_ticketID->setText(QString::number(_ticketData.ticketInfo.id));
 
     if (auto userData = GetUserDataByID(_ticketData.ticketInfo.creatorUserID))
@@ -306,10 +314,19 @@ void ShowTicketDetailWidget::FillTicketDetailData()
     const QString callerName = tr("%1 (%2)").arg(QString::fromStdString(_ticketData.callerInfo.name), QString::fromStdString(_ticketData.callerInfo.phone));
     ui->tb_reporter->setText(callerName);
 
-    ui->le_ticketTitle->setText(QString::fromStdString(_ticketData.ticketInfo.title));
-    ui->le_ticketTitle->setModified(false);
-    ui->pte_ticketDescription->setPlainText(QString::fromStdString(_ticketData.ticketInfo.description));
-    ui->pte_ticketDescription->document()->setModified(false);
+    if (!keepEdits)
+    {
+        {
+            ChangeTracker<TicketField>::SuspendGuard guard(_ticketTracker);
+
+            ui->le_ticketTitle->setText(QString::fromStdString(_ticketData.ticketInfo.title));
+            ui->pte_ticketDescription->setPlainText(QString::fromStdString(_ticketData.ticketInfo.description));
+            ui->cb_priority->setCurrentIndex(static_cast<int>(_ticketData.ticketInfo.priority));
+            ui->cb_newStatus->setCurrentIndex(static_cast<int>(_ticketData.ticketInfo.currentStatus));
+        }
+
+        ResetTicketDirtyStatus();
+    }
 
     ui->tb_entityName->setText(QString::fromStdString(_ticketData.machineInfo.MachineName));
     ui->tb_entityLineID->setText(_ticketDetailManager->LoadMachineLineName(_ticketData.machineInfo.LineID));
@@ -317,10 +334,45 @@ void ShowTicketDetailWidget::FillTicketDetailData()
     ui->tb_entityNumber->setText(QString::fromStdString(_ticketData.machineInfo.MachineNumber));
     ui->tb_entityManufacturer->setText(QString::fromStdString(_ticketData.machineInfo.ManufacturerMachineNumber));
     ui->lb_ph_manufacturerName->setText(_ticketDetailManager->LoadManufacturerName(_ticketData.machineInfo.ManufacturerID));
+}
+
+void ShowTicketDetailWidget::SetupTicketChangeTracking()
+{
+    // Edits are only collected here, pb_save writes them with one statement
+    auto onChanged = [this]() { UpdateTicketUiState(); };
+
+    BindComboBox(ui->cb_newStatus, _ticketTracker, TicketField::Status, onChanged);
+    BindComboBox(ui->cb_priority, _ticketTracker, TicketField::Priority, onChanged);
+    BindLineEdit(ui->le_ticketTitle, _ticketTracker, TicketField::Title, onChanged);
+    BindTextEdit(ui->pte_ticketDescription, _ticketTracker, TicketField::Description, onChanged);
+}
 
+void ShowTicketDetailWidget::UpdateTicketUiState()
+{
+    // Fields the user may not change are disabled, so anything dirty is permitted
+    ui->pb_save->setEnabled(CanEditTicketDetails() && _ticketTracker.IsDirty());
+}
 
-    ui->cb_priority->setCurrentIndex(static_cast<int>(_ticketData.ticketInfo.priority));
-    ui->cb_newStatus->setCurrentIndex(static_cast<int>(_ticketData.ticketInfo.currentStatus));
+bool ShowTicketDetailWidget::CanEditTicketDetails()
+{
+    // pb_save writes title, description, priority and status together
+    return RBACAccess::HasPermission(static_cast<std::uint32_t>(Permission::RBAC_CHANGE_TICKET_TITLE_DESCRIPTION)) ||
+           RBACAccess::HasPermission(static_cast<std::uint32_t>(Permission::RBAC_CHANGE_TICKET_PRIORITY)) ||
+           RBACAccess::HasPermission(static_cast<std::uint32_t>(Permission::RBAC_CHANGE_TICKET_STATUS));
+}
+
+void ShowTicketDetailWidget::ResetTicketDirtyStatus()
+{
+    ChangeTracker<TicketField>::SuspendGuard guard(_ticketTracker);
+
+    _ticketTracker.SetValueForced(TicketField::Status, ui->cb_newStatus->currentData());
+    _ticketTracker.SetValueForced(TicketField::Priority, ui->cb_priority->currentData());
+    _ticketTracker.SetValueForced(TicketField::Title, ui->le_ticketTitle->text());
+    _ticketTracker.SetValueForced(TicketField::Description, ui->pte_ticketDescription->toPlainText());
+
+    _ticketTracker.BeginSnapshot();
+
+    UpdateTicketUiState();
 }
 
 void ShowTicketDetailWidget::ChangeEmployeeAssignment(bool assign)
@@ -372,55 +424,52 @@ void ShowTicketDetailWidget::ChangeEmployeeAssignment(bool assign)
 
 void ShowTicketDetailWidget::ReloadTimeline()
 {
-    const auto id = _ticketID;
+    ReloadTicketDetails(
+        [this](const ShowTicketData& updated)
+        {
+            if (_ticketTimelineModel)
+                _ticketTimelineModel->setEntries(updated.timeline);
+        });
+}
 
-    auto task = [this, id]()
-    {
-        _ticketDetailManager->LoadTicketDetails(id);
-        auto updated = _ticketDetailManager->GetTicketData();
+void ShowTicketDetailWidget::ReloadCommentTable()
+{
+    ReloadTicketDetails(
+        [this](const ShowTicketData& updated)
+        {
+            if (_ticketCommentModel)
+                _ticketCommentModel->setData(updated.ticketComment);
 
-        QMetaObject::invokeMethod(
-            this,
-            [this, updated = std::move(updated)]()
-            {
-                if (_ticketTimelineModel)
-                    _ticketTimelineModel->setEntries(updated.timeline);
-            },
-            Qt::QueuedConnection);
-    };
+            if (_ticketTimelineModel)
+                _ticketTimelineModel->setEntries(updated.timeline);
 
-    Util::RunInThread(std::move(task), this);
+            ui->tv_commentTable->setColumnHidden(0, true); // ID
+            ui->tv_commentTable->setColumnHidden(2, true); // updated_at
+            ui->tv_commentTable->setColumnHidden(4, true); // internal
+            ui->tv_commentTable->setColumnHidden(5, true);  // deleted
+        });
 }
 
-void ShowTicketDetailWidget::ReloadCommentTable()
+void ShowTicketDetailWidget::ReloadTicketDetails(std::function<void(const ShowTicketData&)> apply)
 {
     const auto id = _ticketID;
 
-    auto task = [this, id]()
-    {
-        _ticketDetailManager->LoadTicketDetails(id);
-        auto updated = _ticketDetailManager->GetTicketData();
+    // The worker only produces the snapshot; _ticketDetailManager is touched on the GUI thread alone
+    _ticketDetailManager->LoadTicketDetailsAsync(id).Then(this,
+        [this, id, apply = std::move(apply)](QueryOutcome<TicketDetailsPtr> outcome)
+        {
+            if (id != _ticketID || outcome.status == QueryStatus::Cancelled)
+                return;
 
-        QMetaObject::invokeMethod(
-            this,
-            [this, updated = std::move(updated)]()
+            if (!outcome.Ok() || !*outcome.value)
             {
-                if (_ticketCommentModel)
-                    _ticketCommentModel->setData(updated.ticketComment);
+                LOG_ERROR("Reloading ticket {} failed: {}", id, outcome.error);
+                return;
+            }
 
-                if (_ticketTimelineModel)
-                    _ticketTimelineModel->setEntries(updated.timeline);
-
-                ui->tv_commentTable->setColumnHidden(0, true); // ID
-                ui->tv_commentTable->setColumnHidden(2, true); // updated_at
-                ui->tv_commentTable->setColumnHidden(4, true); // internal
-                ui->tv_commentTable->setColumnHidden(5, true);  // deleted
-
-            },
-            Qt::QueuedConnection);
-    };
-
-    Util::RunInThread(std::move(task), this);
+            _ticketDetailManager->SetTicketData(**outcome.value);
+            apply(_ticketDetailManager->GetTicketData());
+        });
 }
 
 void ShowTicketDetailWidget::LoadSparePartTable(std::uint64_t ticketID)
@@ -548,7 +597,7 @@ void ShowTicketDetailWidget::ApplyRBACVisibility()
 {
     ChangeVisibilityAndTooltip(Permission::RBAC_CHANGE_TICKET_TITLE_DESCRIPTION, ui->le_ticketTitle);
     ChangeVisibilityAndTooltip(Permission::RBAC_CHANGE_TICKET_TITLE_DESCRIPTION, ui->pte_ticketDescription);
-    ChangeVisibilityAndTooltip(Permission::RBAC_CHANGE_TICKET_TITLE_DESCRIPTION, ui->pb_save);
+    UpdateTicketUiState();  // pb_save
     ChangeVisibilityAndTooltip(Permission::RBAC_CHANGE_TICKET_PRIORITY, ui->cb_priority);
     ChangeVisibilityAndTooltip(Permission::RBAC_CHANGE_TICKET_STATUS, ui->cb_newStatus);
     ChangeVisibilityAndTooltip(Permission::RBAC_ASSIGN_UNASSIGN_EMPLOYEE, ui->pb_assignEmployee);
@@ -664,27 +713,15 @@ void ShowTicketDetailWidget::onAttachmentDoubleClicked(const QModelIndex& index)
 
 void ShowTicketDetailWidget::onFileUploadFinish()
 {
-    const auto id = _ticketID;
-
-    auto task = [this, id]()
-    {
-        _ticketDetailManager->LoadTicketDetails(id);
-        auto updated = _ticketDetailManager->GetTicketData();
-
-        QMetaObject::invokeMethod(
-            this,
-            [this, updated = std::move(updated)]()
-            {
-                if (_ticketAttachmentModel)
-                    _ticketAttachmentModel->setAttachments(updated.ticketAttachment);
-
-                if (_ticketTimelineModel)
-                    _ticketTimelineModel->setEntries(updated.timeline);
-            },
-            Qt::QueuedConnection);
-    };
+    ReloadTicketDetails(
+        [this](const ShowTicketData& updated)
+        {
+            if (_ticketAttachmentModel)
+                _ticketAttachmentModel->setAttachments(updated.ticketAttachment);
 
-    Util::RunInThread(std::move(task), this);
+            if (_ticketTimelineModel)
+                _ticketTimelineModel->setEntries(updated.timeline);
+        });
 }
 
 void ShowTicketDetailWidget::onPushAddComment()
@@ -885,36 +922,54 @@ void ShowTicketDetailWidget::onPushSaveReport()
 
 void ShowTicketDetailWidget::onPushSaveTicketDetails()
 {
-    if (!isTicketTitleModified() && !isTicketDescriptionModified())
+    if (!CanEditTicketDetails())
+        return;
+
+    if (!_ticketTracker.IsDirty())
     {
         QMessageBox::information(this, tr("No changes"), tr("There are no changes to save."));
         return;
     }
 
-    bool ok = false;
-
-    if (isTicketTitleModified())
+    switch (_ticketDetailManager->SaveTicketChanges(_ticketID, _ticketData.ticketInfo.rowVersion, _ticketTracker))
     {
-        const QString newTitle = ui->le_ticketTitle->text();
-        ok = _ticketDetailManager->UpdateTicketTitle(_ticketID, newTitle);
-        setTicketTitleModified(false);
-    }
+        case TicketSaveResult::Saved:
+        case TicketSaveResult::NoChanges:
+            break;
 
-    if (isTicketDescriptionModified())
-    {
-        const QString newDescription = ui->pte_ticketDescription->toPlainText();
-        ok = _ticketDetailManager->UpdateTicketDescription(_ticketID, newDescription);
-        setTicketDescriptionModified(false);
-    }
+        case TicketSaveResult::Conflict:
+        {
+            const auto answer = QMessageBox::warning(this, tr("Ticket changed"),
+                tr("This ticket was changed by someone else after you opened it, your changes were not saved.\n\n"
+                   "Reload the ticket now? Your unsaved changes will be lost."),
+                QMessageBox::Yes | QMessageBox::No);
 
-    if (!ok)
-    {
-        QMessageBox::warning(this, tr("Save failed"), tr("Could not save the changes to the ticket."));
-        return;
+            if (answer == QMessageBox::Yes)
+                LoadAndFillData(_ticketID);
+            return;
+        }
+
+        case TicketSaveResult::Failed:
+        default:
+            QMessageBox::warning(this, tr("Save failed"), tr("Could not save the changes to the ticket."));
+            return;
     }
 
-    QMessageBox::information(this, tr("Save successful"), tr("The changes to the ticket have been saved successfully."));
+    const auto status = static_cast<TicketStatus>(ui->cb_newStatus->currentData().toInt());
+    const auto priority = static_cast<TicketPriority>(ui->cb_priority->currentData().toInt());
 
+    _ticketData.ticketInfo.currentStatus = static_cast<std::uint8_t>(status);
+    _ticketData.ticketInfo.priority = static_cast<std::uint8_t>(priority);
+    _ticketData.ticketInfo.title = ui->le_ticketTitle->text().toStdString();
+    _ticketData.ticketInfo.description = ui->pte_ticketDescription->toPlainText().toStdString();
+
+    ui->tb_currentStatus->setText(GetTicketStatusQString(status));
+    ui->tb_priority->setText(GetTicketPriorityQString(priority));
+
+    ResetTicketDirtyStatus();
+    ReloadTimeline();
+
+    QMessageBox::information(this, tr("Save successful"), tr("The changes to the ticket have been saved successfully."));
 }
 
 void ShowTicketDetailWidget::onPushCloseTicket()
@@ -34,19 +34,25 @@ public:
 	void LoadAndFillData(std::uint64_t ticketID);
 
 private:
-    void FillTicketDetailData();
+    // keepEdits leaves title, description, priority and status as the user
+    // changed them; everything else follows _ticketData.
+    void FillTicketDetailData(bool keepEdits);
+    void ApplyTicketDetails(const TicketDetailsPtr& details);
     void ChangeEmployeeAssignment(bool assign);
     void ReloadTimeline();
     void ReloadCommentTable();
+    // Loads the current ticket off the GUI thread and hands the rebuilt data
+    // to apply on the GUI thread.
+    void ReloadTicketDetails(std::function<void(const ShowTicketData&)> apply);
 
     void LoadSparePartTable(std::uint64_t ticketID);
     void LoadTicketReport(std::uint64_t ticketID);
     void LoadSimilarTickets(std::uint64_t ticketID);
 
-    bool isTicketTitleModified() const { return ui->le_ticketTitle->isModified(); }
-    bool isTicketDescriptionModified() const { return ui->pte_ticketDescription->document()->isModified(); }
-    void setTicketTitleModified(bool modified) const { ui->le_ticketTitle->setModified(modified); }
-    void setTicketDescriptionModified(bool modified) const { ui->pte_ticketDescription->document()->setModified(modified); }
+    void SetupTicketChangeTracking();
+    void UpdateTicketUiState();
+    static bool CanEditTicketDetails();
+    void ResetTicketDirtyStatus();
 
     void ApplyRBACVisibility();    
 
@@ -74,7 +80,10 @@ private:
     std::unique_ptr<TicketReportManager> _ticketReportMgr;
     std::unique_ptr<SimilarReportManager> _similarReportMgr;
 	ShowTicketData _ticketData;
+    QueryFuture<TicketDetailsPtr> _detailsFuture;
+    TicketDetailsPtr _shownDetails;
     TicketReportData _ticketReportData {};
+    ChangeTracker<TicketField> _ticketTracker;
 
     bool _reportExist;
 
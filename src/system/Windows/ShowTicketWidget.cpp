@@ -1,40 +1,45 @@
 #include "ShowTicketWidget.h"
 
 #include "TicketAgeTextDelegate.h"
+#include "TicketStore.h"
 
-ShowTicketWidget::ShowTicketWidget(QWidget *parent) : QWidget(parent), ui(new Ui::ShowTicketWidgetClass()), _ticketModel(nullptr), _ticketMgr(nullptr), _ticketDetailWidget(nullptr)
+ShowTicketWidget::ShowTicketWidget(QWidget *parent) : QWidget(parent), ui(new Ui::ShowTicketWidgetClass()), _ticketModel(nullptr), _ticketDetailWidget(nullptr)
 {
 	ui->setupUi(this);
     LoadTableData();
 
     {
-        auto updateFilter = [this]()
-        {
-            QString filter;
-
-            if (!ui->le_search->text().trimmed().isEmpty())
-                filter += ui->le_search->text().trimmed() + " ";
-
-            filter = filter.trimmed();
-
-            _ticketModel->setFilterText(filter);
-        };
-
-        connect(ui->le_search, &QLineEdit::textChanged, this, [updateFilter]() { updateFilter(); });
+        // Typing restarts the timer; the filter (a server query in history mode) runs once input pauses
+        _searchTimer = new QTimer(this);
+        _searchTimer->setSingleShot(true);
+        _searchTimer->setInterval(300);
+        connect(_searchTimer, &QTimer::timeout, this, &ShowTicketWidget::ApplySearchFilter);
+
+        connect(ui->le_search, &QLineEdit::textChanged, this, [this]() { _searchTimer->start(); });
+        connect(ui->le_search, &QLineEdit::returnPressed, this, [this]()
+                {
+                    _searchTimer->stop();
+                    ApplySearchFilter();
+                });
 
         connect(ui->pb_reset, &QPushButton::clicked, this,
                 [this]()
                 {
                     ui->le_search->clear();
-
-                    _ticketModel->setFilterText(QString());
+                    _searchTimer->stop();
+                    ApplySearchFilter();
                 });
+
+        connect(ui->cb_showHistory, &QCheckBox::toggled, this, &ShowTicketWidget::SetHistoryMode);
     }
 
     connect(ui->tv_showTickets, &QTableView::doubleClicked, this,
             [this](const QModelIndex& idx)
             {
-                auto id = _ticketModel->ticketIdForIndex(idx);
+                if (!idx.isValid())
+                    return;
+
+                auto id = TicketIdForRow(idx.row());
 
                 if (!id)
                     return;
@@ -52,6 +57,14 @@ ShowTicketWidget::ShowTicketWidget(QWidget *parent) : QWidget(parent), ui(new Ui
                 _ticketDetailWidget->show();
             });
 
+    // Selecting a row warms the detail cache for it and its neighbours, debounced so
+    // scrolling with the keyboard does not start a load for every row passed.
+    _prefetchTimer = new QTimer(this);
+    _prefetchTimer->setSingleShot(true);
+    _prefetchTimer->setInterval(200);
+    connect(_prefetchTimer, &QTimer::timeout, this, &ShowTicketWidget::PrefetchAroundCurrentRow);
+    ConnectSelection();
+
     auto* timer = new QTimer(this);
     timer->setInterval(60 * 1000);  // 1 minute
     connect(timer, &QTimer::timeout, _ticketModel, &TicketTableModel::refreshOpenDurations);
@@ -59,18 +72,13 @@ ShowTicketWidget::ShowTicketWidget(QWidget *parent) : QWidget(parent), ui(new Ui
 
     connect(ui->pb_manualRefresh, &QPushButton::clicked, this, &ShowTicketWidget::onPushManualRefreshButton);
 
-    auto* refreshTimer = new QTimer(this);
-    refreshTimer->setInterval(5 * 60 * 1000);  // 5 minutes
-    connect(refreshTimer, &QTimer::timeout, this, &ShowTicketWidget::onPushManualRefreshButton);
-    refreshTimer->start();
-
     _ticketDetailWidget = new ShowTicketDetailWidget(nullptr);
     _ticketDetailWidget->setWindowFlag(Qt::Window, true);
-    connect(_ticketDetailWidget, &ShowTicketDetailWidget::TicketClosed, this, &ShowTicketWidget::onPushManualRefreshButton);
 }
 
 ShowTicketWidget::~ShowTicketWidget()
 {
+    TicketStore::instance()->Detach();
 	delete ui;
 }
 
@@ -82,38 +90,38 @@ void ShowTicketWidget::LoadTableData()
         ui->tv_showTickets->setItemDelegateForColumn(13, new TicketAgeTextDelegate(ui->tv_showTickets));
 		ui->tv_showTickets->setModel(_ticketModel);
 		ui->tv_showTickets->setSortingEnabled(true);
+        SetupTable();
     }
 
-	if (!_ticketMgr)
-        _ticketMgr = std::make_unique<ShowTicketManager>();
+    // Rows come from the shared TicketStore; it owns the refresh loop.
+    auto* store = TicketStore::instance();
+    connect(store, &TicketStore::SnapshotChanged, this, &ShowTicketWidget::OnTicketSnapshotChanged);
 
-    auto task = [this]()
-    {
-        _ticketMgr->LoadTableTicketData();
-        auto localMap = _ticketMgr->GetTableTicketVector();
-      //  _callerTableData = localMap;
+    _ticketModel->setSnapshot(store->GetSnapshot());
+    store->Attach();
+}
 
-        QMetaObject::invokeMethod(
-            this,
-            [this, localMap = std::move(localMap)]()
-            {
-                // Ensure model exists once
-                if (!_ticketModel)
-                {
-                    _ticketModel = new TicketTableModel(this);
-                    ui->tv_showTickets->setItemDelegateForColumn(13, new TicketAgeTextDelegate(ui->tv_showTickets));
-                    ui->tv_showTickets->setModel(_ticketModel);
-                    ui->tv_showTickets->setSortingEnabled(true);
-                }
+void ShowTicketWidget::OnTicketSnapshotChanged(const TicketSnapshotPtr& snapshot, const TicketChangeSetPtr& changes)
+{
+    _ticketModel->applyChanges(snapshot, *changes);
+}
+
+void ShowTicketWidget::PrefetchAroundCurrentRow()
+{
+    const int row = ui->tv_showTickets->currentIndex().row();
+    if (row < 0)
+        return;
 
-                _ticketModel->setRows(localMap);
-                SetupTable();
-                _refresh.store(false);
-            },
-            Qt::QueuedConnection);
-    };
+    std::vector<std::uint64_t> ids;
+    ids.reserve(3);
+
+    for (int r : {row, row - 1, row + 1})
+    {
+        if (auto id = TicketIdForRow(r))
+            ids.push_back(*id);
+    }
 
-    Util::RunInThread(std::move(task), this);
+    ShowTicketManager::PrefetchTicketDetails(ids);
 }
 
 void ShowTicketWidget::SetupTable()
@@ -139,10 +147,11 @@ void ShowTicketWidget::SetupTable()
     header->setSectionResizeMode(11, QHeaderView::Fixed);  // History
     header->setSectionResizeMode(13, QHeaderView::Fixed);  // Open For
 
-    // Content sized columns
-    header->setSectionResizeMode(2, QHeaderView::ResizeToContents);   // Area
-    header->setSectionResizeMode(3, QHeaderView::ResizeToContents);   // Reporter
-    header->setSectionResizeMode(12, QHeaderView::ResizeToContents);  // Cost Unit
+    // Content sized columns: Area, Reporter, Cost Unit. Sized from a sample, since
+    // ResizeToContents would measure every row on each refresh.
+    if (!_columnSizer)
+        _columnSizer = new SampledColumnSizer(tv);
+    _columnSizer->Track({2, 3, 12}, 400);
 
     // Main text columns
     header->setSectionResizeMode(1, QHeaderView::Stretch);      // Title
@@ -160,8 +169,8 @@ void ShowTicketWidget::SetupTable()
 
     tv->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
 
-    // Optional: default sort by ID desc (newest on top)
-    tv->sortByColumn(0, Qt::DescendingOrder);
+    // Optional: default sort by ID desc (newest on top); history by last change, which is indexed
+    tv->sortByColumn(_historyMode ? 8 : 0, Qt::DescendingOrder);
 
     ui->tv_showTickets->hideColumn(2);   // Hide Area column by default
     ui->tv_showTickets->hideColumn(10);  // Hide Comments column by default
@@ -170,10 +179,60 @@ void ShowTicketWidget::SetupTable()
 
 void ShowTicketWidget::onPushManualRefreshButton()
 {
-    // Atomically claim the refresh slot
-    if (_refresh.exchange(true))
-        return;  // refresh already running
+    // The store coalesces requests while a refresh is already running.
+    TicketStore::instance()->RequestRefresh(true);
+}
 
-    LoadTableData();
+QString ShowTicketWidget::CurrentFilterText() const { return ui->le_search->text().trimmed(); }
+
+void ShowTicketWidget::ApplySearchFilter()
+{
+    if (_historyMode)
+        _historyModel->setFilterText(CurrentFilterText());
+    else
+        _ticketModel->setFilterText(CurrentFilterText());
 }
 
+void ShowTicketWidget::SetHistoryMode(bool enabled)
+{
+    _historyMode = enabled;
+    _searchTimer->stop();
+
+    // setModel creates a new selection model and leaves the old one to us
+    QItemSelectionModel* oldSelection = ui->tv_showTickets->selectionModel();
+
+    if (enabled)
+    {
+        if (!_historyModel)
+            _historyModel = new TicketHistoryTableModel(this);
+
+        _historyModel->setFilterText(CurrentFilterText());
+        // Entering the history always starts from fresh pages
+        _historyModel->reload();
+        ui->tv_showTickets->setModel(_historyModel);
+    }
+    else
+    {
+        _ticketModel->setFilterText(CurrentFilterText());
+        ui->tv_showTickets->setModel(_ticketModel);
+    }
+
+    delete oldSelection;
+
+    // Header sections are rebuilt for the new model
+    SetupTable();
+    ConnectSelection();
+}
+
+void ShowTicketWidget::ConnectSelection()
+{
+    connect(ui->tv_showTickets->selectionModel(), &QItemSelectionModel::currentRowChanged, this, [this]() { _prefetchTimer->start(); });
+}
+
+std::optional<std::uint64_t> ShowTicketWidget::TicketIdForRow(int row) const
+{
+    if (_historyMode)
+        return _historyModel->ticketIdForRow(row);
+
+    return _ticketModel->ticketIdForRow(row);
+}
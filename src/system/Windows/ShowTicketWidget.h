@@ -3,7 +3,9 @@
 #include <QWidget>
 #include <QPointer>
 
+#include "SampledColumnSizer.h"
 #include "ShowTicketDetailWidget.h"
+#include "TicketHistoryTableModel.h"
 #include "TicketTableModel.h"
 #include "ui_ShowTicketWidget.h"
 
@@ -22,14 +24,24 @@ public:
 private:
     void LoadTableData();
     void SetupTable();
+    void OnTicketSnapshotChanged(const TicketSnapshotPtr& snapshot, const TicketChangeSetPtr& changes);
+    void PrefetchAroundCurrentRow();
+    void ApplySearchFilter();
+    void SetHistoryMode(bool enabled);
+    void ConnectSelection();
+    QString CurrentFilterText() const;
+    std::optional<std::uint64_t> TicketIdForRow(int row) const;
 
 	Ui::ShowTicketWidgetClass *ui;
 
 	TicketTableModel *_ticketModel;
-	std::unique_ptr<ShowTicketManager> _ticketMgr;
+    // Resolved and closed tickets, paged from the database; created on first use.
+    TicketHistoryTableModel* _historyModel = nullptr;
+    bool _historyMode = false;
     QPointer<ShowTicketDetailWidget> _ticketDetailWidget;
-
-    std::atomic_bool _refresh{false};
+    QTimer* _prefetchTimer = nullptr;
+    QTimer* _searchTimer = nullptr;
+    SampledColumnSizer* _columnSizer = nullptr;
 
 private slots:
     void onPushManualRefreshButton();
@@ -12,6 +12,12 @@
 #include <QTableWidget>
 #include <QVBoxLayout>
 
+#include <climits>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+
 #include "ConnectionGuard.h"
 #include "FileStorageService.h"
 #include "GlobalSignals.h"
@@ -202,38 +208,63 @@ void UploadAttachmentDialog::updateProgress(int currentIndex, int total)
     LOG_DEBUG("UpdateProgress: currIndex: {}, total: {}", currentIndex, total);
 }
 
-bool UploadAttachmentDialog::insertAttachmentToDatabase(const FileStorageService::StoredFileInfo& info, const PendingFile& file)
+std::vector<bool> UploadAttachmentDialog::insertAttachmentsToDatabase(const std::vector<UploadedFile>& batch, const QVector<PendingFile>& files)
 {
-    LOG_DEBUG("Calling insertAttachmentToDatabase for file: {}", file.fileName.toStdString());
+    LOG_DEBUG("Calling insertAttachmentsToDatabase for {} file(s)", batch.size());
+
+    std::vector<bool> inserted(batch.size(), false);
+
+    // One lease and one commit for the whole batch
+    ConnectionGuardAMS connection(ConnectionType::Sync);
+
     try
     {
-        ConnectionGuardAMS connection(ConnectionType::Sync);
         auto stmt = connection->GetPreparedStatement(AMSPreparedStatement::DB_TATT_INSERT_NEW_TICKET_ATTACHMENT);
+        const auto uploaderID = GetUser().GetUserID();
+
+        connection->BeginTransaction();
 
-        const QString mime = MimeTypeHelper::detectMimeType(file.localPath);
-        LOG_DEBUG("Inserting attachment to DB: {}, mime: {} | detect mime with localPath {}", file.fileName.toStdString(), mime.toStdString(), file.localPath.toStdString());
-
-        stmt->SetUInt64(0, _ticketId);
-        stmt->SetUInt(1, GetUser().GetUserID());
-        stmt->SetCurrentDate(2);               // uploaded_at
-        stmt->SetString(3, file.fileName.toStdString());
-        stmt->SetString(4, info.storedFileName.toStdString());
-        stmt->SetString(5, info.relativePath.toStdString());
-        stmt->SetString(6, mime.toStdString());
-        stmt->SetUInt64(7, info.fileSize);
-        stmt->SetString(8, file.description.toStdString());
-        stmt->SetBool(9, false);
-
-        connection->ExecutePreparedInsert(*stmt);
+        for (std::size_t i = 0; i < batch.size(); ++i)
+        {
+            const auto& info = batch[i].info;
+            const auto& file = files[batch[i].row];
+
+            const QString mime = MimeTypeHelper::detectMimeType(file.localPath);
+            LOG_DEBUG("Inserting attachment to DB: {}, mime: {} | detect mime with localPath {}", file.fileName.toStdString(), mime.toStdString(), file.localPath.toStdString());
+
+            stmt->SetUInt64(0, _ticketId);
+            stmt->SetUInt(1, uploaderID);
+            stmt->SetCurrentDate(2);               // uploaded_at
+            stmt->SetString(3, file.fileName.toStdString());
+            stmt->SetString(4, info.storedFileName.toStdString());
+            stmt->SetString(5, info.relativePath.toStdString());
+            stmt->SetString(6, mime.toStdString());
+            stmt->SetUInt64(7, info.fileSize);
+            stmt->SetString(8, file.description.toStdString());
+            stmt->SetBool(9, false);
+
+            inserted[i] = connection->ExecutePreparedInsert(*stmt);
+        }
+
+        connection->Commit();
     }
     catch (const std::exception& e)
     {
-        // You can replace with your logging system
-        LOG_ERROR("insertAttachmentToDatabase failed: {}", e.what());
-        return false;
+        LOG_ERROR("insertAttachmentsToDatabase failed: {}", e.what());
+
+        try
+        {
+            connection->Rollback();
+        }
+        catch (const std::exception& rollbackError)
+        {
+            LOG_ERROR("insertAttachmentsToDatabase rollback failed: {}", rollbackError.what());
+        }
+
+        return std::vector<bool>(batch.size(), false);
     }
 
-    return true;
+    return inserted;
 }
 
 bool UploadAttachmentDialog::isForbiddenExtension(const QString& path) const
@@ -283,15 +314,14 @@ void UploadAttachmentDialog::onStartUpload()
             _files[i].description = itemDesc->text();
     }
 
-    // Quick check in UI thread
+    // Connect the share once, here in the UI thread. All workers share this
+    // instance; once connected they only read from it.
+    auto storage = std::make_shared<FileStorageService>();
+    if (!storage->ensureConnected())
     {
-        FileStorageService storage;
-        if (!storage.ensureConnected())
-        {
-            QMessageBox::warning(this, tr("Network share"),
-                                 tr("Could not connect to the network share. Please check settings."));
-            return;
-        }
+        QMessageBox::warning(this, tr("Network share"),
+                             tr("Could not connect to the network share. Please check settings."));
+        return;
     }
 
     _uploadRunning = true;
@@ -308,62 +338,116 @@ void UploadAttachmentDialog::onStartUpload()
     const quint64 ticketId = _ticketId;
 
     Util::RunInThread(
-        [this, files, total, ticketId]()
+        [this, storage, files, total, ticketId]()
         {
-            FileStorageService storage;
-            storage.ensureConnected();  // should be cheap if already connected
+            qint64 totalBytes = 0;
+            for (const auto& file : files)
+                totalBytes += static_cast<qint64>(file.fileSize);
+
+            std::atomic_int nextRow{0};
+            std::atomic_int finishedFiles{0};
+            std::atomic<qint64> bytesDone{0};
 
-            int currentIndex = 0;
+            // Files on the share waiting for their DB row
+            std::mutex storedMutex;
+            std::condition_variable storedCv;
+            std::vector<UploadedFile> stored;
+            int workersRunning = std::min(MaxParallelUploads, total);
+
+            auto finishFile = [&](int row, const QString& status)
+            {
+                emit uploadRowStatusChanged(row, status);
+                emit uploadProgressChanged(++finishedFiles, total);
+            };
 
             // initial
-            emit uploadProgressChanged(currentIndex, total);
+            emit uploadProgressChanged(0, total);
 
-            for (int row = 0; row < total; ++row)
+            auto worker = [&]()
             {
-                if (_cancelRequested.load())
+                for (int row = nextRow++; row < total; row = nextRow++)
                 {
-                    emit uploadRowStatusChanged(row, tr("Cancelled"));
-                    emit uploadFinished();
-                    emit GlobalSignals::instance()->FileUploadFinished();
-                    return;
+                    if (_cancelRequested.load())
+                    {
+                        finishFile(row, tr("Cancelled"));
+                        continue;
+                    }
+
+                    const auto& file = files[row];
+
+                    emit uploadRowStatusChanged(row, tr("Uploading..."));
+
+                    // Aggregate all workers into one byte count for the progress bar
+                    qint64 reported = 0;
+                    auto progressCallback = [&](qint64 done, qint64 /*fileBytes*/)
+                    {
+                        const qint64 now = bytesDone += done - reported;
+                        reported = done;
+                        emit singleFileProgressChanged(now, totalBytes);
+                    };
+
+                    auto cancelCallback = [this]() -> bool { return _cancelRequested.load(); };
+
+                    auto storedInfo = storage->saveAttachment(ticketId, file.localPath, progressCallback, cancelCallback);
+                    if (!storedInfo.has_value())
+                    {
+                        finishFile(row, _cancelRequested.load() ? tr("Cancelled") : tr("Upload failed"));
+                        continue;
+                    }
+
+                    LOG_DEBUG("File uploaded, stored path: {}", storedInfo->relativePath.toStdString());
+
+                    std::lock_guard<std::mutex> lock(storedMutex);
+                    stored.push_back({row, std::move(*storedInfo)});
+                    if (stored.size() >= DbInsertBatchSize)
+                        storedCv.notify_one();
                 }
 
-                const auto& file = files[row];
+                std::lock_guard<std::mutex> lock(storedMutex);
+                --workersRunning;
+                storedCv.notify_one();
+            };
 
-                emit uploadRowStatusChanged(row, tr("Uploading..."));
+            std::vector<std::thread> workers;
+            for (int i = 0; i < std::min(MaxParallelUploads, total); ++i)
+                workers.emplace_back(worker);
 
-                auto progressCallback = [this](qint64 done, qint64 totalBytes)
-                {
-                    emit singleFileProgressChanged(done, totalBytes);
-                };
-
-                auto cancelCallback = [this]() -> bool { return _cancelRequested.load(); };
-
-                auto storedInfo = storage.saveAttachment(ticketId, file.localPath, progressCallback, cancelCallback);
-                if (!storedInfo.has_value())
+            // Register stored files while the workers keep copying. Files already
+            // on the share are registered even after a cancel; a file whose row
+            // could not be written (e.g. the batch rolled back) is removed again,
+            // so none are orphaned.
+            while (true)
+            {
+                std::vector<UploadedFile> batch;
+                bool workersDone = false;
                 {
-                    emit uploadRowStatusChanged(row, tr("Upload failed"));
-                    ++currentIndex;
-                    emit uploadProgressChanged(currentIndex, total);
-                    continue;
+                    std::unique_lock<std::mutex> lock(storedMutex);
+                    storedCv.wait_for(lock, std::chrono::milliseconds(500),
+                                      [&]() { return stored.size() >= DbInsertBatchSize || workersRunning == 0; });
+                    batch.swap(stored);
+                    workersDone = workersRunning == 0;
                 }
 
-                LOG_DEBUG("File uploaded, stored path: {}", storedInfo->relativePath.toStdString());
-                // DB insert in worker thread (no UI access here)
-                if (!insertAttachmentToDatabase(*storedInfo, file))
+                if (!batch.empty())
                 {
-                    emit uploadRowStatusChanged(row, tr("DB error"));
-                    ++currentIndex;
-                    emit uploadProgressChanged(currentIndex, total);
-                    continue;
+                    const auto inserted = insertAttachmentsToDatabase(batch, files);
+                    for (std::size_t i = 0; i < batch.size(); ++i)
+                    {
+                        if (!inserted[i] && !storage->deleteAttachmentFile(batch[i].info.relativePath))
+                            LOG_ERROR("Upload: could not remove {} from the share after its DB insert failed",
+                                      batch[i].info.relativePath.toStdString());
+
+                        finishFile(batch[i].row, inserted[i] ? tr("Uploaded") : tr("DB error"));
+                    }
                 }
 
-                emit uploadRowStatusChanged(row, tr("Uploaded"));
-
-                ++currentIndex;
-                emit uploadProgressChanged(currentIndex, total);
+                if (workersDone)
+                    break;
             }
 
+            for (auto& thread : workers)
+                thread.join();
+
             emit uploadFinished();
             emit GlobalSignals::instance()->FileUploadFinished();
         });
@@ -371,7 +455,7 @@ void UploadAttachmentDialog::onStartUpload()
 
 void UploadAttachmentDialog::handleUploadProgress(int current, int total)
 {
-    _statusLabel->setText(tr("Uploading file %1 of %2").arg(current + 1).arg(total));
+    _statusLabel->setText(tr("Uploading file %1 of %2").arg(std::min(current + 1, total)).arg(total));
 }
 
 void UploadAttachmentDialog::handleUploadRowStatus(int row, const QString& status)
@@ -407,13 +491,21 @@ void UploadAttachmentDialog::handleSingleFileProgress(qint64 done, qint64 total)
         return;
     }
 
-    _progressBar->setRange(0, static_cast<int>(total));
-
     if (done < 0)
         done = 0;
     if (done > total)
         done = total;
 
+    // The bar is int based; scale down uploads past 2 GB in total
+    if (total > INT_MAX)
+    {
+        const qint64 divisor = total / INT_MAX + 1;
+        total /= divisor;
+        done /= divisor;
+    }
+
+    _progressBar->setRange(0, static_cast<int>(total));
+
     _progressBar->setValue(static_cast<int>(done));
 }
 
@@ -5,6 +5,7 @@
 #include <QVector>
 
 #include <atomic>
+#include <vector>
 
 #include "FileStorageService.h"
 
@@ -32,12 +33,24 @@ private:
         quint8  internalID{0};
     };
 
+    struct UploadedFile
+    {
+        int row{0};
+        FileStorageService::StoredFileInfo info;
+    };
+
+    // Files copied to the share at the same time; reading the next file
+    // overlaps with the share write of the previous one.
+    static constexpr int MaxParallelUploads = 3;
+    // Stored files are registered in the DB in batches of up to this many.
+    static constexpr std::size_t DbInsertBatchSize = 10;
+
     void setupUi();
     void addFileToTable(PendingFile& file);
     void refreshRow(int row, const PendingFile& file);
     void updateProgress(int currentIndex, int total);
 
-    bool insertAttachmentToDatabase(const FileStorageService::StoredFileInfo& info, const PendingFile& file);
+    std::vector<bool> insertAttachmentsToDatabase(const std::vector<UploadedFile>& batch, const QVector<PendingFile>& files);
 
     bool isForbiddenExtension(const QString& path) const;
 
@@ -68,6 +68,7 @@
 
 #include "CrashHandler.h"
 #include "CrashReport.h"
+#include "DatabaseSelfCheck.h"
 #include "Diagnostics.h"
 #include "Settings.h"
 #include "DatabaseConnection.h"
@@ -79,9 +80,12 @@
 #include "SqlValidator.h"
 #include "Databases.h"
 #include "FileKeyProvider.h"
+#include "FileStorageManager.h"
+#include "ShowTicketManager.h"
 #include "MySQLPreparedStatements.h"
 #include "WinStackTrace.h"
 #include "ShutdownManager.h"
+#include "Util.h"
 
 void LoadAndStartSQL();
 
@@ -132,12 +136,50 @@ int main(int argc, char* argv[])
 
         FileKeyProvider::Init();
 
+        if (GetSettings().isLocalFileEnabled())
+        {
+            // A child of the application, so shutdown interrupts and waits for it
+            Util::RunInThread([rootPath = GetSettings().getLocalFileData().rootPath]
+            {
+                LeasePriorityScope background(LeasePriority::Background);
+
+                try
+                {
+                    FileStorageManager storage(rootPath);
+                    storage.CollectGarbage();
+                    storage.PruneAttachmentCache();
+                }
+                catch (const std::exception& ex)
+                {
+                    LOG_ERROR(std::string("Attachment garbage collection failed: ") + ex.what());
+                }
+            }, &mApplication);
+        }
+
+        // Ticket overview summary is maintained by triggers; repair what slipped past them
+        Util::RunInThread([]
+        {
+            LeasePriorityScope background(LeasePriority::Background);
+
+            try
+            {
+                ShowTicketManager::RepairOverviewSummary();
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR(std::string("Ticket overview summary check failed: ") + ex.what());
+            }
+        }, &mApplication);
+
 #ifdef _DEBUG
 		std::thread([]
         {
             try
             {
                 SqlValidator::ValidateAllStatements();
+
+                if (DatabaseSelfCheck::IsEnabled())
+                    DatabaseSelfCheck::RunAll();
             }
             catch (const std::exception& ex)
             {
@@ -199,13 +241,13 @@ void LoadAndStartSQL()
 
     PoolConfig imsConfig;
     imsConfig.primary = GetSettings().getMySQLSettings();
-    imsConfig.syncLimits = {.minSize = 2, .maxSize = 10, .maxQueueDepth = 2048};
-    imsConfig.asyncLimits = {.minSize = 2, .maxSize = 10, .maxQueueDepth = 2048};
+    imsConfig.syncLimits = {.minSize = 2, .maxSize = 10, .maxQueueDepth = 2048, .maxBackground = 7};
+    imsConfig.asyncLimits = {.minSize = 2, .maxSize = 10, .maxQueueDepth = 2048, .maxBackground = 7};
     IMSDatabase::Configure(imsConfig);
 
     PoolConfig amsConfig;
     amsConfig.primary = GetSettings().getAMSMySQLSettings();
-    amsConfig.syncLimits = {.minSize = 2, .maxSize = 10, .maxQueueDepth = 2048};
-    amsConfig.asyncLimits = {.minSize = 2, .maxSize = 10, .maxQueueDepth = 2048};
+    amsConfig.syncLimits = {.minSize = 2, .maxSize = 10, .maxQueueDepth = 2048, .maxBackground = 7};
+    amsConfig.asyncLimits = {.minSize = 2, .maxSize = 10, .maxQueueDepth = 2048, .maxBackground = 7};
     AMSDatabase::Configure(amsConfig);
 };